@@ -0,0 +1,118 @@
+/*
+ * 分配计数器实现
+ * 每块内存前加 16 字节头记录大小 (保持 max_align_t 对齐), 释放时据此扣减当前占用
+ */
+
+#include "bench/alloc_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace cpp_review {
+
+namespace {
+
+constexpr size_t kHeaderSize = 16;
+
+std::atomic<size_t> g_live{0};         // 当前占用
+std::atomic<size_t> g_baseline{0};     // 区间开始时的占用
+std::atomic<size_t> g_peak{0};         // 区间内的最大占用
+std::atomic<size_t> g_allocated{0};    // 区间内分配的字节数
+std::atomic<size_t> g_allocations{0};  // 区间内分配次数
+
+void* allocate(size_t size) {
+    void* block = std::malloc(size + kHeaderSize);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *static_cast<size_t*>(block) = size;
+
+    size_t live = g_live.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = g_peak.load(std::memory_order_relaxed);
+    while (live > peak && !g_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+    g_allocated.fetch_add(size, std::memory_order_relaxed);
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return static_cast<char*>(block) + kHeaderSize;
+}
+
+void release(void* pointer) {
+    if (!pointer) {
+        return;
+    }
+    void* block = static_cast<char*>(pointer) - kHeaderSize;
+    g_live.fetch_sub(*static_cast<size_t*>(block), std::memory_order_relaxed);
+    std::free(block);
+}
+
+} // namespace
+
+void AllocationCounter::reset() {
+    size_t live = g_live.load(std::memory_order_relaxed);
+    g_baseline.store(live, std::memory_order_relaxed);
+    g_peak.store(live, std::memory_order_relaxed);
+    g_allocated.store(0, std::memory_order_relaxed);
+    g_allocations.store(0, std::memory_order_relaxed);
+}
+
+AllocationStats AllocationCounter::snapshot() {
+    AllocationStats stats;
+    stats.allocated_bytes = g_allocated.load(std::memory_order_relaxed);
+    stats.allocations = g_allocations.load(std::memory_order_relaxed);
+    size_t peak = g_peak.load(std::memory_order_relaxed);
+    size_t baseline = g_baseline.load(std::memory_order_relaxed);
+    stats.peak_bytes = peak > baseline ? peak - baseline : 0;
+    return stats;
+}
+
+} // namespace cpp_review
+
+// ===== 全局 operator new/delete 替换 (对齐版本不经过计数, 与其 delete 自成一对) =====
+
+void* operator new(std::size_t size) {
+    return cpp_review::allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return cpp_review::allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return cpp_review::allocate(size);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return cpp_review::allocate(size);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* pointer) noexcept {
+    cpp_review::release(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    cpp_review::release(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    cpp_review::release(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    cpp_review::release(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    cpp_review::release(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    cpp_review::release(pointer);
+}
@@ -0,0 +1,34 @@
+/*
+ * 分配计数器头文件
+ * 基准程序替换全局 operator new/delete, 统计一段代码分配的字节数、次数和峰值占用
+ * 只链接进 cpp-agent-bench, 不影响 cpp-agent 本身
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace cpp_review {
+
+/**
+ * 一段区间内的分配统计
+ */
+struct AllocationStats {
+    size_t allocated_bytes = 0;   // 分配的总字节数
+    size_t allocations = 0;       // 分配次数
+    size_t peak_bytes = 0;        // 相对区间开始时的峰值占用
+};
+
+/**
+ * 分配计数器 (全进程计数, 测量期间应只有一个线程在分配)
+ */
+class AllocationCounter {
+public:
+    // 开始新的测量区间
+    static void reset();
+
+    // 读取区间开始以来的统计
+    static AllocationStats snapshot();
+};
+
+} // namespace cpp_review
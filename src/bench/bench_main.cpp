@@ -0,0 +1,402 @@
+/*
+ * cpp-agent-bench: 规则扩展性基准
+ * 用合成编译单元逐个扫描生成参数 (函数数、循环嵌套深度、new/delete 对数、数组访问数),
+ * 测量每个规则 check() 的耗时和内存分配, 输出 JSON 结果和每个规则的扩展指数
+ *
+ * 扩展指数: 耗时对参数值的对数-对数最小二乘斜率。约为 1 表示线性;
+ * 明显大于 1 说明存在超线性行为, 例如嵌套循环中对内层循环体的重复遍历
+ *
+ * 用法:
+ *   cpp-agent-bench                                  # 扫描全部参数, JSON 写到标准输出
+ *   cpp-agent-bench --sweep=loop-depth --points=6    # 只扫描循环深度 4..128
+ *   cpp-agent-bench --output=bench.json --max-exponent=1.5   # 超线性的规则使退出码为 3
+ *   cpp-agent-bench corpus --runs=5                  # 语料库端到端基准, 追加到历史文件
+ *   cpp-agent-bench compare --threshold=10           # 比较最近两次记录, 有回退时退出码为 3
+ */
+
+#include "bench/alloc_counter.h"
+#include "bench/bench_options.h"
+#include "bench/corpus_bench.h"
+#include "bench/tu_generator.h"
+#include "report/json_utils.h"
+#include "report/reporter.h"
+#include "rules/assignment_in_condition_rule.h"
+#include "rules/buffer_overflow_rule.h"
+#include "rules/integer_overflow_rule.h"
+#include "rules/loop_copy_rule.h"
+#include "rules/memory_leak_rule.h"
+#include "rules/null_pointer_rule.h"
+#include "rules/smart_pointer_rule.h"
+#include "rules/uninitialized_var_rule.h"
+#include "rules/unsafe_c_functions_rule.h"
+#include "rules/use_after_free_rule.h"
+#include <clang/Frontend/ASTUnit.h>
+#include <clang/Tooling/Tooling.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace cpp_review;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * 基准选项
+ */
+struct BenchOptions {
+    std::vector<std::string> sweeps;   // 要扫描的参数 (空表示全部)
+    size_t points = 5;                 // 每个参数的取值个数 (起始值依次翻倍)
+    size_t repeat = 5;                 // 每个规则的重复次数 (耗时取中位数)
+    std::string rule;                  // 只测量该规则 (空表示全部)
+    std::string output_file;           // JSON 输出文件 (空表示标准输出)
+    std::string cpp_standard = "c++17";
+    double max_exponent = 0;           // 大于 0 时, 扩展指数超过该值的规则使退出码为 3
+    bool dump_tu = false;              // 只输出基准形状的合成源码
+    bool help = false;
+    bool valid = true;
+};
+
+/**
+ * 可扫描的生成参数
+ */
+struct Parameter {
+    const char* name;
+    size_t TUShape::*field;
+    size_t start;                      // 扫描起始值
+};
+
+const Parameter kParameters[] = {
+    {"functions", &TUShape::functions, 8},
+    // 从 4 开始: 深度 1..16 时循环节点远少于每个函数的固定内容,
+    // 对循环体的重复遍历 (与深度成平方关系) 被固定开销掩盖, 指数看不出超线性
+    {"loop-depth", &TUShape::loop_depth, 4},
+    {"new-delete", &TUShape::new_delete_pairs, 1},
+    {"array-accesses", &TUShape::array_accesses, 1},
+};
+
+/**
+ * 一个规则在一个取值下的测量结果
+ */
+struct RuleSample {
+    std::string rule_id;
+    double check_us = 0;               // check() 耗时中位数 (微秒)
+    AllocationStats alloc;             // 第一次运行的分配统计
+    size_t issues = 0;                 // 报告的问题数 (未去重)
+};
+
+/**
+ * 一个取值下的测量结果
+ */
+struct Point {
+    size_t value = 0;
+    size_t tu_bytes = 0;
+    double parse_ms = 0;
+    std::vector<RuleSample> rules;
+};
+
+void printHelp() {
+    std::cout << R"(cpp-agent-bench - rule scaling benchmark on synthetic translation units
+
+USAGE:
+    cpp-agent-bench [options]
+    cpp-agent-bench corpus [options]     End-to-end benchmark on the pinned corpus
+    cpp-agent-bench compare [options]    Compare the latest history records
+
+OPTIONS:
+    --sweep=<name>          Parameter to scale (repeatable): functions|loop-depth|
+                            new-delete|array-accesses (default: all)
+    --points=<n>            Values per sweep, doubling from the start value (default: 5)
+    --repeat=<n>            Runs per rule and value; the median time is kept (default: 5)
+    --rule=<id>             Measure only this rule (e.g. LOOP-COPY-001)
+    --std=<standard>        C++ standard for the synthetic sources (default: c++17)
+    --output=<file>         Write JSON results to <file> (default: stdout)
+    --max-exponent=<x>      Exit with code 3 if a rule's scaling exponent exceeds <x>
+    --dump-tu               Print the synthetic source for the base shape and exit
+    -h, --help              Display this help message
+)";
+}
+
+BenchOptions parseArguments(int argc, char* argv[]) {
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string value;
+        try {
+            if (arg == "-h" || arg == "--help") {
+                options.help = true;
+            } else if (arg == "--dump-tu") {
+                options.dump_tu = true;
+            } else if (optionValue(arg, "--sweep", argc, argv, i, value)) {
+                options.sweeps.push_back(value);
+            } else if (optionValue(arg, "--points", argc, argv, i, value)) {
+                options.points = static_cast<size_t>(std::max(1, std::stoi(value)));
+            } else if (optionValue(arg, "--repeat", argc, argv, i, value)) {
+                options.repeat = static_cast<size_t>(std::max(1, std::stoi(value)));
+            } else if (optionValue(arg, "--rule", argc, argv, i, value)) {
+                options.rule = value;
+            } else if (optionValue(arg, "--std", argc, argv, i, value)) {
+                options.cpp_standard = value;
+            } else if (optionValue(arg, "--output", argc, argv, i, value)) {
+                options.output_file = value;
+            } else if (optionValue(arg, "--max-exponent", argc, argv, i, value)) {
+                options.max_exponent = std::stod(value);
+            } else {
+                std::cerr << "Error: Unknown option '" << arg << "'\n";
+                options.valid = false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Error: Invalid value for " << arg << "\n";
+            options.valid = false;
+        }
+    }
+
+    for (const auto& sweep : options.sweeps) {
+        bool known = std::any_of(std::begin(kParameters), std::end(kParameters),
+                                 [&](const Parameter& p) { return sweep == p.name; });
+        if (!known) {
+            std::cerr << "Error: Unknown sweep '" << sweep << "'\n";
+            options.valid = false;
+        }
+    }
+    return options;
+}
+
+std::vector<std::unique_ptr<Rule>> createRules(const std::string& only) {
+    std::vector<std::unique_ptr<Rule>> rules;
+    rules.push_back(std::make_unique<NullPointerRule>());
+    rules.push_back(std::make_unique<UninitializedVarRule>());
+    rules.push_back(std::make_unique<AssignmentInConditionRule>());
+    rules.push_back(std::make_unique<UnsafeCFunctionsRule>());
+    rules.push_back(std::make_unique<MemoryLeakRule>());
+    rules.push_back(std::make_unique<SmartPointerRule>());
+    rules.push_back(std::make_unique<LoopCopyRule>());
+    rules.push_back(std::make_unique<IntegerOverflowRule>());
+    rules.push_back(std::make_unique<UseAfterFreeRule>());
+    rules.push_back(std::make_unique<BufferOverflowRule>());
+
+    if (!only.empty()) {
+        rules.erase(std::remove_if(rules.begin(), rules.end(),
+                                   [&](const auto& rule) { return rule->getRuleId() != only; }),
+                    rules.end());
+    }
+    return rules;
+}
+
+double elapsedMicros(Clock::time_point begin, Clock::time_point end) {
+    return std::chrono::duration<double, std::micro>(end - begin).count();
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+/**
+ * 生成并解析一个合成编译单元, 逐个规则测量 check()
+ * 每次运行使用新的报告器, 所以分配统计包含规则保存的问题
+ */
+bool measurePoint(const TUShape& shape, const std::vector<std::unique_ptr<Rule>>& rules,
+                  const BenchOptions& options, Point& point) {
+    std::string code = TUGenerator::generate(shape);
+    point.tu_bytes = code.size();
+
+    auto parse_begin = Clock::now();
+    std::unique_ptr<clang::ASTUnit> ast = clang::tooling::buildASTFromCodeWithArgs(
+        code, {"-std=" + options.cpp_standard, "-w"}, "bench_tu.cpp");
+    point.parse_ms = elapsedMicros(parse_begin, Clock::now()) / 1000.0;
+    if (!ast) {
+        std::cerr << "Error: Failed to parse the synthetic translation unit\n";
+        return false;
+    }
+    clang::ASTContext& context = ast->getASTContext();
+
+    for (const auto& rule : rules) {
+        RuleSample sample;
+        sample.rule_id = rule->getRuleId();
+        std::vector<double> times;
+        for (size_t run = 0; run < options.repeat; ++run) {
+            Reporter reporter;
+            AllocationCounter::reset();
+            auto begin = Clock::now();
+            rule->check(&context, reporter);
+            auto end = Clock::now();
+            AllocationStats stats = AllocationCounter::snapshot();
+
+            times.push_back(elapsedMicros(begin, end));
+            if (run == 0) {
+                sample.alloc = stats;
+                sample.issues = reporter.getIssues().size();
+            }
+        }
+        sample.check_us = median(times);
+        point.rules.push_back(std::move(sample));
+    }
+    return true;
+}
+
+/**
+ * 扩展指数: ln(耗时) 对 ln(取值) 的最小二乘斜率
+ */
+double scalingExponent(const std::vector<Point>& points, size_t rule_index) {
+    std::vector<std::pair<double, double>> samples;
+    for (const auto& point : points) {
+        double time = point.rules[rule_index].check_us;
+        if (point.value > 0 && time > 0) {
+            samples.emplace_back(std::log(static_cast<double>(point.value)), std::log(time));
+        }
+    }
+    if (samples.size() < 2) {
+        return 0;
+    }
+
+    double mean_x = 0, mean_y = 0;
+    for (const auto& s : samples) {
+        mean_x += s.first;
+        mean_y += s.second;
+    }
+    mean_x /= samples.size();
+    mean_y /= samples.size();
+
+    double covariance = 0, variance = 0;
+    for (const auto& s : samples) {
+        covariance += (s.first - mean_x) * (s.second - mean_y);
+        variance += (s.first - mean_x) * (s.first - mean_x);
+    }
+    return variance > 0 ? covariance / variance : 0;
+}
+
+void writeShape(std::ostream& out, const TUShape& shape) {
+    out << "{\"functions\": " << shape.functions
+        << ", \"loop_depth\": " << shape.loop_depth
+        << ", \"new_delete_pairs\": " << shape.new_delete_pairs
+        << ", \"array_accesses\": " << shape.array_accesses << "}";
+}
+
+void writePoint(std::ostream& out, const Point& point) {
+    out << "        {\"value\": " << point.value << ", \"tu_bytes\": " << point.tu_bytes
+        << ", \"parse_ms\": " << point.parse_ms << ", \"rules\": [\n";
+    for (size_t i = 0; i < point.rules.size(); ++i) {
+        const RuleSample& sample = point.rules[i];
+        out << "          {\"rule_id\": ";
+        JSONUtils::writeString(out, sample.rule_id);
+        out << ", \"check_us\": " << sample.check_us
+            << ", \"allocated_bytes\": " << sample.alloc.allocated_bytes
+            << ", \"allocations\": " << sample.alloc.allocations
+            << ", \"peak_bytes\": " << sample.alloc.peak_bytes
+            << ", \"issues\": " << sample.issues << "}"
+            << (i + 1 < point.rules.size() ? "," : "") << "\n";
+    }
+    out << "        ]}";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "corpus") {
+        return CorpusBench::run(argc - 1, argv + 1);
+    }
+    if (argc > 1 && std::string(argv[1]) == "compare") {
+        return CorpusBench::compare(argc - 1, argv + 1);
+    }
+
+    BenchOptions options = parseArguments(argc, argv);
+    if (options.help) {
+        printHelp();
+        return 0;
+    }
+    if (!options.valid) {
+        std::cerr << "Use 'cpp-agent-bench --help' for usage information\n";
+        return 1;
+    }
+
+    const TUShape base;
+    if (options.dump_tu) {
+        std::cout << TUGenerator::generate(base);
+        return 0;
+    }
+
+    auto rules = createRules(options.rule);
+    if (rules.empty()) {
+        std::cerr << "Error: Unknown rule '" << options.rule << "'\n";
+        return 1;
+    }
+
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3);
+    json << "{\n  \"tool\": \"cpp-agent-bench\",\n  \"cpp_standard\": ";
+    JSONUtils::writeString(json, options.cpp_standard);
+    json << ",\n  \"repeat\": " << options.repeat << ",\n  \"base_shape\": ";
+    writeShape(json, base);
+    json << ",\n  \"sweeps\": [\n";
+
+    bool first_sweep = true;
+    bool exceeded = false;
+    for (const auto& parameter : kParameters) {
+        if (!options.sweeps.empty() &&
+            std::find(options.sweeps.begin(), options.sweeps.end(), parameter.name) == options.sweeps.end()) {
+            continue;
+        }
+
+        // 其他参数保持基准值, 只让当前参数从起始值开始翻倍
+        std::vector<Point> points;
+        for (size_t k = 0; k < options.points; ++k) {
+            TUShape shape = base;
+            shape.*parameter.field = parameter.start << k;
+            Point point;
+            point.value = shape.*parameter.field;
+            std::cerr << "  " << parameter.name << " = " << point.value << "...\n";
+            if (!measurePoint(shape, rules, options, point)) {
+                return 1;
+            }
+            points.push_back(std::move(point));
+        }
+
+        json << (first_sweep ? "" : ",\n") << "    {\"parameter\": \"" << parameter.name
+             << "\", \"points\": [\n";
+        first_sweep = false;
+        for (size_t k = 0; k < points.size(); ++k) {
+            writePoint(json, points[k]);
+            json << (k + 1 < points.size() ? ",\n" : "\n");
+        }
+        json << "      ], \"scaling\": [\n";
+
+        std::cerr << "\nScaling with " << parameter.name << " (exponent of check() time):\n";
+        for (size_t r = 0; r < rules.size(); ++r) {
+            double exponent = scalingExponent(points, r);
+            bool over = options.max_exponent > 0 && exponent > options.max_exponent;
+            exceeded = exceeded || over;
+            json << "        {\"rule_id\": ";
+            JSONUtils::writeString(json, rules[r]->getRuleId());
+            json << ", \"exponent\": " << exponent << ", \"exceeds_limit\": " << (over ? "true" : "false")
+                 << "}" << (r + 1 < rules.size() ? "," : "") << "\n";
+            std::cerr << "  " << std::left << std::setw(22) << rules[r]->getRuleId() << std::right
+                      << std::fixed << std::setprecision(2) << std::setw(6) << exponent
+                      << (over ? "  <-- exceeds --max-exponent" : "") << "\n";
+        }
+        json << "      ]}";
+    }
+    json << "\n  ]\n}\n";
+
+    if (options.output_file.empty()) {
+        std::cout << json.str();
+    } else {
+        std::ofstream file(options.output_file);
+        if (!file.is_open()) {
+            std::cerr << "Error: Cannot write " << options.output_file << "\n";
+            return 1;
+        }
+        file << json.str();
+        std::cerr << "Results written to " << options.output_file << "\n";
+    }
+
+    return exceeded ? 3 : 0;
+}
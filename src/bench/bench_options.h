@@ -0,0 +1,29 @@
+/*
+ * 基准程序的命令行选项辅助函数
+ */
+
+#pragma once
+
+#include <string>
+
+namespace cpp_review {
+
+/**
+ * 解析 "--name=value" 或 "--name value" 形式的选项
+ * @param i 当前参数序号, 使用下一个参数作为值时前移
+ * @return arg 是该选项时返回 true, value 为选项值
+ */
+inline bool optionValue(const std::string& arg, const std::string& name, int argc, char* argv[], int& i,
+                        std::string& value) {
+    if (arg == name && i + 1 < argc) {
+        value = argv[++i];
+        return true;
+    }
+    if (arg.compare(0, name.size() + 1, name + "=") == 0) {
+        value = arg.substr(name.size() + 1);
+        return true;
+    }
+    return false;
+}
+
+} // namespace cpp_review
@@ -0,0 +1,529 @@
+/*
+ * 语料库基准实现
+ */
+
+#include "bench/corpus_bench.h"
+#include "bench/bench_options.h"
+#include "bench/tu_generator.h"
+#include "git/git_process.h"
+#include "report/json_utils.h"
+#include "report/run_stats.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <ctime>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+namespace cpp_review {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// 小于该值的峰值内存变化不算回退 (KB)
+constexpr double kMinRSSDeltaKB = 1024;
+
+/**
+ * 清单中的一个语料
+ */
+struct CorpusEntry {
+    std::string name;
+    std::string path;                  // 绝对路径 (生成的语料在运行时填入)
+    size_t generated = 0;              // > 0 表示由合成生成器生成的文件数
+    std::vector<std::string> args;     // 传给 cpp-agent 的额外参数
+};
+
+/**
+ * 一次运行或一条历史记录的指标
+ */
+struct Metrics {
+    std::string label;
+    std::string corpus;
+    double wall_ms = 0;
+    double peak_rss_kb = 0;
+    double files = 0;
+    double issues = 0;
+    double phase_ms[RunStats::kPhaseCount] = {};
+};
+
+bool loadManifest(const std::string& manifest, std::vector<CorpusEntry>& entries) {
+    std::ifstream in(manifest);
+    if (!in.is_open()) {
+        std::cerr << "Error: Cannot read corpus manifest " << manifest << "\n";
+        return false;
+    }
+    fs::path base = fs::absolute(manifest).parent_path();
+
+    std::string line;
+    size_t line_number = 0;
+    while (std::getline(in, line)) {
+        ++line_number;
+        std::istringstream fields(line);
+        CorpusEntry entry;
+        std::string location;
+        if (!(fields >> entry.name) || entry.name[0] == '#') {
+            continue;
+        }
+        if (!(fields >> location)) {
+            std::cerr << "Warning: " << manifest << ":" << line_number << ": missing corpus path, skipped\n";
+            continue;
+        }
+        for (std::string arg; fields >> arg;) {
+            entry.args.push_back(arg);
+        }
+
+        const std::string generated = "generated:";
+        if (location.compare(0, generated.size(), generated) == 0) {
+            try {
+                entry.generated = static_cast<size_t>(std::stoul(location.substr(generated.size())));
+            } catch (const std::exception&) {
+            }
+            if (entry.generated == 0) {
+                std::cerr << "Warning: " << manifest << ":" << line_number
+                          << ": invalid generated corpus size, skipped\n";
+                continue;
+            }
+        } else {
+            entry.path = fs::weakly_canonical(base / location).string();
+            if (!fs::exists(entry.path)) {
+                std::cerr << "Warning: " << manifest << ":" << line_number << ": " << entry.path
+                          << " does not exist, skipped\n";
+                continue;
+            }
+        }
+        entries.push_back(std::move(entry));
+    }
+    return true;
+}
+
+/**
+ * 生成合成语料: 每个文件的函数数不同, 内容只取决于文件序号
+ */
+bool generateCorpus(const fs::path& directory, size_t count) {
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    for (size_t i = 0; i < count; ++i) {
+        TUShape shape;
+        shape.functions = 8 + (i % 8) * 4;
+        std::ostringstream name;
+        name << "synthetic_" << std::setw(4) << std::setfill('0') << i << ".cpp";
+        std::ofstream out(directory / name.str());
+        out << TUGenerator::generate(shape);
+        if (!out) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * cpp-agent 默认与基准程序在同一目录, 否则从 PATH 查找
+ */
+std::string defaultAgent() {
+    std::error_code ec;
+    fs::path self = fs::read_symlink("/proc/self/exe", ec);
+    if (!ec) {
+        fs::path sibling = self.parent_path() / "cpp-agent";
+        if (fs::exists(sibling, ec)) {
+            return sibling.string();
+        }
+    }
+    return "cpp-agent";
+}
+
+/**
+ * 在 workdir 中运行 cpp-agent (不读取调用者目录下的 .cpp-agent.yml), 丢弃其输出
+ * @return 退出码; 无法启动或被信号终止时返回 -1
+ */
+int runAgent(const std::string& agent, const std::vector<std::string>& args, const std::string& workdir) {
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(agent.c_str()));
+    for (const auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        return -1;
+    }
+    if (pid == 0) {
+        int null_fd = open("/dev/null", O_WRONLY);
+        if (null_fd >= 0) {
+            dup2(null_fd, STDOUT_FILENO);
+            dup2(null_fd, STDERR_FILENO);
+            close(null_fd);
+        }
+        if (chdir(workdir.c_str()) != 0) {
+            _exit(127);
+        }
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) return -1;
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+bool readStats(const std::string& path, Metrics& metrics) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    std::string text = buffer.str();
+
+    bool ok = JSONUtils::findNumber(text, "wall_ms", metrics.wall_ms) &&
+              JSONUtils::findNumber(text, "peak_rss_kb", metrics.peak_rss_kb) &&
+              JSONUtils::findNumber(text, "files", metrics.files) &&
+              JSONUtils::findNumber(text, "issues", metrics.issues);
+    for (size_t i = 0; i < RunStats::kPhaseCount; ++i) {
+        JSONUtils::findNumber(text, std::string(RunStats::kPhases[i]) + "_ms", metrics.phase_ms[i]);
+    }
+    return ok;
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+/**
+ * 当前代码版本的标签: 提交短 SHA, 工作区有未提交的修改时加 "-dirty"
+ */
+std::string currentLabel() {
+    int status = -1;
+    std::string sha = GitProcess::run({"rev-parse", "--short=12", "HEAD"}, &status);
+    sha.erase(sha.find_last_not_of(" \n\r\t") + 1);
+    if (status != 0 || sha.empty()) {
+        return "unknown";
+    }
+    std::string changes = GitProcess::run({"status", "--porcelain", "--untracked-files=no"}, &status);
+    return changes.empty() ? sha : sha + "-dirty";
+}
+
+std::string utcTimestamp() {
+    std::time_t now = std::time(nullptr);
+    std::tm utc{};
+    gmtime_r(&now, &utc);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    return buffer;
+}
+
+void writeRecord(std::ostream& out, const Metrics& metrics, size_t runs, const std::string& timestamp) {
+    out << std::fixed << std::setprecision(3);
+    out << "{\"label\": ";
+    JSONUtils::writeString(out, metrics.label);
+    out << ", \"timestamp\": \"" << timestamp << "\", \"corpus\": ";
+    JSONUtils::writeString(out, metrics.corpus);
+    out << ", \"runs\": " << runs
+        << ", \"wall_ms\": " << metrics.wall_ms
+        << ", \"peak_rss_kb\": " << static_cast<long>(metrics.peak_rss_kb)
+        << ", \"files\": " << static_cast<long>(metrics.files)
+        << ", \"issues\": " << static_cast<long>(metrics.issues);
+    for (size_t i = 0; i < RunStats::kPhaseCount; ++i) {
+        out << ", \"" << RunStats::kPhases[i] << "_ms\": " << metrics.phase_ms[i];
+    }
+    out << "}\n";
+}
+
+void printRunHelp() {
+    std::cout << R"(cpp-agent-bench corpus - end-to-end benchmark on a pinned local corpus
+
+USAGE:
+    cpp-agent-bench corpus [options]
+
+OPTIONS:
+    --manifest=<file>       Corpus manifest (default: bench/corpus/manifest.txt)
+    --history=<file>        History file to append to (default: bench/history.jsonl)
+    --agent=<path>          cpp-agent binary (default: next to cpp-agent-bench)
+    --runs=<n>              Runs per corpus; times are medians (default: 3)
+    --label=<name>          Label for this record (default: git short SHA)
+    -h, --help              Display this help message
+)";
+}
+
+void printCompareHelp() {
+    std::cout << R"(cpp-agent-bench compare - flag regressions between history records
+
+USAGE:
+    cpp-agent-bench compare [options]
+
+OPTIONS:
+    --history=<file>        History file (default: bench/history.jsonl)
+    --base=<label>          Compare against the latest record with this label
+                            (default: the previous record of each corpus)
+    --threshold=<percent>   Regression threshold (default: 10)
+    --min-delta-ms=<ms>     Ignore time changes smaller than this (default: 20)
+    -h, --help              Display this help message
+
+Exit code is 3 when wall time, peak RSS or a phase regressed beyond the threshold.
+)";
+}
+
+} // namespace
+
+int CorpusBench::run(int argc, char* argv[]) {
+    std::string manifest = "bench/corpus/manifest.txt";
+    std::string history = "bench/history.jsonl";
+    std::string agent = defaultAgent();
+    std::string label;
+    size_t runs = 3;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string value;
+        if (arg == "-h" || arg == "--help") {
+            printRunHelp();
+            return 0;
+        } else if (optionValue(arg, "--manifest", argc, argv, i, value)) {
+            manifest = value;
+        } else if (optionValue(arg, "--history", argc, argv, i, value)) {
+            history = value;
+        } else if (optionValue(arg, "--agent", argc, argv, i, value)) {
+            agent = value;
+        } else if (optionValue(arg, "--label", argc, argv, i, value)) {
+            label = value;
+        } else if (optionValue(arg, "--runs", argc, argv, i, value)) {
+            runs = static_cast<size_t>(std::max(1L, std::strtol(value.c_str(), nullptr, 10)));
+        } else {
+            std::cerr << "Error: Unknown option '" << arg << "'\n";
+            return 1;
+        }
+    }
+    // 子进程在语料目录中启动, 含 "/" 的相对路径 (如 ./build/cpp-agent) 需先转为绝对路径;
+    // 不含 "/" 的名称仍由 execvp 从 PATH 查找
+    if (agent.find('/') != std::string::npos) {
+        std::error_code ec;
+        fs::path absolute = fs::absolute(agent, ec);
+        if (!ec) {
+            agent = absolute.lexically_normal().string();
+        }
+    }
+
+    std::vector<CorpusEntry> entries;
+    if (!loadManifest(manifest, entries)) {
+        return 1;
+    }
+    if (entries.empty()) {
+        std::cerr << "Error: No corpus entries in " << manifest << "\n";
+        return 1;
+    }
+    if (label.empty()) {
+        label = currentLabel();
+    }
+
+    // 工作目录: 存放生成的语料和统计文件, 也作为 cpp-agent 的当前目录
+    std::string pattern = (fs::temp_directory_path() / "cpp-agent-bench-XXXXXX").string();
+    if (!mkdtemp(pattern.data())) {
+        std::cerr << "Error: Cannot create a temporary directory\n";
+        return 1;
+    }
+    const fs::path workdir = pattern;
+    const std::string stats_file = (workdir / "stats.json").string();
+    const std::string timestamp = utcTimestamp();
+
+    std::ostringstream records;
+    int exit_code = 0;
+    std::cout << "Corpus benchmark (" << label << ", " << runs << " run(s) each)\n";
+    for (auto& entry : entries) {
+        if (entry.generated > 0) {
+            fs::path directory = workdir / ("corpus-" + entry.name);
+            if (!generateCorpus(directory, entry.generated)) {
+                std::cerr << "Error: Cannot generate corpus '" << entry.name << "'\n";
+                exit_code = 1;
+                continue;
+            }
+            entry.path = directory.string();
+        }
+
+        std::vector<std::string> args = {"scan", entry.path, "--stats=" + stats_file};
+        args.insert(args.end(), entry.args.begin(), entry.args.end());
+
+        std::vector<Metrics> samples;
+        for (size_t run = 0; run < runs; ++run) {
+            std::error_code ec;
+            fs::remove(stats_file, ec);
+            int status = runAgent(agent, args, workdir.string());
+            Metrics sample;
+            // 退出码 2 表示发现了严重问题, 不是运行失败
+            if ((status != 0 && status != 2) || !readStats(stats_file, sample)) {
+                std::cerr << "Error: " << agent << " failed on corpus '" << entry.name
+                          << "' (exit code " << status << ")\n";
+                break;
+            }
+            samples.push_back(sample);
+        }
+        if (samples.size() != runs) {
+            exit_code = 1;
+            continue;
+        }
+
+        // 时间取中位数, 峰值内存取最大值; 问题数在各次运行之间应当一致
+        Metrics result;
+        result.label = label;
+        result.corpus = entry.name;
+        std::vector<double> wall;
+        for (const auto& sample : samples) {
+            wall.push_back(sample.wall_ms);
+            result.peak_rss_kb = std::max(result.peak_rss_kb, sample.peak_rss_kb);
+            if (sample.issues != samples.front().issues) {
+                std::cerr << "Warning: Issue count on corpus '" << entry.name
+                          << "' differs between runs (non-deterministic results)\n";
+            }
+        }
+        result.wall_ms = median(wall);
+        result.files = samples.front().files;
+        result.issues = samples.front().issues;
+        for (size_t p = 0; p < RunStats::kPhaseCount; ++p) {
+            std::vector<double> phase;
+            for (const auto& sample : samples) {
+                phase.push_back(sample.phase_ms[p]);
+            }
+            result.phase_ms[p] = median(phase);
+        }
+
+        std::cout << "  " << std::left << std::setw(16) << entry.name << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(10) << result.wall_ms << " ms"
+                  << std::setw(10) << static_cast<long>(result.peak_rss_kb / 1024) << " MB"
+                  << std::setw(8) << static_cast<long>(result.files) << " files"
+                  << std::setw(8) << static_cast<long>(result.issues) << " issues\n";
+        writeRecord(records, result, runs, timestamp);
+    }
+
+    std::error_code ec;
+    fs::remove_all(workdir, ec);
+
+    if (!records.str().empty()) {
+        std::ofstream out(history, std::ios::app);
+        if (!out.is_open()) {
+            std::cerr << "Error: Cannot write history file " << history << "\n";
+            return 1;
+        }
+        out << records.str();
+        std::cout << "Appended to " << history << "\n";
+    }
+    return exit_code;
+}
+
+int CorpusBench::compare(int argc, char* argv[]) {
+    std::string history = "bench/history.jsonl";
+    std::string base_label;
+    double threshold = 10;
+    double min_delta_ms = 20;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string value;
+        if (arg == "-h" || arg == "--help") {
+            printCompareHelp();
+            return 0;
+        } else if (optionValue(arg, "--history", argc, argv, i, value)) {
+            history = value;
+        } else if (optionValue(arg, "--base", argc, argv, i, value)) {
+            base_label = value;
+        } else if (optionValue(arg, "--threshold", argc, argv, i, value)) {
+            threshold = std::strtod(value.c_str(), nullptr);
+        } else if (optionValue(arg, "--min-delta-ms", argc, argv, i, value)) {
+            min_delta_ms = std::strtod(value.c_str(), nullptr);
+        } else {
+            std::cerr << "Error: Unknown option '" << arg << "'\n";
+            return 1;
+        }
+    }
+
+    std::ifstream in(history);
+    if (!in.is_open()) {
+        std::cerr << "Error: Cannot read history file " << history << "\n";
+        return 1;
+    }
+
+    // 按语料分组, 保持文件中的顺序 (越靠后越新)
+    std::vector<std::string> corpora;
+    std::map<std::string, std::vector<Metrics>> records;
+    std::string line;
+    while (std::getline(in, line)) {
+        Metrics metrics;
+        if (!JSONUtils::findString(line, "corpus", metrics.corpus) ||
+            !JSONUtils::findNumber(line, "wall_ms", metrics.wall_ms)) {
+            continue;
+        }
+        JSONUtils::findString(line, "label", metrics.label);
+        JSONUtils::findNumber(line, "peak_rss_kb", metrics.peak_rss_kb);
+        JSONUtils::findNumber(line, "files", metrics.files);
+        JSONUtils::findNumber(line, "issues", metrics.issues);
+        for (size_t p = 0; p < RunStats::kPhaseCount; ++p) {
+            JSONUtils::findNumber(line, std::string(RunStats::kPhases[p]) + "_ms", metrics.phase_ms[p]);
+        }
+        if (!records.count(metrics.corpus)) {
+            corpora.push_back(metrics.corpus);
+        }
+        records[metrics.corpus].push_back(std::move(metrics));
+    }
+
+    bool regressed = false;
+    bool compared = false;
+    for (const auto& corpus : corpora) {
+        const auto& list = records[corpus];
+        const Metrics& current = list.back();
+        const Metrics* base = nullptr;
+        for (size_t i = list.size() - 1; i-- > 0;) {
+            if (base_label.empty() || list[i].label == base_label) {
+                base = &list[i];
+                break;
+            }
+        }
+        if (!base) {
+            continue;
+        }
+        compared = true;
+
+        std::cout << corpus << ": " << base->label << " -> " << current.label << "\n";
+        auto check = [&](const std::string& name, double before, double after, double min_delta,
+                         const char* unit) {
+            double delta = after - before;
+            double percent = before > 0 ? delta / before * 100 : 0;
+            bool regression = percent > threshold && delta >= min_delta;
+            bool improvement = -percent > threshold && -delta >= min_delta;
+            std::cout << "  " << std::left << std::setw(14) << name << std::right << std::fixed
+                      << std::setprecision(1) << std::setw(12) << before << " -> " << std::setw(10)
+                      << after << " " << unit << std::showpos << std::setw(9) << percent << "%"
+                      << std::noshowpos
+                      << (regression ? "  REGRESSION" : improvement ? "  improved" : "") << "\n";
+            regressed = regressed || regression;
+        };
+        check("wall", base->wall_ms, current.wall_ms, min_delta_ms, "ms");
+        for (size_t p = 0; p < RunStats::kPhaseCount; ++p) {
+            check(RunStats::kPhases[p], base->phase_ms[p], current.phase_ms[p], min_delta_ms, "ms");
+        }
+        check("peak RSS", base->peak_rss_kb, current.peak_rss_kb, kMinRSSDeltaKB, "KB");
+        if (base->issues != current.issues) {
+            std::cout << "  issues changed: " << static_cast<long>(base->issues) << " -> "
+                      << static_cast<long>(current.issues) << "\n";
+        }
+    }
+
+    if (!compared) {
+        std::cout << "Nothing to compare: each corpus needs at least two records in " << history << "\n";
+        return 0;
+    }
+    return regressed ? 3 : 0;
+}
+
+} // namespace cpp_review
@@ -0,0 +1,38 @@
+/*
+ * 语料库基准头文件
+ * 在固定的本地语料库上端到端运行 cpp-agent, 把耗时、峰值内存、问题数和各阶段耗时
+ * 追加到历史文件, 并比较最近两次记录, 超过阈值的变化视为性能回退
+ *
+ * 清单文件 (默认 bench/corpus/manifest.txt), 每行一个语料:
+ *   <名称> <路径> [传给 cpp-agent 的额外参数...]
+ * 路径相对清单所在目录; "generated:<N>" 表示用合成编译单元生成器生成 N 个文件
+ * (内容只取决于生成器, 可重复)。# 开头的行是注释
+ *
+ * 历史文件 (默认 bench/history.jsonl) 每行一个 JSON 对象, 一次运行的每个语料一行:
+ *   {"label": ..., "timestamp": ..., "corpus": ..., "runs": ..., "wall_ms": ...,
+ *    "peak_rss_kb": ..., "files": ..., "issues": ..., "setup_ms": ..., "analyze_ms": ..., ...}
+ */
+
+#pragma once
+
+namespace cpp_review {
+
+/**
+ * 语料库基准
+ */
+class CorpusBench {
+public:
+    /**
+     * cpp-agent-bench corpus [选项]: 运行语料库并追加历史记录
+     * @return 进程退出码
+     */
+    static int run(int argc, char* argv[]);
+
+    /**
+     * cpp-agent-bench compare [选项]: 比较每个语料最近两次 (或与指定标签) 的记录
+     * @return 进程退出码: 有回退时为 3
+     */
+    static int compare(int argc, char* argv[]);
+};
+
+} // namespace cpp_review
@@ -0,0 +1,102 @@
+/*
+ * 合成编译单元生成器实现
+ */
+
+#include "bench/tu_generator.h"
+#include <sstream>
+
+namespace cpp_review {
+
+namespace {
+
+// 前言: 替代标准库头文件的最小声明, 保证生成的源码在任何环境下都能独立解析
+constexpr const char* kPreamble = R"CPP(// Synthetic translation unit generated by cpp-agent-bench
+extern "C" char* strcpy(char* dest, const char* src);
+
+struct Record {
+    int id;
+    int size;
+    int flags;
+    double weight;
+};
+
+template <typename T>
+struct Range {
+    T* first;
+    T* last;
+    T* begin() const { return first; }
+    T* end() const { return last; }
+};
+
+)CPP";
+
+std::string indent(size_t level) {
+    return std::string(level * 4, ' ');
+}
+
+/**
+ * 生成 depth 层嵌套循环
+ * 偶数层为计数循环, 奇数层为按值拷贝元素的范围 for; 最内层拷贝一个 Record
+ */
+void writeLoops(std::ostringstream& out, size_t depth) {
+    for (size_t level = 0; level < depth; ++level) {
+        std::string pad = indent(level + 1);
+        if (level % 2 == 0) {
+            out << pad << "for (int i" << level << " = 0; i" << level << " < n; ++i" << level << ") {\n";
+        } else {
+            out << pad << "for (Record r" << level << " : records) {\n";
+        }
+        out << indent(level + 2) << "total += " << (level % 2 == 0 ? "i" : "r") << level
+            << (level % 2 == 0 ? "" : ".id") << ";\n";
+    }
+    if (depth > 0) {
+        out << indent(depth + 1) << "Record item = records.first[total & 7];\n";
+        out << indent(depth + 1) << "total += item.size;\n";
+    }
+    for (size_t level = depth; level > 0; --level) {
+        out << indent(level) << "}\n";
+    }
+}
+
+void writeFunction(std::ostringstream& out, size_t index, const TUShape& shape) {
+    out << "int bench_function_" << index << "(Range<Record> records, int* data, int n) {\n";
+    out << "    int total = 0;\n";
+    out << "    int buffer[64];\n";
+    out << "    char name[16];\n";
+    out << "    strcpy(name, \"bench\");\n";
+
+    for (size_t i = 0; i < shape.new_delete_pairs; ++i) {
+        out << "    Record* owned" << i << " = new Record();\n";
+        out << "    owned" << i << "->id = " << i << ";\n";
+        out << "    total += owned" << i << "->size;\n";
+        out << "    delete owned" << i << ";\n";
+    }
+
+    for (size_t i = 0; i < shape.array_accesses; ++i) {
+        out << "    buffer[" << (i % 64) << "] = data[" << i << "] + total;\n";
+    }
+
+    out << "    int* cursor = nullptr;\n";
+    out << "    if (n > " << index % 7 << ") {\n";
+    out << "        cursor = data;\n";
+    out << "    }\n";
+    out << "    total += *cursor + buffer[0] + name[0];\n";
+
+    writeLoops(out, shape.loop_depth);
+
+    out << "    return total;\n";
+    out << "}\n\n";
+}
+
+} // namespace
+
+std::string TUGenerator::generate(const TUShape& shape) {
+    std::ostringstream out;
+    out << kPreamble;
+    for (size_t i = 0; i < shape.functions; ++i) {
+        writeFunction(out, i, shape);
+    }
+    return out.str();
+}
+
+} // namespace cpp_review
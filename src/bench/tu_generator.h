@@ -0,0 +1,42 @@
+/*
+ * 合成编译单元生成器头文件
+ * 为基准测试生成规模可控的 C++ 源码, 不依赖任何系统头文件 (所需声明都写在前言中)
+ *
+ * 每个生成的函数包含:
+ * - loop_depth 层嵌套循环 (计数循环与按值拷贝元素的范围 for 交替), 最内层拷贝一个大对象
+ * - new_delete_pairs 对 new/delete
+ * - array_accesses 次定长数组访问
+ * - 一次 strcpy 和一次可能为空的指针解引用
+ * 这些结构分别覆盖循环拷贝、内存管理、缓冲区、不安全函数和空指针等规则
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace cpp_review {
+
+/**
+ * 生成参数
+ */
+struct TUShape {
+    size_t functions = 16;          // 函数个数
+    size_t loop_depth = 2;          // 每个函数的循环嵌套深度
+    size_t new_delete_pairs = 4;    // 每个函数的 new/delete 对数
+    size_t array_accesses = 8;      // 每个函数的数组访问次数
+};
+
+/**
+ * 合成编译单元生成器
+ */
+class TUGenerator {
+public:
+    /**
+     * 生成源码
+     * 相同参数总是生成相同的文本, 结果可重复
+     */
+    static std::string generate(const TUShape& shape);
+};
+
+} // namespace cpp_review
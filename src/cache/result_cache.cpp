@@ -0,0 +1,276 @@
+/*
+ * 分析结果缓存实现
+ */
+
+#include "cache/result_cache.h"
+#include "report/fingerprint.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+namespace cpp_review {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr const char* kFileHeader = "# cpp-agent results v1";
+
+// 字段中的制表符/换行/反斜杠需要转义, 保证一条记录占一行
+std::string escapeField(const std::string& text) {
+    std::string result;
+    result.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+            case '\\': result += "\\\\"; break;
+            case '\t': result += "\\t"; break;
+            case '\n': result += "\\n"; break;
+            case '\r': result += "\\r"; break;
+            default: result += c; break;
+        }
+    }
+    return result;
+}
+
+std::string unescapeField(const std::string& text) {
+    std::string result;
+    result.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] != '\\' || i + 1 == text.size()) {
+            result += text[i];
+            continue;
+        }
+        switch (text[++i]) {
+            case 't': result += '\t'; break;
+            case 'n': result += '\n'; break;
+            case 'r': result += '\r'; break;
+            default: result += text[i]; break;
+        }
+    }
+    return result;
+}
+
+std::vector<std::string> splitFields(const std::string& line) {
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true) {
+        size_t tab = line.find('\t', start);
+        fields.push_back(unescapeField(line.substr(start, tab - start)));
+        if (tab == std::string::npos) break;
+        start = tab + 1;
+    }
+    return fields;
+}
+
+} // namespace
+
+ResultCache::ResultCache(std::string directory, std::string config_key,
+                         std::string repo_root, BlobIndex index)
+    : directory_(std::move(directory)),
+      config_key_(std::move(config_key)),
+      repo_root_(std::move(repo_root)),
+      index_(std::move(index)) {}
+
+std::string ResultCache::makeConfigKey(const std::vector<std::string>& parts) {
+    uint64_t hash = Fingerprint::kOffsetBasis;
+    hash = Fingerprint::mix(hash, "results-v" + std::to_string(kResultVersion));
+    for (const auto& part : parts) {
+        hash = Fingerprint::mix(hash, part);
+    }
+    return Fingerprint::toHex(hash);
+}
+
+std::string ResultCache::absolutePath(const std::string& path) {
+    std::error_code ec;
+    fs::path absolute = fs::absolute(path, ec);
+    if (ec) return path;
+    return absolute.lexically_normal().string();
+}
+
+std::string ResultCache::repoRelative(const std::string& absolute) const {
+    if (repo_root_.empty() || absolute.size() <= repo_root_.size() ||
+        absolute.compare(0, repo_root_.size(), repo_root_) != 0 ||
+        absolute[repo_root_.size()] != '/') {
+        return "";
+    }
+    return absolute.substr(repo_root_.size() + 1);
+}
+
+std::string ResultCache::entryFile(const std::string& blob) const {
+    return (fs::path(directory_) / "results" / config_key_ / blob.substr(0, 2) / blob).string();
+}
+
+std::vector<ResultCache::Entry> ResultCache::readEntries(const std::string& file) const {
+    std::vector<Entry> entries;
+    std::ifstream in(file);
+    std::string line;
+    if (!in.is_open() || !std::getline(in, line) || line != kFileHeader) {
+        return entries;
+    }
+
+    while (std::getline(in, line)) {
+        if (line == "entry") {
+            entries.emplace_back();
+            continue;
+        }
+        if (entries.empty()) continue;
+
+        std::vector<std::string> fields = splitFields(line);
+        if (fields[0] == "dep" && fields.size() == 3) {
+            entries.back().dependencies.emplace_back(fields[1], fields[2]);
+        } else if (fields[0] == "issue" && fields.size() == 10) {
+            Issue issue;
+            try {
+                issue.file_path = fields[1];
+                issue.line = static_cast<unsigned>(std::stoul(fields[2]));
+                issue.column = static_cast<unsigned>(std::stoul(fields[3]));
+                int severity = std::stoi(fields[4]);
+                if (severity < 0 || severity > static_cast<int>(Severity::SUGGESTION)) continue;
+                issue.severity = static_cast<Severity>(severity);
+            } catch (const std::exception&) {
+                continue;
+            }
+            issue.rule_id = fields[5];
+            issue.description = fields[6];
+            issue.suggestion = fields[7];
+            issue.code_snippet = fields[8];
+            issue.enclosing_function = fields[9];
+            entries.back().issues.push_back(std::move(issue));
+        }
+    }
+
+    return entries;
+}
+
+bool ResultCache::writeEntries(const std::string& file, const std::vector<Entry>& entries) const {
+    std::error_code ec;
+    fs::create_directories(fs::path(file).parent_path(), ec);
+    if (ec) return false;
+
+    // 先写临时文件再重命名, 并发的读者不会看到写了一半的文件
+    std::string temp = file + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream out(temp);
+        if (!out.is_open()) return false;
+
+        out << kFileHeader << "\n";
+        for (const auto& entry : entries) {
+            out << "entry\n";
+            for (const auto& dep : entry.dependencies) {
+                out << "dep\t" << escapeField(dep.first) << "\t" << dep.second << "\n";
+            }
+            for (const auto& issue : entry.issues) {
+                out << "issue\t" << escapeField(issue.file_path)
+                    << "\t" << issue.line
+                    << "\t" << issue.column
+                    << "\t" << static_cast<int>(issue.severity)
+                    << "\t" << escapeField(issue.rule_id)
+                    << "\t" << escapeField(issue.description)
+                    << "\t" << escapeField(issue.suggestion)
+                    << "\t" << escapeField(issue.code_snippet)
+                    << "\t" << escapeField(issue.enclosing_function) << "\n";
+            }
+        }
+        if (!out) {
+            out.close();
+            fs::remove(temp, ec);
+            return false;
+        }
+    }
+
+    fs::rename(temp, file, ec);
+    if (ec) {
+        fs::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+std::optional<std::vector<Issue>> ResultCache::lookup(const std::string& tu_path) {
+    std::string absolute = absolutePath(tu_path);
+    auto blob = index_.find(repoRelative(absolute));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (blob == index_.end()) {
+        ++misses_;
+        return std::nullopt;
+    }
+
+    for (auto& entry : readEntries(entryFile(blob->second))) {
+        bool valid = true;
+        for (const auto& dep : entry.dependencies) {
+            auto current = index_.find(dep.first);
+            if (current == index_.end() || current->second != dep.second) {
+                valid = false;
+                break;
+            }
+        }
+        if (!valid) continue;
+
+        // 主文件中的问题以空路径保存, 改写为当前路径 (文件可能已重命名)
+        for (auto& issue : entry.issues) {
+            if (issue.file_path.empty()) {
+                issue.file_path = absolute;
+            }
+        }
+        ++hits_;
+        return std::move(entry.issues);
+    }
+
+    ++misses_;
+    return std::nullopt;
+}
+
+void ResultCache::store(const std::string& tu_path,
+                        const std::vector<std::string>& dependencies,
+                        const std::vector<Issue>& issues) {
+    std::string absolute = absolutePath(tu_path);
+    auto blob = index_.find(repoRelative(absolute));
+    if (blob == index_.end()) {
+        return;
+    }
+
+    Entry entry;
+    for (const auto& dependency : dependencies) {
+        std::string relative = repoRelative(absolutePath(dependency));
+        if (relative.empty()) {
+            continue;   // 仓库外的文件
+        }
+        auto dep_blob = index_.find(relative);
+        if (dep_blob == index_.end()) {
+            return;     // 未跟踪的依赖, 结果无法按内容复用
+        }
+        entry.dependencies.emplace_back(relative, dep_blob->second);
+    }
+    std::sort(entry.dependencies.begin(), entry.dependencies.end());
+    entry.dependencies.erase(std::unique(entry.dependencies.begin(), entry.dependencies.end()),
+                             entry.dependencies.end());
+
+    entry.issues = issues;
+    for (auto& issue : entry.issues) {
+        if (absolutePath(issue.file_path) == absolute) {
+            issue.file_path.clear();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // 新记录放在最前面, 替换依赖组合相同的旧记录
+    std::string file = entryFile(blob->second);
+    std::vector<Entry> entries = readEntries(file);
+    std::vector<Entry> updated;
+    updated.push_back(std::move(entry));
+    for (auto& old : entries) {
+        if (updated.size() >= kMaxEntriesPerBlob) break;
+        if (old.dependencies != updated.front().dependencies) {
+            updated.push_back(std::move(old));
+        }
+    }
+
+    writeEntries(file, updated);
+}
+
+} // namespace cpp_review
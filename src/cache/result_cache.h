@@ -0,0 +1,102 @@
+/*
+ * 分析结果缓存头文件
+ * 以 git blob SHA 为键缓存每个编译单元的分析结果
+ *
+ * 设计要点:
+ * - 键是编译单元的 blob SHA 而不是路径, 切换分支、变基或重命名文件后仍能命中
+ * - 每条缓存记录附带编译单元包含的仓库内头文件及其 blob SHA,
+ *   查找时全部一致才算命中; 同一 blob 最多保留几种头文件组合
+ * - 仓库外的文件 (系统头文件) 视为不变, 由配置键中的 C++ 标准区分
+ * - 配置键包含规则集合等影响结果的选项, 不同配置互不干扰
+ *
+ * 目录结构: <cache_dir>/results/<config_key>/<sha 前两位>/<sha>
+ */
+
+#pragma once
+
+#include "git/git_integration.h"
+#include "report/reporter.h"
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cpp_review {
+
+/**
+ * 编译单元结果缓存
+ * lookup/store 内部加锁, 可被多个分析线程同时调用
+ */
+class ResultCache {
+public:
+    /**
+     * @param directory 缓存根目录 (例如 .cpp-agent-cache)
+     * @param config_key 影响分析结果的配置摘要 (见 makeConfigKey)
+     * @param repo_root 仓库工作树根目录
+     * @param index 当前被分析版本的 blob 索引
+     */
+    ResultCache(std::string directory, std::string config_key,
+                std::string repo_root, BlobIndex index);
+
+    /**
+     * 查找编译单元的缓存结果
+     * @param tu_path 编译单元路径
+     * @return 命中时返回问题列表 (主文件中问题的路径改写为当前路径)
+     */
+    std::optional<std::vector<Issue>> lookup(const std::string& tu_path);
+
+    /**
+     * 保存编译单元的分析结果
+     * 编译单元或任一仓库内依赖未被 git 跟踪时不缓存
+     * @param tu_path 编译单元路径
+     * @param dependencies 编译单元读取过的所有文件 (含主文件)
+     * @param issues 该编译单元的全部问题
+     */
+    void store(const std::string& tu_path,
+               const std::vector<std::string>& dependencies,
+               const std::vector<Issue>& issues);
+
+    /**
+     * 计算配置键 (已包含 kResultVersion)
+     * @param parts 影响结果的配置项 (规则 ID、C++ 标准等)
+     * @return 16 位十六进制摘要
+     */
+    static std::string makeConfigKey(const std::vector<std::string>& parts);
+
+    size_t getHitCount() const { return hits_; }
+    size_t getMissCount() const { return misses_; }
+
+    // 分析结果版本: 规则检测逻辑或 Issue 字段变化时递增, 使旧版本写入的缓存条目全部失效
+    static constexpr int kResultVersion = 2;
+
+    // 同一编译单元 blob 最多保留的依赖组合数
+    static constexpr size_t kMaxEntriesPerBlob = 4;
+
+private:
+    // 一条缓存记录
+    struct Entry {
+        std::vector<std::pair<std::string, std::string>> dependencies;  // 仓库相对路径, blob SHA
+        std::vector<Issue> issues;
+    };
+
+    // 绝对规范化路径
+    static std::string absolutePath(const std::string& path);
+    // 仓库相对路径 (不在仓库内返回空)
+    std::string repoRelative(const std::string& absolute) const;
+    // blob 对应的缓存文件
+    std::string entryFile(const std::string& blob) const;
+
+    std::vector<Entry> readEntries(const std::string& file) const;
+    bool writeEntries(const std::string& file, const std::vector<Entry>& entries) const;
+
+    std::string directory_;
+    std::string config_key_;
+    std::string repo_root_;
+    BlobIndex index_;
+
+    std::mutex mutex_;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+};
+
+} // namespace cpp_review
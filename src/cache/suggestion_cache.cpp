@@ -0,0 +1,206 @@
+/*
+ * AI 建议缓存实现
+ */
+
+#include "cache/suggestion_cache.h"
+#include "report/fingerprint.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+namespace cpp_review {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr const char* kFileHeader = "# cpp-agent suggestion v1";
+
+// 十六进制文件名 -> 键
+std::optional<uint64_t> parseKey(const std::string& name) {
+    if (name.size() != 16 || name.find_first_not_of("0123456789abcdef") != std::string::npos) {
+        return std::nullopt;
+    }
+    return std::stoull(name, nullptr, 16);
+}
+
+} // namespace
+
+SuggestionCache::SuggestionCache(std::string directory, uint64_t max_bytes)
+    : directory_(std::move(directory)), max_bytes_(max_bytes) {}
+
+uint64_t SuggestionCache::makeKey(const Issue& issue, const std::string& provider_identity) {
+    uint64_t hash = Fingerprint::kOffsetBasis;
+    hash = Fingerprint::mix(hash, "suggestion-v1");
+    hash = Fingerprint::mix(hash, provider_identity);
+    hash = Fingerprint::mix(hash, issue.rule_id);
+    hash = Fingerprint::mix(hash, issue.code_snippet.empty()
+                                      ? Fingerprint::normalizeMessage(issue.description)
+                                      : Fingerprint::normalizeSnippet(issue.code_snippet));
+    return hash;
+}
+
+std::string SuggestionCache::entryFile(uint64_t key) const {
+    std::string hex = Fingerprint::toHex(key);
+    return (fs::path(directory_) / "suggestions" / hex.substr(0, 2) / hex).string();
+}
+
+void SuggestionCache::loadIndex() {
+    std::error_code ec;
+    fs::path root = fs::path(directory_) / "suggestions";
+    if (!fs::is_directory(root, ec)) {
+        return;
+    }
+
+    // 目录扫描不持锁, 扫描完成后一次性建立索引
+    std::vector<std::pair<fs::file_time_type, std::pair<uint64_t, uint64_t>>> found;  // (时间, (键, 大小))
+    for (fs::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_regular_file(ec)) continue;
+        auto key = parseKey(it->path().filename().string());
+        if (!key) continue;
+        uint64_t size = it->file_size(ec);
+        fs::file_time_type time = it->last_write_time(ec);
+        if (ec) {
+            ec.clear();
+            continue;
+        }
+        found.push_back({time, {*key, size}});
+    }
+
+    std::sort(found.begin(), found.end(),
+              [](const auto& a, const auto& b) { return a.first > b.first; });
+    std::vector<uint64_t> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& item : found) {
+            uint64_t key = item.second.first;
+            lru_.push_back(key);
+            entries_[key] = {item.second.second, std::prev(lru_.end())};
+            total_bytes_ += item.second.second;
+        }
+        evicted = evict();
+    }
+    removeEntries(evicted);
+}
+
+std::vector<uint64_t> SuggestionCache::evict() {
+    std::vector<uint64_t> evicted;
+    while (total_bytes_ > max_bytes_ && !lru_.empty()) {
+        uint64_t key = lru_.back();
+        lru_.pop_back();
+        auto it = entries_.find(key);
+        total_bytes_ -= it->second.size;
+        entries_.erase(it);
+        evicted.push_back(key);
+        ++evictions_;
+    }
+    return evicted;
+}
+
+void SuggestionCache::removeEntries(const std::vector<uint64_t>& keys) const {
+    std::error_code ec;
+    for (uint64_t key : keys) {
+        fs::remove(entryFile(key), ec);
+    }
+}
+
+std::optional<std::string> SuggestionCache::lookup(uint64_t key) {
+    std::call_once(load_once_, [this] { loadIndex(); });
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (entries_.find(key) == entries_.end()) {
+            ++misses_;
+            return std::nullopt;
+        }
+    }
+
+    // 读文件不持锁; 期间记录可能被其他线程淘汰, 读取失败时按未命中处理
+    std::string file = entryFile(key);
+    std::ifstream in(file, std::ios::binary);
+    std::string header;
+    bool valid = in.is_open() && std::getline(in, header) && header == kFileHeader;
+    std::ostringstream content;
+    if (valid) {
+        content << in.rdbuf();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (!valid) {
+            // 被外部删除或损坏的记录
+            if (it != entries_.end()) {
+                total_bytes_ -= it->second.size;
+                lru_.erase(it->second.position);
+                entries_.erase(it);
+            }
+            ++misses_;
+            return std::nullopt;
+        }
+        // 移到最前
+        if (it != entries_.end()) {
+            lru_.splice(lru_.begin(), lru_, it->second.position);
+        }
+        ++hits_;
+    }
+
+    // 刷新修改时间供下次运行恢复顺序
+    std::error_code ec;
+    fs::last_write_time(file, fs::file_time_type::clock::now(), ec);
+    return content.str();
+}
+
+void SuggestionCache::store(uint64_t key, const std::string& suggestion) {
+    std::call_once(load_once_, [this] { loadIndex(); });
+
+    std::string file = entryFile(key);
+    std::error_code ec;
+    fs::create_directories(fs::path(file).parent_path(), ec);
+    if (ec) return;
+
+    // 先写临时文件再重命名, 并发的读者不会看到写了一半的文件;
+    // 临时文件名带线程序号, 同一进程中并发写入同一键时互不干扰
+    std::ostringstream temp_name;
+    temp_name << file << ".tmp." << getpid() << "." << std::this_thread::get_id();
+    std::string temp = temp_name.str();
+    {
+        std::ofstream out(temp, std::ios::binary);
+        if (!out.is_open()) return;
+        out << kFileHeader << "\n" << suggestion;
+        if (!out) {
+            out.close();
+            fs::remove(temp, ec);
+            return;
+        }
+    }
+    fs::rename(temp, file, ec);
+    if (ec) {
+        fs::remove(temp, ec);
+        return;
+    }
+
+    // 只有 LRU 记录的更新持锁, 被淘汰记录的文件在锁外删除
+    uint64_t size = std::string(kFileHeader).size() + 1 + suggestion.size();
+    std::vector<uint64_t> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            total_bytes_ -= it->second.size;
+            lru_.erase(it->second.position);
+        }
+        lru_.push_front(key);
+        entries_[key] = {size, lru_.begin()};
+        total_bytes_ += size;
+        evicted = evict();
+    }
+    removeEntries(evicted);
+}
+
+} // namespace cpp_review
@@ -0,0 +1,93 @@
+/*
+ * AI 建议缓存头文件
+ * 以 (规则 ID, 规范化代码片段, 提供者/模型, 提示词版本) 的哈希为键,
+ * 在磁盘上缓存 LLM 生成的修复建议
+ *
+ * 设计要点:
+ * - 同一模式 (如循环拷贝、strcpy) 在不同文件中反复出现时, 只请求一次模型
+ * - 键不含路径和行号, 代码片段按空白规范化, 重复运行的 CI 只为新片段请求模型
+ * - 总大小超过上限时按最近使用时间 (LRU) 淘汰; 命中时刷新文件修改时间,
+ *   下次运行据此恢复使用顺序
+ *
+ * 目录结构: <cache_dir>/suggestions/<key 前两位>/<key>
+ */
+
+#pragma once
+
+#include "report/reporter.h"
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cpp_review {
+
+/**
+ * AI 建议缓存
+ * lookup/store 内部加锁, 可被多个请求线程同时调用
+ */
+class SuggestionCache {
+public:
+    /**
+     * @param directory 缓存根目录 (例如 .cpp-agent-cache)
+     * @param max_bytes 缓存总大小上限 (字节)
+     */
+    SuggestionCache(std::string directory, uint64_t max_bytes);
+
+    /**
+     * 计算问题的缓存键
+     * 没有代码片段的问题使用规范化描述代替
+     * @param issue 问题
+     * @param provider_identity 提供者标识 (提供者、模型、提示词版本)
+     */
+    static uint64_t makeKey(const Issue& issue, const std::string& provider_identity);
+
+    /**
+     * 查找缓存的建议, 命中时刷新其使用时间
+     */
+    std::optional<std::string> lookup(uint64_t key);
+
+    /**
+     * 保存建议, 超过大小上限时淘汰最久未使用的记录
+     */
+    void store(uint64_t key, const std::string& suggestion);
+
+    size_t getHitCount() const { return hits_; }
+    size_t getMissCount() const { return misses_; }
+    size_t getEvictionCount() const { return evictions_; }
+
+private:
+    // 一条记录的大小和在 LRU 链表中的位置
+    struct Entry {
+        uint64_t size = 0;
+        std::list<uint64_t>::iterator position;
+    };
+
+    // 第一次使用时扫描缓存目录, 按文件修改时间恢复 LRU 顺序 (只执行一次, 扫描期间不持锁)
+    void loadIndex();
+    // 淘汰最久未使用的记录直到不超过上限, 返回被淘汰的键 (调用方持有锁, 文件由调用方在锁外删除)
+    std::vector<uint64_t> evict();
+
+    // 删除记录对应的缓存文件 (不持锁调用)
+    void removeEntries(const std::vector<uint64_t>& keys) const;
+    // 记录对应的缓存文件
+    std::string entryFile(uint64_t key) const;
+
+    std::string directory_;
+    uint64_t max_bytes_;
+
+    std::once_flag load_once_;
+    std::mutex mutex_;                             // 只保护内存中的 LRU 记录, 文件读写不持锁
+    std::list<uint64_t> lru_;                      // 最近使用的在前
+    std::unordered_map<uint64_t, Entry> entries_;
+    uint64_t total_bytes_ = 0;
+
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+    size_t evictions_ = 0;
+};
+
+} // namespace cpp_review
@@ -67,6 +67,83 @@ CLIOptions CLI::parseArguments(int argc, char* argv[]) {
             options.html_output = arg.substr(14);
             options.generate_html = true;
         }
+        else if (arg == "--html-dir" && i + 1 < argc) {
+            options.html_dir = argv[++i];
+            options.generate_html = true;
+        }
+        else if (arg.find("--html-dir=") == 0) {
+            options.html_dir = arg.substr(11);
+            options.generate_html = true;
+        }
+        else if (arg == "--fast") {
+            options.fast = true;
+        }
+        else if (arg == "--fail-fast") {
+            options.fail_fast = "CRITICAL";
+        }
+        else if (arg.find("--fail-fast=") == 0) {
+            options.fail_fast = arg.substr(12);
+        }
+        else if ((arg == "--max-issues" && i + 1 < argc) || arg.find("--max-issues=") == 0) {
+            std::string value = arg == "--max-issues" ? argv[++i] : arg.substr(13);
+            try {
+                options.max_issues = static_cast<size_t>(std::max(0, std::stoi(value)));
+            } catch (const std::exception&) {
+                std::cerr << "Warning: Invalid --max-issues value, ignored\n";
+            }
+        }
+        else if (arg == "--ai") {
+            options.enable_ai = true;
+        }
+        else if (arg.find("--llm-provider=") == 0) {
+            options.enable_ai = true;
+            options.llm_provider = arg.substr(15);
+        }
+        else if (arg.find("--llm-endpoint=") == 0) {
+            options.llm_endpoint = arg.substr(15);
+        }
+        else if ((arg == "--llm-time-budget" && i + 1 < argc) || arg.find("--llm-time-budget=") == 0) {
+            std::string value = arg == "--llm-time-budget" ? argv[++i] : arg.substr(18);
+            try {
+                options.llm_time_budget = std::max(0, std::stoi(value));
+            } catch (const std::exception&) {
+                std::cerr << "Warning: Invalid --llm-time-budget value, ignored\n";
+            }
+        }
+        else if (arg == "--format" && i + 1 < argc) {
+            options.output_format = argv[++i];
+        }
+        else if (arg.find("--format=") == 0) {
+            options.output_format = arg.substr(9);
+        }
+        else if (arg == "--output" && i + 1 < argc) {
+            options.output_file = argv[++i];
+        }
+        else if (arg.find("--output=") == 0) {
+            options.output_file = arg.substr(9);
+        }
+        else if (arg == "--stats" && i + 1 < argc) {
+            options.stats_file = argv[++i];
+        }
+        else if (arg.find("--stats=") == 0) {
+            options.stats_file = arg.substr(8);
+        }
+        else if (arg == "--hw-counters") {
+            options.hw_counters = true;
+        }
+        else if ((arg == "--metrics-port" && i + 1 < argc) || arg.find("--metrics-port=") == 0) {
+            std::string value = arg == "--metrics-port" ? argv[++i] : arg.substr(15);
+            int port = -1;
+            try {
+                port = std::stoi(value);
+            } catch (const std::exception&) {
+            }
+            if (port < 0 || port > 65535) {
+                std::cerr << "Warning: Invalid --metrics-port value, ignored\n";
+            } else {
+                options.metrics_port = port;
+            }
+        }
         // ===== V1.5 Git 集成选项 =====
         else if (arg == "--incremental" || arg == "-i") {
             options.incremental = true;
@@ -107,18 +184,64 @@ CLIOptions CLI::parseArguments(int argc, char* argv[]) {
         else if (arg.find("--pr-comment=") == 0) {
             options.pr_comment_file = arg.substr(13);
         }
+        else if (arg == "--rev" && i + 1 < argc) {
+            options.revision = argv[++i];
+        }
+        else if (arg.find("--rev=") == 0) {
+            options.revision = arg.substr(6);
+        }
+        else if (arg == "--blame") {
+            options.blame = true;
+        }
+        else if (arg == "--cache") {
+            options.cache_dir = ".cpp-agent-cache";
+        }
+        else if (arg == "--cache-dir" && i + 1 < argc) {
+            options.cache_dir = argv[++i];
+        }
+        else if (arg.find("--cache-dir=") == 0) {
+            options.cache_dir = arg.substr(12);
+        }
+        // ===== 基线选项 =====
+        else if (arg == "--baseline" && i + 1 < argc) {
+            options.baseline_file = argv[++i];
+        }
+        else if (arg.find("--baseline=") == 0) {
+            options.baseline_file = arg.substr(11);
+        }
+        else if (arg == "--update-baseline") {
+            options.update_baseline = true;
+        }
+        // ===== 目录扫描选项 =====
+        else if (arg == "--exclude" && i + 1 < argc) {
+            options.exclude_patterns.push_back(argv[++i]);
+        }
+        else if (arg.find("--exclude=") == 0) {
+            options.exclude_patterns.push_back(arg.substr(10));
+        }
+        else if (arg == "--include-headers") {
+            options.include_headers = true;
+        }
+        else if (arg == "--header-only") {
+            options.header_only = true;
+        }
+        else if (arg.find("--header-batch=") == 0) {
+            options.header_only = true;
+            try {
+                options.header_batch_size = std::max(1, std::stoi(arg.substr(15)));
+            } catch (const std::exception&) {
+                std::cerr << "Warning: Invalid --header-batch value, using default\n";
+            }
+        }
         else if (arg == "scan" && i + 1 < argc) {
             // 扫描命令:下一个参数应该是路径
             ++i;
             std::string path = argv[i];
+            options.scan_targets.push_back(path);
 
             if (fs::is_directory(path)) {
-                // 递归查找目录中的所有 C++ 源文件
-                for (const auto& entry : fs::recursive_directory_iterator(path)) {
-                    if (entry.is_regular_file() && isSourceFile(entry.path().string())) {
-                        options.source_paths.push_back(entry.path().string());
-                    }
-                }
+                // 目录在加载配置后由 DirectoryWalker 并行遍历 (需要 exclude 配置)
+                options.scan_directories.push_back(path);
             }
             else if (fs::is_regular_file(path) && isSourceFile(path)) {
                 // 单个文件
@@ -135,6 +258,7 @@ CLIOptions CLI::parseArguments(int argc, char* argv[]) {
         else if (isSourceFile(arg)) {
             // 直接指定文件路径
             options.source_paths.push_back(arg);
+            options.scan_targets.push_back(arg);
         }
     }
 
@@ -155,13 +279,55 @@ USAGE:
     cpp-agent <file.cpp> [options]
 
 COMMANDS:
-    scan <path>         Scan a C++ file or directory
+    scan <path>         Scan a C++ file or directory; directories are walked in
+                        parallel, honoring .gitignore and exclude patterns
 
 OPTIONS:
     --std=<standard>        Specify C++ standard (default: c++17)
                             Examples: c++11, c++14, c++17, c++20
     --html                  Generate HTML report
     --html-output=<file>    HTML report output file (default: report.html)
+    --html-dir=<dir>        Split HTML report for large results: small index.html
+                            plus per-file data chunks loaded on demand
+    --exclude=<glob>        Skip matching files and directories when scanning
+                            (repeatable; added to 'exclude' in .cpp-agent.yml)
+    --include-headers       Also analyze headers found in scanned directories as
+                            separate translation units (default: sources only)
+    --header-only           Header-only library mode: headers are analyzed in
+                            batches through in-memory umbrella translation units,
+                            issues are reported against the originating header
+    --header-batch=<n>      Headers per umbrella unit (default: 16, implies
+                            --header-only)
+    --fast                  Fast tier for pre-commit hooks: run only lexical rules
+                            (UNSAFE-C-FUNC-001, ASSIGN-COND-001) on the raw token
+                            stream, without preprocessing or semantic analysis;
+                            ignored with --baseline, --pr and --format=sarif,
+                            whose fingerprints need the full analysis
+    --fail-fast[=<level>]   Stop at the first reported issue at or above <level>
+                            (default: CRITICAL); remaining files are skipped and
+                            the exit code is 2
+    --max-issues=<n>        Stop once <n> issues have been reported
+    --ai                    Append AI fix suggestions to each issue; requests run
+                            in the background while files are still analyzed
+    --llm-provider=<name>   Suggestion provider: rule-based|openai (default:
+                            rule-based, implies --ai); openai talks to any
+                            OpenAI-compatible chat/completions endpoint
+    --llm-endpoint=<url>    Endpoint for --llm-provider=openai (http:// only;
+                            default: http://localhost:8080/v1/chat/completions)
+    --llm-time-budget=<s>   Stop requesting AI suggestions <s> seconds after the
+                            run started; remaining issues get rule-based text
+    --format=<format>       Report format: console|sarif (default: console)
+                            sarif writes SARIF 2.1.0 and prints only the summary
+    --output=<file>         Output file for --format=sarif (default: cpp-agent.sarif)
+    --stats=<file>          Write run statistics as JSON: wall time, per-phase
+                            times, peak RSS and issue counts, plus per translation
+                            unit AST/source memory, RSS delta and node counts
+    --hw-counters           Profile each rule and each parse with hardware counters
+                            (cycles, instructions, cache and branch misses) via
+                            perf_event_open; per-TU samples go to --stats
+    --metrics-port=<port>   Serve live Prometheus metrics on
+                            http://127.0.0.1:<port>/metrics while the scan runs
+                            (0 disables the endpoint, overriding metrics_port)
     -h, --help              Display this help message
     -v, --version           Display version information
 
@@ -170,8 +336,25 @@ GIT INTEGRATION OPTIONS (V1.5):
     --incremental=<mode>    Incremental mode: workspace|staged|branch|commit|pr
     --branch=<name>         Analyze changes vs. specified branch
     --commit=<hash>         Analyze changes since commit
-    --pr                    PR review mode (auto-detect base branch)
+    --pr                    PR review mode (auto-detect base branch); reports only
+                            issues new vs. the merge-base, plus issues fixed.
+                            Merge-base results are always cached, in --cache-dir
+                            or ./.cpp-agent-cache by default; cannot be combined
+                            with --update-baseline
     --pr-comment=<file>     Output PR comment to file
+    --rev=<commit>          Analyze files as of <commit>, read straight from the
+                            git object store (no checkout, working tree untouched)
+    --blame                 Attach author and commit (git blame) to each issue;
+                            one incremental blame per file, files run in parallel
+    --cache                 Reuse results of unchanged files, keyed by git blob SHA
+                            of the file and its includes (survives branch switches,
+                            rebases and renames)
+    --cache-dir=<dir>       Result cache directory (default: .cpp-agent-cache)
+
+BASELINE OPTIONS:
+    --baseline=<file>       Suppress known issues listed in baseline file
+    --update-baseline       Write all current issues to the baseline file
+                            (default file: .cpp-agent-baseline)
 
 EXAMPLES:
     # Scan a single file
@@ -180,12 +363,30 @@ EXAMPLES:
     # Scan an entire directory
     cpp-agent scan /path/to/project
 
+    # Sub-second pre-commit check (lexical rules only)
+    cpp-agent --incremental=staged --fast
+
+    # AI suggestions from a self-hosted model
+    cpp-agent scan src/ --llm-provider=openai --llm-endpoint=http://127.0.0.1:8000/v1/chat/completions
+
+    # Abort on the first HIGH or CRITICAL issue
+    cpp-agent scan src/ --fail-fast=HIGH
+
+    # Header-only library
+    cpp-agent scan include/ --header-only --header-batch=32
+
+    # Skip generated and vendored code
+    cpp-agent scan . --exclude=third_party --exclude="*.pb.cc"
+
     # Generate HTML report
     cpp-agent scan main.cpp --html
 
     # Specify custom HTML output
     cpp-agent scan main.cpp --html-output=my_report.html
 
+    # SARIF output for CI code scanning
+    cpp-agent scan src/ --format=sarif --output=results.sarif
+
     # Specify C++ standard
     cpp-agent scan main.cpp --std=c++20
 
@@ -198,6 +399,12 @@ EXAMPLES:
     cpp-agent --commit=abc123            # Analyze since commit abc123
     cpp-agent --pr                       # PR review mode
     cpp-agent --pr --pr-comment=review.md  # Generate PR comment
+    cpp-agent scan src/ --rev=origin/main  # Analyze another revision in place
+    cpp-agent scan src/ --cache          # Skip files analyzed before (any branch)
+
+    # Baseline (only report new issues)
+    cpp-agent scan src/ --update-baseline          # Record known issues
+    cpp-agent scan src/ --baseline=.cpp-agent-baseline
 
 DETECTED ISSUES (V2.0):
     Bug Detection (V1.0):
@@ -221,6 +428,12 @@ CONFIGURATION:
     - disabled_rules: [RULE-ID-001, RULE-ID-002]
     - html_output: true
     - cpp_standard: c++20
+    - include / exclude: [src/**, "*_test.cpp"]
+    - scan_headers: true (analyze headers as separate translation units)
+    - use_gitignore: false (do not honor .gitignore when scanning)
+    - header_only: true, header_batch_size: 16, include_directories: [include]
+    - rule_severity: per-rule severity mapping (RULE-ID: LOW)
+    - overrides: per-path enabled_rules / disabled_rules / severity
 
 For more information, visit: https://github.com/yourusername/cpp-code-review
 )";
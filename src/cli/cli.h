@@ -16,13 +16,30 @@ namespace cpp_review {
  */
 struct CLIOptions {
     std::vector<std::string> source_paths;  // 要分析的源文件路径列表
+    std::vector<std::string> scan_targets;  // 命令行给出的原始路径 (scan 目录与直接指定的文件)
+    std::vector<std::string> scan_directories; // scan 给出的目录 (加载配置后并行遍历)
+    std::vector<std::string> exclude_patterns; // 命令行给出的排除模式 (追加到配置中的 exclude)
+    bool include_headers = false;            // 目录扫描时也把头文件作为独立翻译单元
+    bool header_only = false;                // 仅头文件库模式 (头文件分批合成伞形编译单元)
+    size_t header_batch_size = 0;            // 每批头文件数 (0 表示使用配置或默认值)
     std::string cpp_standard = "c++17";      // C++ 标准版本
     bool help = false;                       // 是否显示帮助信息
     bool version = false;                    // 是否显示版本信息
     bool generate_html = false;              // 是否生成 HTML 报告
     std::string html_output = "report.html"; // HTML 输出文件名
+    std::string html_dir = "";               // 分片 HTML 报告输出目录 (大型报告)
+    std::string output_format = "console";   // 输出格式: console/sarif
+    std::string output_file = "";            // 机器可读报告的输出文件
+    std::string stats_file = "";             // 运行统计 JSON 的输出文件 (空表示不输出)
+    bool hw_counters = false;                // 用硬件计数器剖析每个规则和每次解析 (perf_event_open)
+    int metrics_port = -1;                   // 指标端点端口 (-1 表示使用配置)
+    bool fast = false;                       // 快速模式: 只运行词法级规则, 不做语义分析
+    std::string fail_fast = "";              // 首个达到该严重性的问题出现后停止 (空表示不启用)
+    size_t max_issues = 0;                   // 报告问题数达到上限后停止 (0 表示不限)
     bool enable_ai = false;                  // 启用 AI 建议 (V2.0)
-    std::string llm_provider = "rule-based"; // LLM 提供者 (V2.0)
+    std::string llm_provider = "";           // LLM 提供者 (V2.0, 空表示使用配置)
+    std::string llm_endpoint = "";           // OpenAI 兼容接口地址 (空表示使用配置)
+    int llm_time_budget = -1;                // AI 增强的时间预算 (秒, -1 表示使用配置)
 
     // ===== V1.5 Git 集成选项 =====
     bool incremental = false;                // 增量分析模式
@@ -30,6 +47,13 @@ struct CLIOptions {
     std::string git_reference = "";          // Git 参考 (分支名/提交哈希)
     bool pr_mode = false;                    // PR 审查模式
     std::string pr_comment_file = "";        // PR 评论输出文件
+    std::string revision = "";               // 直接分析指定提交 (从对象库读取, 无需检出)
+    std::string cache_dir = "";              // 结果缓存目录 (按 git blob SHA 复用分析结果)
+    bool blame = false;                      // 为问题标注 git blame 作者和提交
+
+    // ===== 基线选项 =====
+    std::string baseline_file = "";          // 已知问题基线文件
+    bool update_baseline = false;            // 用本次结果重新生成基线
 };
 
 /**
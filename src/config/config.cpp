@@ -4,6 +4,7 @@
  */
 
 #include "config/config.h"
+#include "config/yaml_parser.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
@@ -25,89 +26,261 @@ std::string ConfigManager::trim(const std::string& str) {
 }
 
 /**
- * 解析配置文件的单行
- * 支持简单的 YAML 格式: key: value
- * @param line 配置文件的一行
- * @param config 要更新的配置对象
+ * 解析布尔值
  */
-void ConfigManager::parseLine(const std::string& line, Config& config) {
-    std::string trimmed = trim(line);
+static bool parseBool(const std::string& value) {
+    std::string lower_value = value;
+    std::transform(lower_value.begin(), lower_value.end(), lower_value.begin(), ::tolower);
+    return lower_value == "true" || lower_value == "yes" || lower_value == "1";
+}
 
-    // 跳过空行和注释行
-    if (trimmed.empty() || trimmed[0] == '#') {
-        return;
+/**
+ * 解析规则 ID 列表
+ * 兼容旧格式中的 "A, B" 纯量写法
+ */
+static std::set<std::string> parseRuleList(const YamlNode& value) {
+    std::set<std::string> rules;
+    for (const auto& item : value.asStringList()) {
+        std::istringstream stream(item);
+        std::string rule;
+        while (std::getline(stream, rule, ',')) {
+            size_t first = rule.find_first_not_of(" \t");
+            if (first == std::string::npos) continue;
+            rules.insert(rule.substr(first, rule.find_last_not_of(" \t") - first + 1));
+        }
     }
+    return rules;
+}
 
-    // 查找键值分隔符 (:)
-    size_t colon_pos = trimmed.find(':');
-    if (colon_pos == std::string::npos) {
-        return;
+/**
+ * 解析 "规则 ID: 严重性" 映射
+ */
+static std::map<std::string, std::string> parseSeverityMap(const YamlNode& value) {
+    std::map<std::string, std::string> severity;
+    for (const auto& entry : value.entries) {
+        if (entry.second.isScalar()) {
+            severity[entry.first] = entry.second.scalar;
+        }
     }
+    return severity;
+}
 
-    std::string key = trim(trimmed.substr(0, colon_pos));
-    std::string value = trim(trimmed.substr(colon_pos + 1));
+/**
+ * 解析 overrides 列表中的一项
+ * 例如:
+ *   - paths: [tests/]
+ *     disabled_rules: [MEMORY-LEAK-001]
+ *     severity:
+ *       UNSAFE-C-FUNC-001: LOW
+ */
+RuleOverride ConfigManager::parseOverride(const YamlNode& node) {
+    RuleOverride result;
+    if (!node.isMapping()) {
+        std::cerr << "Warning: Configuration line " << node.line
+                  << ": each override must be a mapping, ignored\n";
+        return result;
+    }
 
+    for (const auto& entry : node.entries) {
+        const std::string& key = entry.first;
+        if (key == "paths" || key == "path") {
+            result.paths = entry.second.asStringList();
+        } else if (key == "enabled_rules" || key == "enable") {
+            result.enabled_rules = parseRuleList(entry.second);
+        } else if (key == "disabled_rules" || key == "disable") {
+            result.disabled_rules = parseRuleList(entry.second);
+        } else if (key == "severity" || key == "rule_severity") {
+            result.severity = parseSeverityMap(entry.second);
+        } else {
+            std::cerr << "Warning: Configuration line " << entry.second.line
+                      << ": unknown override key '" << key << "'\n";
+        }
+    }
+
+    if (result.paths.empty()) {
+        std::cerr << "Warning: Configuration line " << node.line
+                  << ": override without paths has no effect\n";
+    }
+    return result;
+}
+
+/**
+ * 应用一个顶层配置项
+ * @param key 配置键
+ * @param value 配置值节点
+ * @param config 要更新的配置对象
+ */
+void ConfigManager::applySetting(const std::string& key, const YamlNode& value, Config& config) {
     // 根据键名解析不同的配置项
     if (key == "disabled_rules") {
-        // 解析禁用规则列表 (逗号或空格分隔)
-        std::istringstream iss(value);
-        std::string rule;
-
-        // 移除方括号 (如果存在)
-        if (!value.empty() && value[0] == '[') {
-            value = value.substr(1);
+        // 禁用规则列表: [A, B] 或块序列
+        std::set<std::string> rules = parseRuleList(value);
+        config.disabled_rules.insert(rules.begin(), rules.end());
+    }
+    else if (key == "rule_severity") {
+        // 规则严重性覆盖映射
+        for (const auto& entry : parseSeverityMap(value)) {
+            config.rule_severity[entry.first] = entry.second;
         }
-        if (!value.empty() && value.back() == ']') {
-            value.pop_back();
+    }
+    else if (key == "overrides") {
+        // 按路径覆盖的规则设置
+        if (!value.isSequence()) {
+            std::cerr << "Warning: Configuration line " << value.line
+                      << ": 'overrides' must be a list\n";
+            return;
         }
-
-        // 解析逗号分隔的值
-        std::istringstream stream(value);
-        while (std::getline(stream, rule, ',')) {
-            rule = trim(rule);
-            if (!rule.empty()) {
-                config.disabled_rules.insert(rule);
-            }
+        for (const auto& item : value.items) {
+            config.overrides.push_back(parseOverride(item));
         }
     }
+    else if (key == "include_directories") {
+        config.include_directories = value.asStringList();
+    }
+    else if (key == "include") {
+        config.include_paths = value.asStringList();
+    }
+    else if (key == "exclude") {
+        config.exclude_paths = value.asStringList();
+    }
+    else if (!value.isScalar() && !value.isNull()) {
+        std::cerr << "Warning: Configuration line " << value.line
+                  << ": unexpected structured value for '" << key << "'\n";
+    }
     else if (key == "html_output") {
-        std::string lower_value = value;
-        std::transform(lower_value.begin(), lower_value.end(), lower_value.begin(), ::tolower);
-        config.generate_html = (lower_value == "true" || lower_value == "yes" || lower_value == "1");
+        config.generate_html = parseBool(value.scalar);
     }
     else if (key == "html_output_file") {
-        config.html_output_file = value;
+        config.html_output_file = value.scalar;
+    }
+    else if (key == "html_output_dir") {
+        config.html_output_dir = value.scalar;
+    }
+    else if (key == "baseline_file" || key == "baseline") {
+        config.baseline_file = value.scalar;
+    }
+    else if (key == "cache_dir") {
+        config.cache_dir = value.scalar;
+    }
+    else if (key == "metrics_port") {
+        int port = -1;
+        try {
+            port = std::stoi(value.scalar);
+        } catch (const std::exception&) {
+        }
+        if (port < 0 || port > 65535) {
+            std::cerr << "Warning: Configuration line " << value.line
+                      << ": 'metrics_port' must be a port number (0 disables the endpoint)\n";
+        } else {
+            config.metrics_port = port;
+        }
+    }
+    else if (key == "scan_headers") {
+        config.scan_headers = parseBool(value.scalar);
+    }
+    else if (key == "use_gitignore") {
+        config.use_gitignore = parseBool(value.scalar);
+    }
+    else if (key == "header_only") {
+        config.header_only = parseBool(value.scalar);
+    }
+    else if (key == "header_batch_size") {
+        try {
+            config.header_batch_size = std::max(1, std::stoi(value.scalar));
+        } catch (const std::exception&) {
+            std::cerr << "Warning: Configuration line " << value.line
+                      << ": 'header_batch_size' must be a positive integer\n";
+        }
     }
     else if (key == "cpp_standard") {
-        config.cpp_standard = value;
+        config.cpp_standard = value.scalar;
     }
     else if (key == "verbose") {
-        std::string lower_value = value;
-        std::transform(lower_value.begin(), lower_value.end(), lower_value.begin(), ::tolower);
-        config.verbose = (lower_value == "true" || lower_value == "yes" || lower_value == "1");
+        config.verbose = parseBool(value.scalar);
+    }
+    else if (key == "fast") {
+        config.fast = parseBool(value.scalar);
     }
     else if (key.find("severity_") == 0) {
         // 规则严重性覆盖: severity_RULE-ID: HIGH
         std::string rule_id = key.substr(9); // 移除 "severity_" 前缀
-        config.rule_severity[rule_id] = value;
+        config.rule_severity[rule_id] = value.scalar;
     }
     // ===== V2.0 LLM 配置选项 =====
     else if (key == "enable_ai_suggestions" || key == "ai_suggestions") {
-        std::string lower_value = value;
-        std::transform(lower_value.begin(), lower_value.end(), lower_value.begin(), ::tolower);
-        config.enable_ai_suggestions = (lower_value == "true" || lower_value == "yes" || lower_value == "1");
+        config.enable_ai_suggestions = parseBool(value.scalar);
     }
     else if (key == "llm_provider") {
-        config.llm_provider = value;
+        config.llm_provider = value.scalar;
     }
     else if (key == "llm_api_key" || key == "openai_api_key") {
-        config.llm_api_key = value;
+        config.llm_api_key = value.scalar;
+    }
+    else if (key == "llm_endpoint") {
+        config.llm_endpoint = value.scalar;
+    }
+    else if (key == "llm_model") {
+        config.llm_model = value.scalar;
+    }
+    else if (key == "llm_cluster") {
+        config.llm_cluster = parseBool(value.scalar);
+    }
+    else if (key == "llm_cache") {
+        config.llm_cache = parseBool(value.scalar);
+    }
+    else if (key == "llm_cache_size_mb") {
+        try {
+            config.llm_cache_size_mb = static_cast<size_t>(std::max(1, std::stoi(value.scalar)));
+        } catch (const std::exception&) {
+            std::cerr << "Warning: Configuration line " << value.line
+                      << ": 'llm_cache_size_mb' must be a positive integer\n";
+        }
+    }
+    else if (key == "llm_requests_per_minute" || key == "llm_tokens_per_minute" ||
+             key == "llm_time_budget") {
+        int number = -1;
+        try {
+            number = std::stoi(value.scalar);
+        } catch (const std::exception&) {
+        }
+        if (number < 0) {
+            std::cerr << "Warning: Configuration line " << value.line << ": '" << key
+                      << "' must be a non-negative integer (0 means unlimited)\n";
+        } else if (key == "llm_requests_per_minute") {
+            config.llm_requests_per_minute = static_cast<size_t>(number);
+        } else if (key == "llm_tokens_per_minute") {
+            config.llm_tokens_per_minute = static_cast<size_t>(number);
+        } else {
+            config.llm_time_budget = number;
+        }
+    }
+    else if (key == "llm_batch_size" || key == "llm_concurrency" ||
+             key == "llm_max_retries" || key == "llm_timeout_ms") {
+        int number = 0;
+        try {
+            number = std::stoi(value.scalar);
+        } catch (const std::exception&) {
+            number = -1;
+        }
+        bool allow_zero = key == "llm_max_retries";
+        if (number < (allow_zero ? 0 : 1)) {
+            std::cerr << "Warning: Configuration line " << value.line << ": '" << key
+                      << "' must be a " << (allow_zero ? "non-negative" : "positive") << " integer\n";
+        } else if (key == "llm_batch_size") {
+            config.llm_batch_size = static_cast<size_t>(number);
+        } else if (key == "llm_concurrency") {
+            config.llm_concurrency = static_cast<size_t>(number);
+        } else if (key == "llm_max_retries") {
+            config.llm_max_retries = number;
+        } else {
+            config.llm_timeout_ms = number;
+        }
     }
 }
 
 /**
  * 从文件加载配置
- * 如果文件不存在,返回默认配置
+ * 如果文件不存在,返回默认配置; 语法错误时给出行号并使用默认配置
  * @param config_file 配置文件路径
  * @return 配置对象
  */
@@ -120,10 +293,29 @@ Config ConfigManager::loadConfig(const std::string& config_file) {
         return config;
     }
 
-    // 逐行读取并解析配置文件
-    std::string line;
-    while (std::getline(file, line)) {
-        parseLine(line, config);
+    std::ostringstream content;
+    content << file.rdbuf();
+
+    YamlNode root;
+    try {
+        root = YamlParser::parse(content.str());
+    } catch (const std::exception& e) {
+        std::cerr << "Warning: Invalid configuration " << config_file << " (" << e.what()
+                  << "), using defaults\n";
+        return getDefaultConfig();
+    }
+
+    if (root.isNull()) {
+        return config;
+    }
+    if (!root.isMapping()) {
+        std::cerr << "Warning: Configuration " << config_file
+                  << " must be a mapping of settings, using defaults\n";
+        return config;
+    }
+
+    for (const auto& entry : root.entries) {
+        applySetting(entry.first, entry.second, config);
     }
 
     return config;
@@ -8,9 +8,23 @@
 #include <string>
 #include <set>
 #include <map>
+#include <vector>
 
 namespace cpp_review {
 
+struct YamlNode;
+
+/**
+ * 按路径覆盖的规则设置
+ * 匹配 paths 中任一模式的文件使用此处的设置, 多条覆盖按出现顺序叠加
+ */
+struct RuleOverride {
+    std::vector<std::string> paths;                   // glob 模式
+    std::set<std::string> enabled_rules;              // 在这些路径上启用的规则
+    std::set<std::string> disabled_rules;             // 在这些路径上禁用的规则
+    std::map<std::string, std::string> severity;      // 在这些路径上的严重性覆盖
+};
+
 /**
  * 配置结构体
  * 存储所有用户可配置的选项
@@ -19,19 +33,46 @@ struct Config {
     // ===== 规则配置 =====
     std::set<std::string> disabled_rules;             // 禁用的规则 ID 列表
     std::map<std::string, std::string> rule_severity; // 规则严重性覆盖
+    std::vector<RuleOverride> overrides;              // 按路径覆盖的规则设置
+
+    // ===== 分析范围 =====
+    std::vector<std::string> include_paths;           // 只分析匹配的文件 (glob, 为空表示全部)
+    std::vector<std::string> exclude_paths;           // 排除匹配的文件 (glob)
+    bool scan_headers = false;                        // 目录扫描时是否把头文件作为独立翻译单元
+    bool use_gitignore = true;                        // 目录扫描时是否遵守 .gitignore
+    bool header_only = false;                         // 仅头文件库模式: 头文件分批合成伞形编译单元
+    size_t header_batch_size = 16;                    // 每个伞形编译单元包含的头文件数
+    std::vector<std::string> include_directories;     // 额外的头文件搜索目录 (-I)
 
     // ===== 输出选项 =====
     bool generate_html = false;                       // 是否生成 HTML 报告
     std::string html_output_file = "report.html";     // HTML 报告输出文件名
+    std::string html_output_dir = "";                 // 分片 HTML 报告目录 (非空时启用分片模式)
+    std::string baseline_file = "";                   // 已知问题基线文件 (可选)
 
     // ===== 分析选项 =====
     std::string cpp_standard = "c++17";               // C++ 标准版本
+    std::string cache_dir = "";                       // 结果缓存目录 (非空时启用, 按 git blob SHA 复用结果)
     bool verbose = false;                             // 详细输出模式
+    bool fast = false;                                // 快速模式: 只运行词法级规则 (无语义分析)
+    int metrics_port = 0;                             // 本机指标端点端口 (Prometheus 格式, 0 表示关闭)
 
     // ===== LLM 智能增强选项 (V2.0) =====
     bool enable_ai_suggestions = false;               // 启用 AI 建议
     std::string llm_provider = "rule-based";          // LLM 提供者: "rule-based", "openai", "none"
     std::string llm_api_key = "";                     // OpenAI 等外部提供者的 API 密钥
+    std::string llm_endpoint = "http://localhost:8080/v1/chat/completions";  // OpenAI 兼容接口地址
+    std::string llm_model = "gpt-4o-mini";            // 模型名称
+    size_t llm_batch_size = 8;                        // 每个请求合并的问题数
+    size_t llm_concurrency = 4;                       // 同时进行的请求数上限
+    int llm_max_retries = 3;                          // 请求失败后的重试次数
+    int llm_timeout_ms = 60000;                       // 单次请求超时 (毫秒)
+    bool llm_cluster = true;                          // 聚类相似问题, 每组只请求一次
+    bool llm_cache = true;                            // 在磁盘上缓存模型建议 (按规则 + 规范化片段)
+    size_t llm_cache_size_mb = 64;                    // 建议缓存大小上限 (MB, 超出按 LRU 淘汰)
+    size_t llm_requests_per_minute = 0;               // 每分钟请求数上限 (0 表示不限)
+    size_t llm_tokens_per_minute = 0;                 // 每分钟令牌数上限 (估计值, 0 表示不限)
+    int llm_time_budget = 0;                          // 从运行开始计的 AI 增强时间预算 (秒, 0 表示不限)
 };
 
 /**
@@ -57,8 +98,11 @@ private:
     // 去除字符串首尾空白
     static std::string trim(const std::string& str);
 
-    // 解析配置文件的单行
-    static void parseLine(const std::string& line, Config& config);
+    // 应用一个顶层配置项
+    static void applySetting(const std::string& key, const YamlNode& value, Config& config);
+
+    // 解析 overrides 列表中的一项
+    static RuleOverride parseOverride(const YamlNode& node);
 };
 
 } // namespace cpp_review
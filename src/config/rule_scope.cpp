@@ -0,0 +1,329 @@
+/*
+ * 路径范围规则配置实现
+ */
+
+#include "config/rule_scope.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+namespace cpp_review {
+
+namespace fs = std::filesystem;
+
+// ===== PathPatternSet 实现 =====
+
+PathPatternSet::PathPatternSet() : nodes_(1) {
+    // 工作目录只取一次: match() 在每个文件上调用, 不必每次查询 current_path
+    std::error_code ec;
+    base_dir_ = fs::current_path(ec);
+}
+
+std::string PathPatternSet::normalizePath(const std::string& path, const fs::path& base_dir) {
+    fs::path p = fs::path(path).lexically_normal();
+    if (p.is_absolute() && !base_dir.empty()) {
+        fs::path relative = p.lexically_relative(base_dir);
+        if (!relative.empty() && *relative.begin() != "..") {
+            p = relative;
+        }
+    }
+    std::string result = p.generic_string();
+    if (result.compare(0, 2, "./") == 0) {
+        result.erase(0, 2);
+    }
+    return result;
+}
+
+std::vector<std::string> PathPatternSet::split(const std::string& path) {
+    std::vector<std::string> segments;
+    size_t start = 0;
+    while (start <= path.size()) {
+        size_t slash = path.find('/', start);
+        if (slash == std::string::npos) slash = path.size();
+        std::string segment = path.substr(start, slash - start);
+        if (!segment.empty() && segment != ".") {
+            segments.push_back(std::move(segment));
+        }
+        start = slash + 1;
+    }
+    return segments;
+}
+
+bool PathPatternSet::hasWildcard(const std::string& segment) {
+    return segment.find_first_of("*?[") != std::string::npos;
+}
+
+size_t PathPatternSet::matchClass(const std::string& pattern, size_t start, char c, bool& matched) {
+    // start 指向 '['; 支持 "[abc]"、"[a-z]" 和取反的 "[!abc]" / "[^abc]"
+    size_t p = start + 1;
+    bool negate = p < pattern.size() && (pattern[p] == '!' || pattern[p] == '^');
+    if (negate) ++p;
+    bool found = false;
+    bool first = true;
+    for (; p < pattern.size(); first = false) {
+        // 紧跟在 '[' (或取反符号) 后的 ']' 是普通字符
+        if (pattern[p] == ']' && !first) {
+            matched = found != negate;
+            return p + 1;
+        }
+        // 按无符号比较: UTF-8 多字节字符的字节值大于 0x7F, 作为 char 比较时会变成负数
+        unsigned char low = static_cast<unsigned char>(pattern[p]);
+        unsigned char high = low;
+        if (p + 2 < pattern.size() && pattern[p + 1] == '-' && pattern[p + 2] != ']') {
+            high = static_cast<unsigned char>(pattern[p + 2]);
+            p += 3;
+        } else {
+            ++p;
+        }
+        unsigned char value = static_cast<unsigned char>(c);
+        if (low <= value && value <= high) found = true;
+    }
+    return std::string::npos;
+}
+
+bool PathPatternSet::matchSegment(const std::string& pattern, const std::string& text) {
+    // 迭代回溯: 记住最近一个 '*' 的位置
+    size_t p = 0, t = 0;
+    size_t star = std::string::npos, star_text = 0;
+    while (t < text.size()) {
+        if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            star_text = t;
+            continue;
+        }
+        size_t next = std::string::npos;
+        if (p < pattern.size()) {
+            if (pattern[p] == '[') {
+                // 未闭合的 '[' 按普通字符匹配
+                bool matched = false;
+                size_t end = matchClass(pattern, p, text[t], matched);
+                if (end == std::string::npos) {
+                    if (text[t] == '[') next = p + 1;
+                } else if (matched) {
+                    next = end;
+                }
+            } else if (pattern[p] == '?' || pattern[p] == text[t]) {
+                next = p + 1;
+            }
+        }
+        if (next != std::string::npos) {
+            p = next;
+            ++t;
+        } else if (star != std::string::npos) {
+            p = star + 1;
+            t = ++star_text;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') ++p;
+    return p == pattern.size();
+}
+
+bool PathPatternSet::matchSegments(const std::vector<std::string>& pattern, size_t pi,
+                                   const std::vector<std::string>& path, size_t si) {
+    // 模式用尽: 匹配到了目录 (或文件本身)
+    if (pi == pattern.size()) {
+        return true;
+    }
+    if (pattern[pi] == "**") {
+        for (size_t k = si; k <= path.size(); ++k) {
+            if (matchSegments(pattern, pi + 1, path, k)) return true;
+        }
+        return false;
+    }
+    if (si == path.size()) {
+        return false;
+    }
+    return matchSegment(pattern[pi], path[si]) && matchSegments(pattern, pi + 1, path, si + 1);
+}
+
+void PathPatternSet::add(const std::string& pattern, size_t id) {
+    std::string normalized = pattern;
+    if (normalized.compare(0, 2, "./") == 0) {
+        normalized.erase(0, 2);
+    }
+    // 不含 "/" 的模式匹配任意目录下的同名项
+    if (normalized.find('/') == std::string::npos) {
+        normalized = "**/" + normalized;
+    }
+
+    std::vector<std::string> segments = split(normalized);
+    if (segments.empty()) {
+        return;
+    }
+
+    // 不含通配符的前缀段进入前缀树
+    size_t node = 0;
+    size_t i = 0;
+    for (; i < segments.size() && !hasWildcard(segments[i]); ++i) {
+        auto& children = nodes_[node].children;
+        auto it = std::find_if(children.begin(), children.end(),
+                               [&](const auto& child) { return child.first == segments[i]; });
+        if (it != children.end()) {
+            node = it->second;
+        } else {
+            nodes_.emplace_back();
+            nodes_[node].children.emplace_back(segments[i], nodes_.size() - 1);
+            node = nodes_.size() - 1;
+        }
+    }
+
+    nodes_[node].patterns.push_back({std::vector<std::string>(segments.begin() + i, segments.end()), id});
+    ++pattern_count_;
+}
+
+std::vector<size_t> PathPatternSet::match(const std::string& path) const {
+    std::vector<size_t> result;
+    if (pattern_count_ == 0) {
+        return result;
+    }
+
+    std::vector<std::string> segments = split(normalizePath(path, base_dir_));
+
+    // 沿路径在前缀树中下行, 检查每个经过节点上的模式
+    size_t node = 0;
+    for (size_t depth = 0;; ++depth) {
+        for (const auto& pattern : nodes_[node].patterns) {
+            if (matchSegments(pattern.segments, 0, segments, depth)) {
+                result.push_back(pattern.id);
+            }
+        }
+        if (depth == segments.size()) break;
+
+        const auto& children = nodes_[node].children;
+        auto it = std::find_if(children.begin(), children.end(),
+                               [&](const auto& child) { return child.first == segments[depth]; });
+        if (it == children.end()) break;
+        node = it->second;
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+// ===== PathFilter 实现 =====
+
+PathFilter::PathFilter(const std::vector<std::string>& include, const std::vector<std::string>& exclude) {
+    for (const auto& pattern : include) include_.add(pattern, 0);
+    for (const auto& pattern : exclude) exclude_.add(pattern, 0);
+}
+
+bool PathFilter::accepts(const std::string& path) const {
+    if (!include_.empty() && !include_.matchesAny(path)) {
+        return false;
+    }
+    return !exclude_.matchesAny(path);
+}
+
+// ===== RuleScopes 实现 =====
+
+std::optional<Severity> RuleScopes::parseSeverity(const std::string& name) {
+    std::string upper = name;
+    std::transform(upper.begin(), upper.end(), upper.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    if (upper == "CRITICAL") return Severity::CRITICAL;
+    if (upper == "HIGH") return Severity::HIGH;
+    if (upper == "MEDIUM") return Severity::MEDIUM;
+    if (upper == "LOW") return Severity::LOW;
+    if (upper == "SUGGESTION") return Severity::SUGGESTION;
+    return std::nullopt;
+}
+
+int RuleScopes::ruleIndex(const std::string& rule_id) const {
+    auto it = std::find(rule_ids_.begin(), rule_ids_.end(), rule_id);
+    return it == rule_ids_.end() ? -1 : static_cast<int>(it - rule_ids_.begin());
+}
+
+std::shared_ptr<const RuleScopes> RuleScopes::compile(const Config& config,
+                                                      const std::vector<std::string>& rule_ids) {
+    if (rule_ids.size() > kMaxRules) {
+        throw std::runtime_error("too many rules for per-path rule scopes (max " +
+                                 std::to_string(kMaxRules) + ")");
+    }
+
+    auto scopes = std::make_shared<RuleScopes>();
+    scopes->rule_ids_ = rule_ids;
+
+    auto bit = [&](const std::string& rule_id) -> RuleMask {
+        int index = scopes->ruleIndex(rule_id);
+        return index < 0 ? 0 : RuleMask{1} << index;
+    };
+    auto applySeverities = [&](const std::map<std::string, std::string>& source,
+                               std::vector<std::optional<Severity>>& target) {
+        target.assign(rule_ids.size(), std::nullopt);
+        for (const auto& entry : source) {
+            int index = scopes->ruleIndex(entry.first);
+            auto severity = parseSeverity(entry.second);
+            if (!severity) {
+                std::cerr << "Warning: Unknown severity '" << entry.second
+                          << "' for rule " << entry.first << " in configuration\n";
+                continue;
+            }
+            if (index >= 0) target[index] = severity;
+        }
+    };
+
+    // 全局默认: 引擎中注册的规则除全局禁用的以外全部启用, 应用全局严重性覆盖
+    // (全局禁用的规则只有在某个路径覆盖中重新启用时才会被注册)
+    scopes->defaults_.enabled = rule_ids.size() == kMaxRules
+        ? ~RuleMask{0} : (RuleMask{1} << rule_ids.size()) - 1;
+    for (const auto& rule_id : config.disabled_rules) {
+        scopes->defaults_.enabled &= ~bit(rule_id);
+    }
+    applySeverities(config.rule_severity, scopes->defaults_.severity);
+
+    std::string signature;
+    for (const auto& rule_id : config.disabled_rules) {
+        signature += "-" + rule_id;
+    }
+    signature += "|";
+    for (const auto& entry : config.rule_severity) {
+        signature += entry.first + "=" + entry.second + ";";
+    }
+
+    for (size_t i = 0; i < config.overrides.size(); ++i) {
+        const RuleOverride& source = config.overrides[i];
+        Override compiled;
+        for (const auto& rule_id : source.enabled_rules) compiled.enable |= bit(rule_id);
+        for (const auto& rule_id : source.disabled_rules) compiled.disable |= bit(rule_id);
+        applySeverities(source.severity, compiled.severity);
+        scopes->overrides_.push_back(std::move(compiled));
+
+        signature += "|";
+        for (const auto& pattern : source.paths) {
+            scopes->patterns_.add(pattern, i);
+            signature += pattern + ",";
+        }
+        for (const auto& rule_id : source.enabled_rules) signature += "+" + rule_id;
+        for (const auto& rule_id : source.disabled_rules) signature += "-" + rule_id;
+        for (const auto& entry : source.severity) signature += entry.first + "=" + entry.second + ";";
+    }
+    scopes->signature_ = signature;
+
+    return scopes;
+}
+
+RuleSettings RuleScopes::resolve(const std::string& path) const {
+    RuleSettings settings = defaults_;
+    if (overrides_.empty()) {
+        return settings;
+    }
+
+    // 按配置顺序叠加, 后出现的覆盖优先
+    for (size_t index : patterns_.match(path)) {
+        const Override& override_settings = overrides_[index];
+        settings.enabled = (settings.enabled & ~override_settings.disable) | override_settings.enable;
+        for (size_t r = 0; r < override_settings.severity.size(); ++r) {
+            if (override_settings.severity[r]) {
+                settings.severity[r] = override_settings.severity[r];
+            }
+        }
+    }
+    return settings;
+}
+
+} // namespace cpp_review
@@ -0,0 +1,169 @@
+/*
+ * 路径范围规则配置头文件
+ * 将配置中的 include/exclude 与按路径覆盖的规则设置编译为路径前缀树,
+ * 分析时按文件路径 O(路径长度) 查询生效的规则集合与严重性
+ *
+ * 模式语法 (与 .gitignore 相近, 路径相对当前目录):
+ * - "*" 匹配一个路径段内的任意字符, "?" 匹配单个字符
+ * - "[abc]"、"[a-z]" 匹配字符集合中的单个字符, "[!abc]" (或 "[^abc]") 匹配集合外的字符
+ * - "**" 匹配任意多个路径段
+ * - 不含 "/" 的模式匹配任意目录下的同名文件或目录 (如 "*_test.cpp")
+ * - 匹配到目录即匹配其下所有文件 (如 "third_party")
+ */
+
+#pragma once
+
+#include "config/config.h"
+#include "report/reporter.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cpp_review {
+
+/**
+ * 已编译的路径模式集合
+ * 模式开头不含通配符的路径段存入前缀树, 查询时沿路径逐段下行,
+ * 只有挂在经过节点上的模式才需要做通配符匹配
+ */
+class PathPatternSet {
+public:
+    PathPatternSet();
+
+    /**
+     * 添加模式
+     * @param pattern glob 模式
+     * @param id 模式编号 (查询结果中返回)
+     */
+    void add(const std::string& pattern, size_t id);
+
+    /**
+     * 查询匹配路径的所有模式编号
+     * @param path 文件路径 (绝对路径按构造时的当前目录转为相对路径, 见 normalizePath)
+     * @return 匹配的模式编号 (升序)
+     */
+    std::vector<size_t> match(const std::string& path) const;
+
+    // 是否有任一模式匹配
+    bool matchesAny(const std::string& path) const { return !match(path).empty(); }
+
+    bool empty() const { return pattern_count_ == 0; }
+
+    /**
+     * 将路径规范化为相对 base_dir、以 "/" 分隔的形式 (base_dir 之外的绝对路径保持不变)
+     */
+    static std::string normalizePath(const std::string& path, const std::filesystem::path& base_dir);
+
+private:
+    struct Pattern {
+        std::vector<std::string> segments;   // 前缀之后的剩余路径段 (可含通配符)
+        size_t id;
+    };
+
+    struct Node {
+        std::vector<std::pair<std::string, size_t>> children;   // 路径段 -> 子节点
+        std::vector<Pattern> patterns;                          // 前缀在此结束的模式
+    };
+
+    static std::vector<std::string> split(const std::string& path);
+    static bool hasWildcard(const std::string& segment);
+    // 匹配 start 处的 "[...]" 字符类; 返回类之后的位置, 未闭合时返回 npos
+    static size_t matchClass(const std::string& pattern, size_t start, char c, bool& matched);
+    static bool matchSegment(const std::string& pattern, const std::string& text);
+    static bool matchSegments(const std::vector<std::string>& pattern, size_t pi,
+                              const std::vector<std::string>& path, size_t si);
+
+    std::vector<Node> nodes_;
+    size_t pattern_count_ = 0;
+    std::filesystem::path base_dir_;   // 构造时的当前目录
+};
+
+/**
+ * 文件范围过滤器 (配置中的 include / exclude)
+ */
+class PathFilter {
+public:
+    PathFilter() = default;
+    PathFilter(const std::vector<std::string>& include, const std::vector<std::string>& exclude);
+
+    /**
+     * 文件是否在分析范围内
+     * 设置了 include 时必须匹配其中之一, 且不能匹配任何 exclude
+     */
+    bool accepts(const std::string& path) const;
+
+private:
+    PathPatternSet include_;
+    PathPatternSet exclude_;
+};
+
+// 规则位掩码: 第 i 位对应规则引擎中第 i 个注册的规则
+using RuleMask = uint64_t;
+
+/**
+ * 某个路径上生效的规则设置
+ */
+struct RuleSettings {
+    RuleMask enabled = 0;                              // 启用的规则
+    std::vector<std::optional<Severity>> severity;     // 按规则序号的严重性覆盖
+};
+
+/**
+ * 已编译的按路径规则设置
+ * 编译后只读, 可被多个分析线程共享
+ */
+class RuleScopes {
+public:
+    // 规则掩码支持的最大规则数
+    static constexpr size_t kMaxRules = 64;
+
+    /**
+     * 编译配置
+     * @param config 配置 (rule_severity 为全局覆盖, overrides 按顺序叠加, 后者优先)
+     * @param rule_ids 规则引擎中的规则 ID (按注册顺序)
+     * @throws std::runtime_error 规则数超过 kMaxRules
+     */
+    static std::shared_ptr<const RuleScopes> compile(const Config& config,
+                                                     const std::vector<std::string>& rule_ids);
+
+    /**
+     * 查询路径上生效的规则设置
+     * @param path 文件路径 (绝对或相对当前目录)
+     */
+    RuleSettings resolve(const std::string& path) const;
+
+    /**
+     * 规则在掩码中的序号
+     * @return 未知规则返回 -1
+     */
+    int ruleIndex(const std::string& rule_id) const;
+
+    /**
+     * 影响分析结果的配置摘要 (用于结果缓存键)
+     */
+    const std::string& signature() const { return signature_; }
+
+    /**
+     * 解析严重性名称 (不区分大小写)
+     */
+    static std::optional<Severity> parseSeverity(const std::string& name);
+
+private:
+    // 一条路径覆盖
+    struct Override {
+        RuleMask enable = 0;
+        RuleMask disable = 0;
+        std::vector<std::optional<Severity>> severity;
+    };
+
+    std::vector<std::string> rule_ids_;
+    RuleSettings defaults_;               // 所有路径的默认设置
+    std::vector<Override> overrides_;     // 按配置顺序
+    PathPatternSet patterns_;             // 模式编号 = 覆盖序号
+    std::string signature_;
+};
+
+} // namespace cpp_review
@@ -0,0 +1,336 @@
+/*
+ * YAML 解析器实现
+ * 先按行切分并去掉注释, 再按缩进递归构建节点
+ */
+
+#include "config/yaml_parser.h"
+#include <stdexcept>
+
+namespace cpp_review {
+
+namespace {
+
+// 去掉注释后的一行
+struct Line {
+    int number;          // 源文件行号
+    size_t indent;       // 缩进列数
+    std::string text;    // 内容 (无缩进, 无行尾空白)
+};
+
+[[noreturn]] void fail(int line, const std::string& message) {
+    throw std::runtime_error("line " + std::to_string(line) + ": " + message);
+}
+
+// 去掉引号外的 # 注释 (# 前必须是行首或空白)
+std::string stripComment(const std::string& text) {
+    char quote = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        if (quote) {
+            if (c == '\\' && quote == '"') {
+                ++i;
+            } else if (c == quote) {
+                quote = 0;
+            }
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == '#' && (i == 0 || text[i - 1] == ' ' || text[i - 1] == '\t')) {
+            return text.substr(0, i);
+        }
+    }
+    return text;
+}
+
+std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return "";
+    size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+// 解析纯量 (去掉引号并处理双引号转义)
+std::string parseScalar(const std::string& text, int line) {
+    if (text.size() >= 2 && text.front() == '\'' && text.back() == '\'') {
+        std::string result;
+        for (size_t i = 1; i + 1 < text.size(); ++i) {
+            result += text[i];
+            if (text[i] == '\'' && text[i + 1] == '\'') ++i;   // '' 表示单引号
+        }
+        return result;
+    }
+    if (text.size() >= 2 && text.front() == '"' && text.back() == '"') {
+        std::string result;
+        for (size_t i = 1; i + 1 < text.size(); ++i) {
+            if (text[i] != '\\') {
+                result += text[i];
+                continue;
+            }
+            if (i + 2 >= text.size()) fail(line, "unterminated escape sequence");
+            switch (text[++i]) {
+                case 'n': result += '\n'; break;
+                case 't': result += '\t'; break;
+                case '\\': result += '\\'; break;
+                case '"': result += '"'; break;
+                default: result += text[i]; break;
+            }
+        }
+        return result;
+    }
+    if (!text.empty() && (text.front() == '"' || text.front() == '\'')) {
+        fail(line, "unterminated quoted string");
+    }
+    return text;
+}
+
+// 查找引号外的映射分隔符 ": " 或行尾的 ":"
+size_t findMappingColon(const std::string& text) {
+    char quote = 0;
+    int depth = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        if (quote) {
+            if (c == '\\' && quote == '"') {
+                ++i;
+            } else if (c == quote) {
+                quote = 0;
+            }
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == '[' || c == '{') {
+            ++depth;
+        } else if (c == ']' || c == '}') {
+            --depth;
+        } else if (c == ':' && depth == 0 && (i + 1 == text.size() || text[i + 1] == ' ')) {
+            return i;
+        }
+    }
+    return std::string::npos;
+}
+
+bool isSequenceItem(const std::string& text) {
+    return text == "-" || text.compare(0, 2, "- ") == 0;
+}
+
+// 解析单行中的值: 流序列、空流映射或纯量
+YamlNode parseInlineValue(const std::string& text, int line) {
+    YamlNode node;
+    node.line = line;
+
+    if (text.empty() || text == "~" || text == "null") {
+        return node;
+    }
+
+    if (text.front() == '[') {
+        if (text.back() != ']') fail(line, "unterminated flow sequence");
+        node.type = YamlNode::Type::Sequence;
+
+        std::string body = text.substr(1, text.size() - 2);
+        std::string current;
+        char quote = 0;
+        auto flush = [&]() {
+            std::string item = trim(current);
+            current.clear();
+            if (item.empty()) return;
+            YamlNode child;
+            child.type = YamlNode::Type::Scalar;
+            child.line = line;
+            child.scalar = parseScalar(item, line);
+            node.items.push_back(std::move(child));
+        };
+        for (size_t i = 0; i < body.size(); ++i) {
+            char c = body[i];
+            if (quote) {
+                if (c == '\\' && quote == '"' && i + 1 < body.size()) {
+                    current += c;
+                    c = body[++i];
+                } else if (c == quote) {
+                    quote = 0;
+                }
+            } else if (c == '"' || c == '\'') {
+                quote = c;
+            } else if (c == ',') {
+                flush();
+                continue;
+            } else if (c == '[' || c == '{') {
+                fail(line, "nested flow collections are not supported");
+            }
+            current += c;
+        }
+        if (quote) fail(line, "unterminated quoted string");
+        flush();
+        return node;
+    }
+
+    if (text.front() == '{') {
+        if (trim(text.substr(1, text.size() - 1)) != "}") {
+            fail(line, "flow mappings are not supported, use block mappings");
+        }
+        node.type = YamlNode::Type::Mapping;
+        return node;
+    }
+
+    node.type = YamlNode::Type::Scalar;
+    node.scalar = parseScalar(text, line);
+    return node;
+}
+
+/**
+ * 递归下降解析器
+ */
+class BlockParser {
+public:
+    explicit BlockParser(std::vector<Line> lines) : lines_(std::move(lines)) {}
+
+    YamlNode parseDocument() {
+        if (lines_.empty()) {
+            return YamlNode();
+        }
+        YamlNode root = parseBlock(lines_[0].indent);
+        if (pos_ < lines_.size()) {
+            fail(lines_[pos_].number, "unexpected indentation");
+        }
+        return root;
+    }
+
+private:
+    // 解析从当前行开始、缩进为 indent 的块
+    YamlNode parseBlock(size_t indent) {
+        return isSequenceItem(lines_[pos_].text) ? parseSequence(indent) : parseMapping(indent);
+    }
+
+    // 解析缩进大于 parent_indent 的子块; 没有子块时返回 Null
+    YamlNode parseChild(size_t parent_indent, int line) {
+        if (pos_ < lines_.size() && lines_[pos_].indent > parent_indent) {
+            return parseBlock(lines_[pos_].indent);
+        }
+        YamlNode node;
+        node.line = line;
+        return node;
+    }
+
+    YamlNode parseSequence(size_t indent) {
+        YamlNode node;
+        node.type = YamlNode::Type::Sequence;
+        node.line = lines_[pos_].number;
+
+        while (pos_ < lines_.size() && lines_[pos_].indent == indent &&
+               isSequenceItem(lines_[pos_].text)) {
+            Line& line = lines_[pos_];
+            std::string rest = line.text == "-" ? "" : trim(line.text.substr(2));
+
+            if (rest.empty()) {
+                ++pos_;
+                node.items.push_back(parseChild(indent, line.number));
+            } else if (isSequenceItem(rest) || findMappingColon(rest) != std::string::npos) {
+                // "- key: value" 或 "- - item": 把剩余部分当作缩进更深的一行重新解析
+                line.indent += line.text.size() - rest.size();
+                line.text = rest;
+                node.items.push_back(parseBlock(line.indent));
+            } else {
+                ++pos_;
+                node.items.push_back(parseInlineValue(rest, line.number));
+            }
+        }
+
+        if (pos_ < lines_.size() && lines_[pos_].indent > indent) {
+            fail(lines_[pos_].number, "unexpected indentation in sequence");
+        }
+        return node;
+    }
+
+    YamlNode parseMapping(size_t indent) {
+        YamlNode node;
+        node.type = YamlNode::Type::Mapping;
+        node.line = lines_[pos_].number;
+
+        while (pos_ < lines_.size() && lines_[pos_].indent == indent) {
+            const Line& line = lines_[pos_];
+            if (isSequenceItem(line.text)) {
+                fail(line.number, "sequence item where a mapping key was expected");
+            }
+
+            size_t colon = findMappingColon(line.text);
+            if (colon == std::string::npos) {
+                fail(line.number, "expected 'key: value'");
+            }
+            std::string key = parseScalar(trim(line.text.substr(0, colon)), line.number);
+            std::string value = trim(line.text.substr(colon + 1));
+            int number = line.number;
+            ++pos_;
+
+            if (node.get(key)) {
+                fail(number, "duplicate key '" + key + "'");
+            }
+
+            if (value.empty()) {
+                // 值在下一行: 子块, 或与键同缩进的序列 (YAML 允许)
+                if (pos_ < lines_.size() && lines_[pos_].indent == indent &&
+                    isSequenceItem(lines_[pos_].text)) {
+                    node.entries.emplace_back(key, parseSequence(indent));
+                } else {
+                    node.entries.emplace_back(key, parseChild(indent, number));
+                }
+            } else {
+                node.entries.emplace_back(key, parseInlineValue(value, number));
+            }
+        }
+
+        if (pos_ < lines_.size() && lines_[pos_].indent > indent) {
+            fail(lines_[pos_].number, "unexpected indentation in mapping");
+        }
+        return node;
+    }
+
+    std::vector<Line> lines_;
+    size_t pos_ = 0;
+};
+
+} // namespace
+
+const YamlNode* YamlNode::get(const std::string& key) const {
+    if (type != Type::Mapping) return nullptr;
+    for (const auto& entry : entries) {
+        if (entry.first == key) return &entry.second;
+    }
+    return nullptr;
+}
+
+std::vector<std::string> YamlNode::asStringList() const {
+    std::vector<std::string> result;
+    if (type == Type::Scalar) {
+        if (!scalar.empty()) result.push_back(scalar);
+    } else if (type == Type::Sequence) {
+        for (const auto& item : items) {
+            if (item.type == Type::Scalar) result.push_back(item.scalar);
+        }
+    }
+    return result;
+}
+
+YamlNode YamlParser::parse(const std::string& text) {
+    std::vector<Line> lines;
+    size_t start = 0;
+    int number = 0;
+    while (start <= text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) end = text.size();
+        std::string raw = text.substr(start, end - start);
+        start = end + 1;
+        ++number;
+
+        size_t first_char = raw.find_first_not_of(" \t\r");
+        if (first_char != std::string::npos && raw.find('\t') < first_char) {
+            fail(number, "tabs are not allowed in indentation");
+        }
+        std::string content = stripComment(raw);
+        size_t indent = content.find_first_not_of(' ');
+        if (indent == std::string::npos) continue;
+        std::string body = trim(content);
+        if (body.empty() || body == "---") continue;
+        lines.push_back({number, indent, body});
+    }
+
+    return BlockParser(std::move(lines)).parseDocument();
+}
+
+} // namespace cpp_review
@@ -0,0 +1,64 @@
+/*
+ * YAML 解析器头文件
+ * 支持配置文件需要的 YAML 子集, 不依赖第三方库
+ *
+ * 支持:
+ * - 块映射 (key: value) 与块序列 (- item), 任意嵌套
+ * - 序列项中的内联映射 (- paths: [...])
+ * - 流序列 [a, "b", 'c'] 与空流映射 {}
+ * - 纯量、单引号和双引号字符串, # 注释
+ * 不支持锚点/别名、多文档、多行纯量等高级特性
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cpp_review {
+
+/**
+ * YAML 节点
+ */
+struct YamlNode {
+    enum class Type { Null, Scalar, Sequence, Mapping };
+
+    Type type = Type::Null;
+    int line = 0;                                            // 源文件行号 (错误提示用)
+    std::string scalar;                                      // Scalar 的值
+    std::vector<YamlNode> items;                             // Sequence 的元素
+    std::vector<std::pair<std::string, YamlNode>> entries;   // Mapping 的键值 (保持原顺序)
+
+    bool isNull() const { return type == Type::Null; }
+    bool isScalar() const { return type == Type::Scalar; }
+    bool isSequence() const { return type == Type::Sequence; }
+    bool isMapping() const { return type == Type::Mapping; }
+
+    /**
+     * 查找映射中的键
+     * @return 不存在或不是映射时返回 nullptr
+     */
+    const YamlNode* get(const std::string& key) const;
+
+    /**
+     * 转换为字符串列表: 纯量视为单元素列表, 序列取其中的纯量
+     */
+    std::vector<std::string> asStringList() const;
+};
+
+/**
+ * YAML 解析器
+ */
+class YamlParser {
+public:
+    /**
+     * 解析 YAML 文本
+     * @param text 文件内容
+     * @return 根节点 (空文档为 Null)
+     * @throws std::runtime_error 语法错误 (消息包含行号)
+     */
+    static YamlNode parse(const std::string& text);
+};
+
+} // namespace cpp_review
@@ -0,0 +1,170 @@
+/*
+ * Git blame 归属模块实现
+ */
+
+#include "git/git_blame.h"
+#include "git/git_integration.h"
+#include "git/git_process.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+namespace cpp_review {
+
+namespace fs = std::filesystem;
+
+std::vector<std::pair<unsigned, unsigned>> GitBlame::toRanges(std::vector<unsigned> lines) {
+    std::sort(lines.begin(), lines.end());
+    lines.erase(std::unique(lines.begin(), lines.end()), lines.end());
+
+    std::vector<std::pair<unsigned, unsigned>> ranges;
+    for (unsigned line : lines) {
+        if (line == 0) continue;
+        if (!ranges.empty() && ranges.back().second + 1 == line) {
+            ranges.back().second = line;
+        } else {
+            ranges.emplace_back(line, line);
+        }
+    }
+    return ranges;
+}
+
+std::map<unsigned, BlameInfo> GitBlame::blameLines(const std::string& path,
+                                                    std::vector<unsigned> lines,
+                                                    const std::string& revision) {
+    std::map<unsigned, BlameInfo> result;
+
+    auto ranges = toRanges(std::move(lines));
+    if (ranges.empty()) {
+        return result;
+    }
+
+    std::vector<std::string> args = {"blame", "--incremental"};
+    for (const auto& range : ranges) {
+        args.push_back("-L");
+        args.push_back(std::to_string(range.first) + "," + std::to_string(range.second));
+    }
+    if (!revision.empty()) {
+        args.push_back(revision);
+    }
+    args.push_back("--");
+    args.push_back(path);
+
+    int exit_status = -1;
+    std::string output = GitProcess::run(args, &exit_status);
+    if (exit_status != 0) {
+        return result;
+    }
+
+    // 增量输出: 每组以 "<sha> <源行> <结果行> <行数>" 开头,
+    // 提交第一次出现时跟随 author / author-mail 等信息, 以 "filename" 行结束
+    std::unordered_map<std::string, std::string> names;
+    std::unordered_map<std::string, std::string> mails;
+    std::vector<std::pair<std::string, std::pair<unsigned, unsigned>>> groups;
+    std::string current;
+
+    std::istringstream iss(output);
+    std::string line;
+    while (std::getline(iss, line)) {
+        if (line.compare(0, 7, "author ") == 0) {
+            names[current] = line.substr(7);
+        } else if (line.compare(0, 12, "author-mail ") == 0) {
+            mails[current] = line.substr(12);
+        } else if (line.size() > 40 && line[40] == ' ' &&
+                   line.find_first_not_of("0123456789abcdef") >= 40) {
+            std::istringstream header(line);
+            std::string sha;
+            unsigned source_line = 0, final_line = 0, count = 0;
+            if (header >> sha >> source_line >> final_line >> count) {
+                current = sha;
+                groups.push_back({sha, {final_line, final_line + count - 1}});
+            }
+        }
+    }
+
+    for (const auto& group : groups) {
+        BlameInfo info;
+        info.commit = group.first;
+        info.author = names[group.first];
+        const std::string& mail = mails[group.first];
+        if (!mail.empty()) {
+            info.author += info.author.empty() ? mail : " " + mail;
+        }
+        for (const auto& range : ranges) {
+            unsigned first = std::max(range.first, group.second.first);
+            unsigned last = std::min(range.second, group.second.second);
+            for (unsigned l = first; l <= last && first <= last; ++l) {
+                result[l] = info;
+            }
+        }
+    }
+
+    return result;
+}
+
+void GitBlame::annotate(std::vector<Issue>& issues, const std::string& revision, unsigned jobs) {
+    std::string root = GitIntegration::getRepositoryRoot();
+    if (root.empty()) {
+        return;
+    }
+
+    // 按文件分组 (只处理仓库内的文件)
+    std::map<std::string, std::vector<size_t>> by_file;
+    for (size_t i = 0; i < issues.size(); ++i) {
+        if (issues[i].line == 0) continue;
+        std::error_code ec;
+        fs::path absolute = fs::absolute(issues[i].file_path, ec).lexically_normal();
+        if (ec) continue;
+        fs::path relative = absolute.lexically_relative(root);
+        if (relative.empty() || *relative.begin() == "..") continue;
+        by_file[relative.generic_string()].push_back(i);
+    }
+    if (by_file.empty()) {
+        return;
+    }
+
+    std::vector<const std::pair<const std::string, std::vector<size_t>>*> files;
+    for (const auto& entry : by_file) {
+        files.push_back(&entry);
+    }
+
+    if (jobs == 0) {
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+    jobs = std::min<unsigned>(jobs, static_cast<unsigned>(files.size()));
+
+    // 各线程领取不同的文件, 只写入各自文件对应的问题, 无需加锁
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t f = next++; f < files.size(); f = next++) {
+            const auto& entry = *files[f];
+            std::vector<unsigned> lines;
+            for (size_t index : entry.second) {
+                lines.push_back(issues[index].line);
+            }
+
+            auto blame = blameLines((fs::path(root) / entry.first).string(), std::move(lines), revision);
+            for (size_t index : entry.second) {
+                auto it = blame.find(issues[index].line);
+                if (it != blame.end()) {
+                    issues[index].blame_commit = it->second.commit;
+                    issues[index].blame_author = it->second.author;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < jobs; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace cpp_review
@@ -0,0 +1,61 @@
+/*
+ * Git blame 归属模块头文件
+ * 为报告中的问题批量标注最后修改该行的作者和提交
+ *
+ * 设计要点:
+ * - 按文件分组, 每个文件只启动一次 "git blame --incremental",
+ *   并用多个 -L 只计算有问题的行
+ * - 不同文件的 blame 在多个线程中并行执行
+ * - 同一提交的作者信息在增量输出中只出现一次, 解析时按提交缓存
+ */
+
+#pragma once
+
+#include "report/reporter.h"
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cpp_review {
+
+/**
+ * 一行代码的归属信息
+ */
+struct BlameInfo {
+    std::string commit;   // 提交 SHA
+    std::string author;   // 作者 ("Name <email>")
+};
+
+/**
+ * Git blame 批量归属
+ */
+class GitBlame {
+public:
+    /**
+     * 为问题填充 blame_author / blame_commit
+     * 仓库外的文件 (系统头文件等) 和无法 blame 的文件保持为空
+     * @param issues 问题列表 (原地更新)
+     * @param revision 从该提交开始 blame; 为空表示工作区 (未提交的行标注为未提交)
+     * @param jobs 并行线程数; 0 表示使用硬件线程数
+     */
+    static void annotate(std::vector<Issue>& issues, const std::string& revision = "",
+                         unsigned jobs = 0);
+
+    /**
+     * 对单个文件的指定行执行一次增量 blame
+     * @param path 文件路径
+     * @param lines 行号列表 (可无序、可重复)
+     * @param revision 起始提交 (可为空)
+     * @return 行号 -> 归属信息
+     */
+    static std::map<unsigned, BlameInfo> blameLines(const std::string& path,
+                                                     std::vector<unsigned> lines,
+                                                     const std::string& revision = "");
+
+private:
+    // 将行号合并为连续区间 [first, last]
+    static std::vector<std::pair<unsigned, unsigned>> toRanges(std::vector<unsigned> lines);
+};
+
+} // namespace cpp_review
@@ -4,12 +4,12 @@
  */
 
 #include "git/git_integration.h"
+#include "git/git_process.h"
 #include <cstdlib>
-#include <array>
-#include <memory>
 #include <sstream>
 #include <algorithm>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
 
 namespace cpp_review {
@@ -19,29 +19,209 @@ namespace fs = std::filesystem;
 /**
  * 执行 Git 命令并返回输出
  */
-std::string GitIntegration::executeGitCommand(const std::string& command) {
-    std::array<char, 128> buffer;
-    std::string result;
+std::string GitIntegration::executeGitCommand(const std::vector<std::string>& args) {
+    std::string result = GitProcess::run(args);
 
-    // 使用 popen 执行命令
-    std::unique_ptr<FILE, decltype(&pclose)> pipe(
-        popen(command.c_str(), "r"), pclose
-    );
+    // 去除首尾空白
+    result.erase(0, result.find_first_not_of(" \t\n\r"));
+    result.erase(result.find_last_not_of(" \t\n\r") + 1);
+
+    return result;
+}
+
+/**
+ * 获取 Git 目录信息
+ * 一次 rev-parse 同时得到工作树目录和共享目录, 之后的引用查询都直接读文件
+ */
+const GitIntegration::GitDirs& GitIntegration::gitDirs() {
+    static const GitDirs dirs = [] {
+        GitDirs result;
+        std::istringstream iss(executeGitCommand({"rev-parse", "--git-dir", "--git-common-dir"}));
+        std::getline(iss, result.git_dir);
+        std::getline(iss, result.common_dir);
+        if (result.common_dir.empty()) {
+            result.common_dir = result.git_dir;
+        }
+        return result;
+    }();
+    return dirs;
+}
 
-    if (!pipe) {
-        return "";
+/**
+ * 检查引用是否存在
+ */
+bool GitIntegration::refExists(const std::string& ref) {
+    const auto& dirs = gitDirs();
+    if (dirs.common_dir.empty()) {
+        return false;
     }
 
-    // 读取命令输出
-    while (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr) {
-        result += buffer.data();
+    // 松散引用
+    std::error_code ec;
+    if (fs::is_regular_file(fs::path(dirs.common_dir) / ref, ec)) {
+        return true;
     }
 
-    // 去除首尾空白
-    result.erase(0, result.find_first_not_of(" \t\n\r"));
-    result.erase(result.find_last_not_of(" \t\n\r") + 1);
+    // 打包引用: "<sha> <ref>" 每行一条
+    std::ifstream packed(fs::path(dirs.common_dir) / "packed-refs");
+    std::string line;
+    while (std::getline(packed, line)) {
+        if (line.empty() || line[0] == '#' || line[0] == '^') continue;
+        size_t space = line.find(' ');
+        if (space != std::string::npos && line.compare(space + 1, std::string::npos, ref) == 0) {
+            return true;
+        }
+    }
 
-    return result;
+    return false;
+}
+
+/**
+ * 获取仓库工作树根目录
+ */
+std::string GitIntegration::getRepositoryRoot() {
+    static const std::string root = executeGitCommand({"rev-parse", "--show-toplevel"});
+    return root;
+}
+
+/**
+ * 解析提交 SHA
+ */
+std::optional<std::string> GitIntegration::resolveCommit(const std::string& revision) {
+    if (revision.empty() || revision[0] == '-') {
+        return std::nullopt;
+    }
+
+    int exit_status = -1;
+    std::string sha = GitProcess::run({"rev-parse", "--verify", "--quiet", revision + "^{commit}"},
+                                      &exit_status);
+    sha.erase(sha.find_last_not_of(" \t\n\r") + 1);
+    if (exit_status != 0 || sha.empty()) {
+        return std::nullopt;
+    }
+    return sha;
+}
+
+/**
+ * 计算 merge-base
+ */
+std::optional<std::string> GitIntegration::getMergeBase(const std::string& base_branch) {
+    if (base_branch.empty() || base_branch[0] == '-') {
+        return std::nullopt;
+    }
+
+    for (const std::string& ref : {base_branch, "origin/" + base_branch}) {
+        int exit_status = -1;
+        std::string sha = GitProcess::run({"merge-base", ref, "HEAD"}, &exit_status);
+        sha.erase(sha.find_last_not_of(" \t\n\r") + 1);
+        if (exit_status == 0 && !sha.empty()) {
+            return sha;
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * 列出提交中的 C++ 源文件
+ */
+std::vector<std::string> GitIntegration::listRevisionFiles(
+    const std::string& commit,
+    const std::vector<std::string>& paths
+) {
+    // ls-tree 输出相对当前目录的路径, 与工作区中的用法一致
+    std::vector<std::string> args = {"ls-tree", "-r", "--name-only", commit, "--"};
+    args.insert(args.end(), paths.begin(), paths.end());
+
+    std::istringstream iss(GitProcess::run(args));
+    std::vector<std::string> files;
+    std::string file;
+    while (std::getline(iss, file)) {
+        if (!file.empty() && isCppFile(file)) {
+            files.push_back(file);
+        }
+    }
+    return files;
+}
+
+/**
+ * 获取文件 blob SHA 索引
+ */
+BlobIndex GitIntegration::getBlobIndex(const std::string& commit) {
+    BlobIndex index;
+
+    // 以 NUL 分隔的记录逐条处理
+    auto forEachRecord = [](const std::string& output, auto&& handler) {
+        size_t start = 0;
+        while (start < output.size()) {
+            size_t end = output.find('\0', start);
+            if (end == std::string::npos) end = output.size();
+            if (end > start) handler(output.substr(start, end - start));
+            start = end + 1;
+        }
+    };
+
+    if (!commit.empty()) {
+        // "<mode> blob <sha>\t<path>"
+        forEachRecord(GitProcess::run({"ls-tree", "-r", "-z", "--full-tree", commit}),
+                      [&index](const std::string& record) {
+            size_t tab = record.find('\t');
+            size_t first = record.find(' ');
+            size_t second = record.find(' ', first + 1);
+            if (tab == std::string::npos || second == std::string::npos || second > tab) return;
+            if (record.compare(first + 1, second - first - 1, "blob") != 0) return;
+            index[record.substr(tab + 1)] = record.substr(second + 1, tab - second - 1);
+        });
+        return index;
+    }
+
+    // "<mode> <sha> <stage>\t<path>", 路径相对仓库根目录
+    forEachRecord(GitProcess::run({"ls-files", "-s", "-z", "--full-name", "--", ":/"}),
+                  [&index](const std::string& record) {
+        size_t tab = record.find('\t');
+        size_t first = record.find(' ');
+        size_t second = record.find(' ', first + 1);
+        if (tab == std::string::npos || second == std::string::npos || second > tab) return;
+        index[record.substr(tab + 1)] = record.substr(first + 1, second - first - 1);
+    });
+
+    // 工作区与索引不一致的文件 (diff-files 基于 stat 缓存, 开销很小)
+    std::string root = getRepositoryRoot();
+    std::vector<std::string> dirty;
+    forEachRecord(GitProcess::run({"diff-files", "--name-only", "-z"}),
+                  [&](const std::string& path) {
+        std::error_code ec;
+        if (fs::is_regular_file(fs::path(root) / path, ec)) {
+            dirty.push_back(path);
+        } else {
+            index.erase(path);   // 已删除
+        }
+    });
+
+    if (!dirty.empty()) {
+        std::vector<std::string> args = {"hash-object", "--"};
+        for (const auto& path : dirty) {
+            args.push_back((fs::path(root) / path).string());
+        }
+        std::istringstream iss(GitProcess::run(args));
+        std::string sha;
+        for (const auto& path : dirty) {
+            if (!std::getline(iss, sha) || sha.empty()) {
+                index.erase(path);
+                continue;
+            }
+            index[path] = sha;
+        }
+    }
+
+    return index;
+}
+
+/**
+ * 获取共享的对象读取进程
+ */
+GitObjectReader& GitIntegration::objectReader() {
+    static GitObjectReader reader;
+    return reader;
 }
 
 /**
@@ -59,40 +239,51 @@ std::optional<std::string> GitIntegration::getEnvVar(const std::string& var_name
  * 检查当前目录是否为 Git 仓库
  */
 bool GitIntegration::isGitRepository() {
-    std::string result = executeGitCommand("git rev-parse --git-dir 2>/dev/null");
-    return !result.empty();
+    return !gitDirs().git_dir.empty();
 }
 
 /**
  * 获取当前分支名称
  */
 std::string GitIntegration::getCurrentBranch() {
-    return executeGitCommand("git rev-parse --abbrev-ref HEAD");
+    // 直接读取 HEAD: "ref: refs/heads/<branch>", 分离状态下为提交 SHA
+    std::ifstream head(fs::path(gitDirs().git_dir) / "HEAD");
+    std::string line;
+    if (!head || !std::getline(head, line)) {
+        return executeGitCommand({"rev-parse", "--abbrev-ref", "HEAD"});
+    }
+
+    const std::string prefix = "ref: refs/heads/";
+    if (line.compare(0, prefix.size(), prefix) == 0) {
+        std::string branch = line.substr(prefix.size());
+        branch.erase(branch.find_last_not_of(" \t\r") + 1);
+        return branch;
+    }
+
+    return "HEAD";
 }
 
 /**
  * 获取默认主分支名称
  */
 std::string GitIntegration::getDefaultBranch() {
-    // 尝试 main
-    std::string result = executeGitCommand("git rev-parse --verify main 2>/dev/null");
-    if (!result.empty()) {
+    // 尝试 main / master (直接读取 refs 与 packed-refs, 不启动进程)
+    if (refExists("refs/heads/main")) {
         return "main";
     }
-
-    // 尝试 master
-    result = executeGitCommand("git rev-parse --verify master 2>/dev/null");
-    if (!result.empty()) {
+    if (refExists("refs/heads/master")) {
         return "master";
     }
 
-    // 尝试从远程获取默认分支
-    result = executeGitCommand("git symbolic-ref refs/remotes/origin/HEAD 2>/dev/null");
-    if (!result.empty()) {
+    // 尝试从远程默认分支获取: "ref: refs/remotes/origin/<branch>"
+    std::ifstream origin_head(fs::path(gitDirs().common_dir) / "refs/remotes/origin/HEAD");
+    std::string line;
+    if (origin_head && std::getline(origin_head, line)) {
+        line.erase(line.find_last_not_of(" \t\r") + 1);
         // 提取分支名 (refs/remotes/origin/main -> main)
-        size_t pos = result.find_last_of('/');
-        if (pos != std::string::npos) {
-            return result.substr(pos + 1);
+        size_t pos = line.find_last_of('/');
+        if (line.compare(0, 5, "ref: ") == 0 && pos != std::string::npos) {
+            return line.substr(pos + 1);
         }
     }
 
@@ -136,47 +327,45 @@ std::vector<std::string> GitIntegration::getChangedFiles(
     IncrementalMode mode,
     const std::string& reference
 ) {
-    std::string git_command;
+    std::vector<std::string> git_args = {"diff", "--name-only"};
 
     switch (mode) {
         case IncrementalMode::WORKSPACE:
             // 工作区未提交的更改
-            git_command = "git diff --name-only";
             break;
 
         case IncrementalMode::STAGED:
             // 暂存区的更改
-            git_command = "git diff --cached --name-only";
+            git_args.push_back("--cached");
             break;
 
         case IncrementalMode::BRANCH: {
             // 与指定分支的差异
             std::string base_branch = reference.empty() ? getDefaultBranch() : reference;
-            git_command = "git diff --name-only " + base_branch + "...HEAD";
+            git_args.push_back(base_branch + "...HEAD");
             break;
         }
 
         case IncrementalMode::COMMIT:
             // 从指定提交以来的更改
-            git_command = "git diff --name-only " + reference + "..HEAD";
+            git_args.push_back(reference + "..HEAD");
             break;
 
         case IncrementalMode::PR: {
             // PR 模式: 自动检测 base 分支
             auto pr_env = detectPREnvironment();
             if (pr_env) {
-                git_command = "git diff --name-only " + pr_env->base_branch + "...HEAD";
+                git_args.push_back(pr_env->base_branch + "...HEAD");
             } else {
                 // 如果不在 PR 环境,使用默认分支
-                std::string base_branch = getDefaultBranch();
-                git_command = "git diff --name-only " + base_branch + "...HEAD";
+                git_args.push_back(getDefaultBranch() + "...HEAD");
             }
             break;
         }
     }
 
     // 执行 Git 命令
-    std::string output = executeGitCommand(git_command);
+    std::string output = executeGitCommand(git_args);
 
     // 解析输出为文件列表
     std::vector<std::string> files;
@@ -197,6 +386,15 @@ std::vector<std::string> GitIntegration::getChangedFiles(
  * 检测 PR 环境
  */
 std::optional<PREnvironment> GitIntegration::detectPREnvironment() {
+    // 环境变量在进程生命周期内不变, 只检测一次
+    static const std::optional<PREnvironment> cached = detectPREnvironmentFromEnv();
+    return cached;
+}
+
+/**
+ * 从 CI 环境变量解析 PR 信息
+ */
+std::optional<PREnvironment> GitIntegration::detectPREnvironmentFromEnv() {
     PREnvironment env;
     env.is_pr_environment = false;
 
@@ -14,9 +14,12 @@
 #include <string>
 #include <vector>
 #include <optional>
+#include <unordered_map>
 
 namespace cpp_review {
 
+class GitObjectReader;
+
 /**
  * 增量分析模式
  */
@@ -41,6 +44,11 @@ struct PREnvironment {
     bool is_pr_environment;      // 是否在 PR 环境中
 };
 
+/**
+ * 文件内容索引: 仓库相对路径 -> blob SHA
+ */
+using BlobIndex = std::unordered_map<std::string, std::string>;
+
 /**
  * Git 集成类
  * 提供 Git 相关的实用功能
@@ -102,13 +110,75 @@ public:
         const PREnvironment& pr_env
     );
 
+    /**
+     * 获取仓库工作树根目录 (绝对路径, 只查询一次)
+     * @return 不在仓库中时返回空字符串
+     */
+    static std::string getRepositoryRoot();
+
+    /**
+     * 将 revision 表达式解析为完整的提交 SHA
+     * @param revision 分支名 / 标签 / 短 SHA 等
+     * @return 无法解析为提交时返回 std::nullopt
+     */
+    static std::optional<std::string> resolveCommit(const std::string& revision);
+
+    /**
+     * 计算 HEAD 与基础分支的 merge-base
+     * 基础分支在本地不存在时 (CI 的浅检出常见) 尝试 origin/<branch>
+     * @param base_branch 基础分支名
+     * @return merge-base 提交 SHA
+     */
+    static std::optional<std::string> getMergeBase(const std::string& base_branch);
+
+    /**
+     * 列出提交中指定路径下的 C++ 源文件 (不要求文件存在于工作区)
+     * @param commit 提交 SHA
+     * @param paths 文件或目录路径 (相对当前目录); 为空时列出当前目录下的全部文件
+     * @return 相对当前目录的文件路径列表
+     */
+    static std::vector<std::string> listRevisionFiles(
+        const std::string& commit,
+        const std::vector<std::string>& paths
+    );
+
+    /**
+     * 获取仓库内所有文件的 blob SHA
+     * 工作区模式直接使用索引中记录的 SHA (git ls-files -s), 只有工作区中
+     * 已修改的文件才需要重新计算哈希; 提交模式读取提交的完整文件树
+     * @param commit 提交 SHA; 为空表示当前工作区
+     * @return 仓库相对路径 -> blob SHA (未跟踪的文件不在其中)
+     */
+    static BlobIndex getBlobIndex(const std::string& commit = "");
+
+    /**
+     * 获取共享的对象读取进程 (git cat-file --batch)
+     * 进程在第一次读取时启动, 程序退出时关闭
+     */
+    static GitObjectReader& objectReader();
+
 private:
     /**
      * 执行 Git 命令并返回输出
-     * @param command Git 命令
+     * @param args Git 参数 (不含 "git", 不经过 shell)
      * @return 命令输出 (去除首尾空白)
      */
-    static std::string executeGitCommand(const std::string& command);
+    static std::string executeGitCommand(const std::vector<std::string>& args);
+
+    /**
+     * Git 目录信息 (只查询一次)
+     */
+    struct GitDirs {
+        std::string git_dir;      // 当前工作树的 .git 目录 (HEAD 所在)
+        std::string common_dir;   // 共享目录 (refs / packed-refs 所在)
+    };
+    static const GitDirs& gitDirs();
+
+    /**
+     * 直接从 refs 目录或 packed-refs 检查引用是否存在
+     * @param ref 完整引用名, 例如 "refs/heads/main"
+     */
+    static bool refExists(const std::string& ref);
 
     /**
      * 检查文件是否为 C++ 源文件
@@ -123,6 +193,11 @@ private:
      * @return 环境变量值 (如果存在)
      */
     static std::optional<std::string> getEnvVar(const std::string& var_name);
+
+    /**
+     * 从 CI 环境变量解析 PR 信息 (detectPREnvironment 缓存其结果)
+     */
+    static std::optional<PREnvironment> detectPREnvironmentFromEnv();
 };
 
 } // namespace cpp_review
@@ -0,0 +1,268 @@
+/*
+ * Git 进程访问层实现
+ */
+
+#include "git/git_process.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace cpp_review {
+
+namespace {
+
+/**
+ * 启动 git 子进程
+ * @param args git 参数
+ * @param stdin_fd 子进程标准输入 (-1 表示继承)
+ * @param stdout_fd 子进程标准输出
+ * 管道均以 O_CLOEXEC 创建: dup2 到标准输入输出的一端会清除该标志,
+ * 其余管道端 (包括其他线程同时创建的管道) 不会泄漏到任何子进程中
+ * @return 子进程 ID, 失败返回 -1
+ */
+pid_t spawnGit(const std::vector<std::string>& args, int stdin_fd, int stdout_fd) {
+    std::vector<char*> argv;
+    argv.reserve(args.size() + 2);
+    argv.push_back(const_cast<char*>("git"));
+    for (const auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    if (stdin_fd >= 0) {
+        posix_spawn_file_actions_adddup2(&actions, stdin_fd, STDIN_FILENO);
+    }
+    posix_spawn_file_actions_adddup2(&actions, stdout_fd, STDOUT_FILENO);
+    posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+    pid_t pid = -1;
+    int rc = posix_spawnp(&pid, "git", &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+
+    return rc == 0 ? pid : -1;
+}
+
+// 等待子进程结束并返回退出码
+int waitForExit(pid_t pid) {
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) return -1;
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+} // namespace
+
+// ===== GitProcess 实现 =====
+
+std::string GitProcess::run(const std::vector<std::string>& args, int* exit_status) {
+    if (exit_status) *exit_status = -1;
+
+    int pipe_fds[2];
+    if (pipe2(pipe_fds, O_CLOEXEC) != 0) {
+        return "";
+    }
+
+    pid_t pid = spawnGit(args, -1, pipe_fds[1]);
+    close(pipe_fds[1]);
+    if (pid < 0) {
+        close(pipe_fds[0]);
+        return "";
+    }
+
+    // 大缓冲区读取全部输出
+    std::string output;
+    std::vector<char> buffer(kReadBufferSize);
+    while (true) {
+        ssize_t n = read(pipe_fds[0], buffer.data(), buffer.size());
+        if (n > 0) {
+            output.append(buffer.data(), static_cast<size_t>(n));
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            break;
+        }
+    }
+    close(pipe_fds[0]);
+
+    int status = waitForExit(pid);
+    if (exit_status) *exit_status = status;
+
+    return output;
+}
+
+// ===== GitObjectReader 实现 =====
+
+GitObjectReader::~GitObjectReader() {
+    stop();
+}
+
+bool GitObjectReader::start() {
+    int request_pipe[2];
+    int response_pipe[2];
+    if (pipe2(request_pipe, O_CLOEXEC) != 0) {
+        return false;
+    }
+    if (pipe2(response_pipe, O_CLOEXEC) != 0) {
+        close(request_pipe[0]);
+        close(request_pipe[1]);
+        return false;
+    }
+
+    // git 进程意外退出时写管道不应终止整个程序
+    std::signal(SIGPIPE, SIG_IGN);
+
+    pid_ = spawnGit({"cat-file", "--batch"}, request_pipe[0], response_pipe[1]);
+    close(request_pipe[0]);
+    close(response_pipe[1]);
+
+    if (pid_ < 0) {
+        close(request_pipe[1]);
+        close(response_pipe[0]);
+        return false;
+    }
+
+    to_git_ = request_pipe[1];
+    from_git_ = response_pipe[0];
+    buffer_.resize(GitProcess::kReadBufferSize);
+    buffer_pos_ = buffer_end_ = 0;
+    return true;
+}
+
+void GitObjectReader::stop() {
+    if (pid_ < 0) return;
+
+    // 关闭标准输入后 cat-file 会自行退出
+    close(to_git_);
+    close(from_git_);
+    waitForExit(pid_);
+
+    pid_ = -1;
+    to_git_ = from_git_ = -1;
+}
+
+bool GitObjectReader::readLine(std::string& line) {
+    line.clear();
+    while (true) {
+        for (size_t i = buffer_pos_; i < buffer_end_; ++i) {
+            if (buffer_[i] == '\n') {
+                line.append(buffer_.data() + buffer_pos_, i - buffer_pos_);
+                buffer_pos_ = i + 1;
+                return true;
+            }
+        }
+        line.append(buffer_.data() + buffer_pos_, buffer_end_ - buffer_pos_);
+        buffer_pos_ = buffer_end_ = 0;
+
+        ssize_t n = ::read(from_git_, buffer_.data(), buffer_.size());
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        buffer_end_ = static_cast<size_t>(n);
+    }
+}
+
+bool GitObjectReader::readBytes(size_t count, std::string& out) {
+    out.clear();
+    out.reserve(count);
+    while (out.size() < count) {
+        if (buffer_pos_ == buffer_end_) {
+            buffer_pos_ = buffer_end_ = 0;
+            ssize_t n = ::read(from_git_, buffer_.data(), buffer_.size());
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            buffer_end_ = static_cast<size_t>(n);
+        }
+        size_t take = std::min(count - out.size(), buffer_end_ - buffer_pos_);
+        out.append(buffer_.data() + buffer_pos_, take);
+        buffer_pos_ += take;
+    }
+    return true;
+}
+
+std::optional<GitObject> GitObjectReader::read(const std::string& name) {
+    // 对象名中的换行会破坏批量协议
+    if (name.empty() || name.find('\n') != std::string::npos) {
+        return std::nullopt;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (pid_ < 0) {
+        if (failed_ || !start()) {
+            failed_ = true;
+            return std::nullopt;
+        }
+    }
+
+    // 发送请求
+    std::string request = name + "\n";
+    const char* data = request.data();
+    size_t remaining = request.size();
+    while (remaining > 0) {
+        ssize_t n = ::write(to_git_, data, remaining);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            stop();
+            failed_ = true;
+            return std::nullopt;
+        }
+        data += n;
+        remaining -= static_cast<size_t>(n);
+    }
+
+    // 响应头: "<sha> <type> <size>" 或 "<name> missing"
+    std::string header;
+    if (!readLine(header)) {
+        stop();
+        failed_ = true;
+        return std::nullopt;
+    }
+
+    auto endsWith = [&header](const std::string& suffix) {
+        return header.size() >= suffix.size() &&
+               header.compare(header.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    if (endsWith(" missing") || endsWith(" ambiguous")) {
+        return std::nullopt;
+    }
+
+    size_t first_space = header.find(' ');
+    size_t last_space = header.rfind(' ');
+    if (first_space == std::string::npos || first_space == last_space) {
+        return std::nullopt;
+    }
+
+    GitObject object;
+    object.sha = header.substr(0, first_space);
+    object.type = header.substr(first_space + 1, last_space - first_space - 1);
+
+    size_t size = 0;
+    try {
+        size = std::stoull(header.substr(last_space + 1));
+    } catch (const std::exception&) {
+        stop();
+        failed_ = true;
+        return std::nullopt;
+    }
+
+    // 内容后跟一个换行
+    std::string trailing;
+    if (!readBytes(size, object.content) || !readBytes(1, trailing)) {
+        stop();
+        failed_ = true;
+        return std::nullopt;
+    }
+
+    return object;
+}
+
+} // namespace cpp_review
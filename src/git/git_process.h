@@ -0,0 +1,87 @@
+/*
+ * Git 进程访问层头文件
+ * 不经过 shell 直接启动 git, 并提供长驻的 cat-file 批量对象读取进程
+ *
+ * 设计要点:
+ * - 命令参数以数组形式传递, 无需 shell 转义, 也不会 fork 额外的 sh 进程
+ * - 使用 64KB 缓冲区读取输出
+ * - 对象读取复用同一个 "git cat-file --batch" 进程, 每次查询只是一次管道往返
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cpp_review {
+
+/**
+ * 一次性 git 命令执行器
+ */
+class GitProcess {
+public:
+    /**
+     * 执行 git 命令并返回标准输出 (标准错误被丢弃)
+     * @param args git 子命令及参数 (不含 "git" 本身)
+     * @param exit_status 可选: 返回进程退出码 (无法启动或异常退出时为 -1)
+     * @return 命令的完整标准输出 (不做裁剪)
+     */
+    static std::string run(const std::vector<std::string>& args, int* exit_status = nullptr);
+
+    // 读取缓冲区大小
+    static constexpr size_t kReadBufferSize = 64 * 1024;
+};
+
+/**
+ * 从 git 对象库读取到的对象
+ */
+struct GitObject {
+    std::string sha;       // 对象 ID
+    std::string type;      // blob / tree / commit / tag
+    std::string content;   // 对象内容
+};
+
+/**
+ * 长驻的 "git cat-file --batch" 进程
+ *
+ * 第一次查询时启动进程, 之后所有查询都复用它;
+ * 查询可以是任意 revision 表达式, 例如 "HEAD:src/main.cpp"、分支名或 blob SHA。
+ * 内部加锁, 可被多个线程共享
+ */
+class GitObjectReader {
+public:
+    GitObjectReader() = default;
+    ~GitObjectReader();
+
+    GitObjectReader(const GitObjectReader&) = delete;
+    GitObjectReader& operator=(const GitObjectReader&) = delete;
+
+    /**
+     * 读取对象
+     * @param name 对象名 (revision 表达式)
+     * @return 对象不存在或进程不可用时返回 std::nullopt
+     */
+    std::optional<GitObject> read(const std::string& name);
+
+private:
+    bool start();
+    void stop();
+    bool readLine(std::string& line);
+    bool readBytes(size_t count, std::string& out);
+
+    std::mutex mutex_;
+    pid_t pid_ = -1;         // cat-file 进程 ID
+    int to_git_ = -1;        // 写入请求的管道
+    int from_git_ = -1;      // 读取响应的管道
+    bool failed_ = false;    // 进程启动失败后不再重试
+
+    // 响应读取缓冲区
+    std::vector<char> buffer_;
+    size_t buffer_pos_ = 0;
+    size_t buffer_end_ = 0;
+};
+
+} // namespace cpp_review
@@ -0,0 +1,134 @@
+/*
+ * Git 版本虚拟文件系统实现
+ */
+
+#include "git/revision_file_system.h"
+#include "git/git_process.h"
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+
+namespace cpp_review {
+
+RevisionFileSystem::RevisionFileSystem(GitObjectReader& reader, std::string commit,
+                                       std::string repo_root,
+                                       llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> base)
+    : ProxyFileSystem(std::move(base)),
+      reader_(reader),
+      commit_(std::move(commit)),
+      repo_root_(std::move(repo_root)),
+      memory_(new llvm::vfs::InMemoryFileSystem()) {
+    // 内存文件系统与底层文件系统使用相同的工作目录, 相对路径才能一致解析
+    if (auto cwd = getUnderlyingFS().getCurrentWorkingDirectory()) {
+        memory_->setCurrentWorkingDirectory(*cwd);
+    }
+}
+
+std::error_code RevisionFileSystem::setCurrentWorkingDirectory(const llvm::Twine& path) {
+    std::error_code ec = ProxyFileSystem::setCurrentWorkingDirectory(path);
+    if (!ec) {
+        if (auto cwd = getUnderlyingFS().getCurrentWorkingDirectory()) {
+            memory_->setCurrentWorkingDirectory(*cwd);
+        }
+    }
+    return ec;
+}
+
+bool RevisionFileSystem::toRepoPath(const llvm::Twine& path, std::string& absolute,
+                                    std::string& repo_path) const {
+    llvm::SmallString<256> buffer;
+    path.toVector(buffer);
+    if (makeAbsolute(buffer)) {
+        return false;
+    }
+    llvm::sys::path::remove_dots(buffer, /*remove_dot_dot=*/true);
+    absolute = buffer.str().str();
+
+    if (absolute == repo_root_) {
+        repo_path.clear();
+        return true;
+    }
+    if (absolute.size() > repo_root_.size() &&
+        absolute.compare(0, repo_root_.size(), repo_root_) == 0 &&
+        absolute[repo_root_.size()] == '/') {
+        repo_path = absolute.substr(repo_root_.size() + 1);
+        // 仓库元数据目录不属于提交内容
+        if (repo_path == ".git" || repo_path.compare(0, 5, ".git/") == 0) {
+            return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+RevisionFileSystem::Entry RevisionFileSystem::lookup(const std::string& absolute,
+                                                     const std::string& repo_path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = entries_.find(absolute);
+    if (it != entries_.end()) {
+        return it->second;
+    }
+
+    Entry entry{EntryKind::Missing, llvm::sys::fs::UniqueID()};
+    if (auto object = reader_.read(commit_ + ":" + repo_path)) {
+        if (object->type == "blob") {
+            entry.kind = EntryKind::Blob;
+            memory_->addFile(absolute, 0,
+                             llvm::MemoryBuffer::getMemBufferCopy(object->content, absolute));
+        } else if (object->type == "tree") {
+            entry.kind = EntryKind::Tree;
+            entry.id = llvm::vfs::getNextVirtualUniqueID();
+        }
+    }
+
+    entries_.emplace(absolute, entry);
+    return entry;
+}
+
+llvm::ErrorOr<llvm::vfs::Status> RevisionFileSystem::status(const llvm::Twine& path) {
+    std::string absolute;
+    std::string repo_path;
+    if (!toRepoPath(path, absolute, repo_path)) {
+        return ProxyFileSystem::status(path);
+    }
+
+    Entry entry = lookup(absolute, repo_path);
+    switch (entry.kind) {
+        case EntryKind::Blob: {
+            auto result = memory_->status(absolute);
+            if (!result) return result;
+            return llvm::vfs::Status::copyWithNewName(*result, path.str());
+        }
+        case EntryKind::Tree:
+            return llvm::vfs::Status(path.str(), entry.id, llvm::sys::TimePoint<>(), 0, 0, 0,
+                                     llvm::sys::fs::file_type::directory_file,
+                                     llvm::sys::fs::all_read | llvm::sys::fs::all_exe);
+        case EntryKind::Missing:
+            break;
+    }
+
+    // 该提交中不存在的文件即使在工作区存在也不可见
+    return std::make_error_code(std::errc::no_such_file_or_directory);
+}
+
+llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>>
+RevisionFileSystem::openFileForRead(const llvm::Twine& path) {
+    std::string absolute;
+    std::string repo_path;
+    if (!toRepoPath(path, absolute, repo_path)) {
+        return ProxyFileSystem::openFileForRead(path);
+    }
+
+    Entry entry = lookup(absolute, repo_path);
+    if (entry.kind == EntryKind::Tree) {
+        return std::make_error_code(std::errc::is_a_directory);
+    }
+    if (entry.kind == EntryKind::Missing) {
+        return std::make_error_code(std::errc::no_such_file_or_directory);
+    }
+
+    // 以请求的路径打开, 使文件名与诊断/报告中看到的路径一致
+    return memory_->openFileForRead(path);
+}
+
+} // namespace cpp_review
@@ -0,0 +1,74 @@
+/*
+ * Git 版本虚拟文件系统头文件
+ * 让 Clang 直接从 git 对象库读取指定提交中的文件, 无需检出
+ *
+ * 设计要点:
+ * - 仓库内的路径按 "<commit>:<相对路径>" 通过 cat-file 批量进程查询
+ * - 读到的文件内容缓存在内存文件系统中, 同一文件只查询一次
+ * - 仓库外的路径 (系统头文件等) 透传给底层真实文件系统
+ * - 每个实例绑定一个提交, 多个实例可在不同线程中并行分析不同版本
+ */
+
+#pragma once
+
+#include <llvm/Support/VirtualFileSystem.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace cpp_review {
+
+class GitObjectReader;
+
+/**
+ * 指定提交的只读文件系统覆盖层
+ */
+class RevisionFileSystem : public llvm::vfs::ProxyFileSystem {
+public:
+    /**
+     * @param reader 共享的 cat-file 读取进程
+     * @param commit 提交 SHA (应已解析为完整 SHA)
+     * @param repo_root 仓库工作树根目录 (绝对路径)
+     * @param base 仓库外路径使用的底层文件系统
+     */
+    RevisionFileSystem(GitObjectReader& reader, std::string commit, std::string repo_root,
+                       llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> base =
+                           llvm::vfs::getRealFileSystem());
+
+    llvm::ErrorOr<llvm::vfs::Status> status(const llvm::Twine& path) override;
+    llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> openFileForRead(const llvm::Twine& path) override;
+    std::error_code setCurrentWorkingDirectory(const llvm::Twine& path) override;
+
+private:
+    // 仓库内路径在该提交中的类型
+    enum class EntryKind { Blob, Tree, Missing };
+
+    struct Entry {
+        EntryKind kind;
+        llvm::sys::fs::UniqueID id;   // 目录的虚拟文件 ID
+    };
+
+    /**
+     * 将路径转换为仓库相对路径
+     * @param path 请求的路径 (可为相对路径)
+     * @param absolute 输出: 规范化后的绝对路径
+     * @param repo_path 输出: 仓库相对路径 (根目录为空字符串)
+     * @return 路径不在仓库内返回 false
+     */
+    bool toRepoPath(const llvm::Twine& path, std::string& absolute, std::string& repo_path) const;
+
+    /**
+     * 查询路径在提交中的类型, blob 内容会被放入内存文件系统
+     */
+    Entry lookup(const std::string& absolute, const std::string& repo_path);
+
+    GitObjectReader& reader_;
+    std::string commit_;
+    std::string repo_root_;
+
+    llvm::IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> memory_;  // 已读取的文件内容
+    std::unordered_map<std::string, Entry> entries_;                   // 绝对路径 -> 查询结果
+    std::mutex mutex_;
+};
+
+} // namespace cpp_review
@@ -0,0 +1,287 @@
+/*
+ * 最小 HTTP 客户端实现
+ */
+
+#include "llm/http_client.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace cpp_review {
+
+namespace {
+
+/**
+ * 拆分后的 URL
+ */
+struct ParsedUrl {
+    std::string host;
+    std::string port = "80";
+    std::string path = "/";
+};
+
+bool parseUrl(const std::string& url, ParsedUrl& parsed) {
+    const std::string scheme = "http://";
+    if (url.compare(0, scheme.size(), scheme) != 0) {
+        return false;
+    }
+    std::string rest = url.substr(scheme.size());
+    size_t slash = rest.find('/');
+    std::string authority = rest.substr(0, slash);
+    if (slash != std::string::npos) {
+        parsed.path = rest.substr(slash);
+    }
+
+    // [IPv6]:port / host:port / host
+    if (!authority.empty() && authority[0] == '[') {
+        size_t close = authority.find(']');
+        if (close == std::string::npos) return false;
+        parsed.host = authority.substr(1, close - 1);
+        if (close + 1 < authority.size() && authority[close + 1] == ':') {
+            parsed.port = authority.substr(close + 2);
+        }
+    } else {
+        size_t colon = authority.rfind(':');
+        parsed.host = authority.substr(0, colon);
+        if (colon != std::string::npos) {
+            parsed.port = authority.substr(colon + 1);
+        }
+    }
+    return !parsed.host.empty() && !parsed.port.empty();
+}
+
+/**
+ * RAII 套接字
+ */
+class Socket {
+public:
+    Socket() = default;
+    ~Socket() { if (fd_ >= 0) ::close(fd_); }
+    Socket(const Socket&) = delete;
+    Socket& operator=(const Socket&) = delete;
+
+    int fd() const { return fd_; }
+    void reset(int fd) { if (fd_ >= 0) ::close(fd_); fd_ = fd; }
+
+private:
+    int fd_ = -1;
+};
+
+/**
+ * 带超时的连接 (非阻塞 connect + poll), 成功后恢复为阻塞模式并设置发送超时
+ * (读取由调用方按整个请求的截止时间 poll)
+ */
+bool connectWithTimeout(const ParsedUrl& url, int timeout_ms, Socket& socket, std::string& error) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    int rc = ::getaddrinfo(url.host.c_str(), url.port.c_str(), &hints, &addresses);
+    if (rc != 0) {
+        error = "cannot resolve " + url.host + ": " + gai_strerror(rc);
+        return false;
+    }
+
+    error = "cannot connect to " + url.host + ":" + url.port;
+    for (addrinfo* ai = addresses; ai; ai = ai->ai_next) {
+        int fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) continue;
+        socket.reset(fd);
+
+        int flags = ::fcntl(fd, F_GETFL, 0);
+        ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        rc = ::connect(fd, ai->ai_addr, ai->ai_addrlen);
+        if (rc != 0 && errno == EINPROGRESS) {
+            pollfd pfd{fd, POLLOUT, 0};
+            rc = ::poll(&pfd, 1, timeout_ms) == 1 ? 0 : -1;
+            int so_error = 0;
+            socklen_t len = sizeof(so_error);
+            if (rc == 0 && (::getsockopt(fd, SOL_SOCKET, SO_ERROR, &so_error, &len) != 0 || so_error != 0)) {
+                rc = -1;
+            }
+        }
+        if (rc != 0) continue;
+
+        ::fcntl(fd, F_SETFL, flags);
+        timeval tv{timeout_ms / 1000, (timeout_ms % 1000) * 1000};
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+        ::freeaddrinfo(addresses);
+        return true;
+    }
+    ::freeaddrinfo(addresses);
+    socket.reset(-1);
+    return false;
+}
+
+bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * 解码 chunked 响应体
+ */
+bool decodeChunked(const std::string& raw, std::string& body) {
+    body.clear();
+    size_t pos = 0;
+    for (;;) {
+        size_t line_end = raw.find("\r\n", pos);
+        if (line_end == std::string::npos) return false;
+        size_t size = 0;
+        try {
+            size = std::stoul(raw.substr(pos, line_end - pos), nullptr, 16);
+        } catch (const std::exception&) {
+            return false;
+        }
+        pos = line_end + 2;
+        if (size == 0) return true;
+        if (pos + size > raw.size()) return false;
+        body.append(raw, pos, size);
+        pos += size + 2;
+    }
+}
+
+} // namespace
+
+std::string HttpResponse::header(const std::string& name) const {
+    auto it = headers.find(name);
+    return it == headers.end() ? "" : it->second;
+}
+
+bool HttpClient::isSupportedUrl(const std::string& url) {
+    ParsedUrl parsed;
+    return parseUrl(url, parsed);
+}
+
+std::optional<HttpResponse> HttpClient::post(
+    const std::string& url, const std::string& body,
+    const std::vector<std::pair<std::string, std::string>>& headers,
+    int timeout_ms, std::string& error) {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+
+    ParsedUrl parsed;
+    if (!parseUrl(url, parsed)) {
+        error = "unsupported URL '" + url + "' (only http:// is supported)";
+        return std::nullopt;
+    }
+
+    Socket socket;
+    if (!connectWithTimeout(parsed, timeout_ms, socket, error)) {
+        return std::nullopt;
+    }
+
+    std::string request = "POST " + parsed.path + " HTTP/1.1\r\n";
+    request += "Host: " + parsed.host + (parsed.port == "80" ? "" : ":" + parsed.port) + "\r\n";
+    request += "Content-Type: application/json\r\n";
+    request += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    request += "Connection: close\r\n";
+    for (const auto& header : headers) {
+        request += header.first + ": " + header.second + "\r\n";
+    }
+    request += "\r\n";
+    request += body;
+
+    if (!sendAll(socket.fd(), request)) {
+        error = "send failed: " + std::string(std::strerror(errno));
+        return std::nullopt;
+    }
+
+    // 服务器在响应结束后关闭连接; 每次 recv 前按剩余时间 poll,
+    // 持续缓慢发送的服务器也不能让请求超过截止时间
+    std::string raw;
+    char buffer[16 * 1024];
+    for (;;) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+        if (remaining.count() <= 0) {
+            error = "read timed out";
+            return std::nullopt;
+        }
+        pollfd pfd{socket.fd(), POLLIN, 0};
+        int ready = ::poll(&pfd, 1, static_cast<int>(remaining.count()));
+        if (ready < 0 && errno == EINTR) continue;
+        if (ready < 0) {
+            error = "poll failed: " + std::string(std::strerror(errno));
+            return std::nullopt;
+        }
+        if (ready == 0) {
+            error = "read timed out";
+            return std::nullopt;
+        }
+
+        ssize_t n = ::recv(socket.fd(), buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            error = "recv failed: " + std::string(std::strerror(errno));
+            return std::nullopt;
+        }
+        if (n == 0) break;
+        raw.append(buffer, static_cast<size_t>(n));
+    }
+
+    size_t header_end = raw.find("\r\n\r\n");
+    if (header_end == std::string::npos || raw.compare(0, 5, "HTTP/") != 0) {
+        error = "malformed HTTP response";
+        return std::nullopt;
+    }
+
+    HttpResponse response;
+    size_t status_begin = raw.find(' ');
+    try {
+        response.status = std::stoi(raw.substr(status_begin + 1, 3));
+    } catch (const std::exception&) {
+        error = "malformed HTTP status line";
+        return std::nullopt;
+    }
+
+    size_t line_begin = raw.find("\r\n") + 2;
+    while (line_begin < header_end) {
+        size_t line_end = raw.find("\r\n", line_begin);
+        std::string line = raw.substr(line_begin, line_end - line_begin);
+        size_t colon = line.find(':');
+        if (colon != std::string::npos) {
+            std::string name = line.substr(0, colon);
+            std::transform(name.begin(), name.end(), name.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            size_t value_begin = line.find_first_not_of(" \t", colon + 1);
+            response.headers[name] = value_begin == std::string::npos ? "" : line.substr(value_begin);
+        }
+        line_begin = line_end + 2;
+    }
+
+    std::string payload = raw.substr(header_end + 4);
+    if (response.header("transfer-encoding").find("chunked") != std::string::npos) {
+        if (!decodeChunked(payload, response.body)) {
+            error = "truncated chunked response";
+            return std::nullopt;
+        }
+    } else {
+        std::string length = response.header("content-length");
+        if (!length.empty()) {
+            size_t expected = std::strtoul(length.c_str(), nullptr, 10);
+            if (payload.size() < expected) {
+                error = "truncated response body";
+                return std::nullopt;
+            }
+            payload.resize(expected);
+        }
+        response.body = std::move(payload);
+    }
+    return response;
+}
+
+} // namespace cpp_review
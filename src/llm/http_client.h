@@ -0,0 +1,57 @@
+/*
+ * 最小 HTTP 客户端头文件
+ * LLM 提供者访问 OpenAI 兼容接口使用, 不依赖外部网络库
+ *
+ * 设计要点:
+ * - 只支持明文 http:// (自托管模型、本地桩服务器或本机 TLS 代理)
+ * - 每个请求一个连接 (Connection: close), 线程安全, 可并发调用
+ * - 支持 Content-Length 和 chunked 两种响应体编码
+ */
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cpp_review {
+
+/**
+ * HTTP 响应
+ */
+struct HttpResponse {
+    int status = 0;                              // 状态码
+    std::map<std::string, std::string> headers;  // 响应头 (名称为小写)
+    std::string body;                            // 响应体 (已解码 chunked)
+
+    // 查询响应头, 不存在时返回空字符串
+    std::string header(const std::string& name) const;
+};
+
+/**
+ * HTTP 客户端
+ */
+class HttpClient {
+public:
+    /**
+     * 发送 POST 请求
+     * @param url 目标地址 (http://host[:port]/path)
+     * @param body 请求体
+     * @param headers 额外的请求头 (名称, 值)
+     * @param timeout_ms 整个请求的超时 (毫秒): 从开始连接到读完响应, 服务器持续缓慢发送也不会超出
+     * @param error 输出: 失败原因
+     * @return 收到完整响应时返回响应 (任何状态码); 连接或协议错误时返回 std::nullopt
+     */
+    static std::optional<HttpResponse> post(
+        const std::string& url, const std::string& body,
+        const std::vector<std::pair<std::string, std::string>>& headers,
+        int timeout_ms, std::string& error);
+
+    /**
+     * 检查地址是否为支持的 http:// 地址
+     */
+    static bool isSupportedUrl(const std::string& url);
+};
+
+} // namespace cpp_review
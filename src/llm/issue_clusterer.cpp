@@ -0,0 +1,129 @@
+/*
+ * 相似问题聚类实现
+ */
+
+#include "llm/issue_clusterer.h"
+#include "report/fingerprint.h"
+#include <cctype>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace cpp_review {
+
+namespace {
+
+// 形状中保留原文的关键字和基本类型
+const std::unordered_set<std::string>& keywords() {
+    static const std::unordered_set<std::string> words = {
+        "auto", "bool", "break", "case", "catch", "char", "class", "const", "const_cast",
+        "constexpr", "continue", "default", "delete", "do", "double", "dynamic_cast", "else",
+        "enum", "false", "float", "for", "if", "int", "long", "mutable", "new", "nullptr",
+        "operator", "reinterpret_cast", "return", "short", "signed", "sizeof", "static",
+        "static_cast", "struct", "switch", "this", "throw", "true", "try", "typename",
+        "unsigned", "void", "volatile", "while", "NULL",
+    };
+    return words;
+}
+
+bool isIdentifierStart(char c) {
+    return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool isIdentifierChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// 跳过空白后的下一个字符位置
+size_t skipSpaces(const std::string& text, size_t pos) {
+    while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+        ++pos;
+    }
+    return pos;
+}
+
+} // namespace
+
+std::string IssueClusterer::shapeOf(const std::string& snippet) {
+    std::string shape;
+    shape.reserve(snippet.size());
+    std::unordered_map<std::string, size_t> names;   // 局部名字 -> 序号
+    bool after_scope = false;                         // 上一个记号是否为 "::"
+
+    auto append = [&](const std::string& token) {
+        if (!shape.empty()) shape.push_back(' ');
+        shape += token;
+    };
+
+    size_t i = 0;
+    const size_t n = snippet.size();
+    while (i < n) {
+        char c = snippet[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            ++i;
+            continue;
+        }
+
+        if (isIdentifierStart(c)) {
+            size_t begin = i;
+            while (i < n && isIdentifierChar(snippet[i])) ++i;
+            std::string name = snippet.substr(begin, i - begin);
+
+            size_t next = skipSpaces(snippet, i);
+            bool is_call = next < n && snippet[next] == '(';
+            bool is_qualifier = next + 1 < n && snippet[next] == ':' && snippet[next + 1] == ':';
+            if (is_call || is_qualifier || after_scope || keywords().count(name)) {
+                append(name);
+            } else {
+                auto it = names.emplace(name, names.size() + 1).first;
+                append("$" + std::to_string(it->second));
+            }
+            after_scope = false;
+            continue;
+        }
+
+        if (std::isdigit(static_cast<unsigned char>(c))) {
+            // 数字字面量 (含后缀、小数点、数字分隔符)
+            while (i < n && (isIdentifierChar(snippet[i]) || snippet[i] == '.' || snippet[i] == '\'')) ++i;
+            append("0");
+            after_scope = false;
+            continue;
+        }
+
+        if (c == '"' || c == '\'') {
+            // 字符串/字符字面量: 跳过转义字符直到匹配的引号
+            char quote = c;
+            ++i;
+            while (i < n && snippet[i] != quote) {
+                i += snippet[i] == '\\' ? 2 : 1;
+            }
+            ++i;
+            append(std::string(2, quote));
+            after_scope = false;
+            continue;
+        }
+
+        if (c == ':' && i + 1 < n && snippet[i + 1] == ':') {
+            append("::");
+            i += 2;
+            after_scope = true;
+            continue;
+        }
+
+        append(std::string(1, c));
+        ++i;
+        after_scope = false;
+    }
+
+    return shape;
+}
+
+uint64_t IssueClusterer::clusterKey(const Issue& issue) {
+    uint64_t hash = Fingerprint::kOffsetBasis;
+    hash = Fingerprint::mix(hash, "cluster-v1");
+    hash = Fingerprint::mix(hash, issue.rule_id);
+    hash = Fingerprint::mix(hash, Fingerprint::normalizeMessage(issue.description));
+    hash = Fingerprint::mix(hash, shapeOf(issue.code_snippet));
+    return hash;
+}
+
+} // namespace cpp_review
@@ -0,0 +1,41 @@
+/*
+ * 相似问题聚类头文件
+ * AI 增强前按 (规则 ID, 规范化描述, 代码片段的记号形状) 把问题分组,
+ * 每组只请求一次提供者, 建议分发给组内所有问题
+ *
+ * 记号形状:
+ * - 局部名字按首次出现顺序改写为 $1, $2, ... (保留 "x = x" 与 "x = y" 的区别)
+ * - 被调用的函数名、限定名 (std::string) 和关键字保留原文
+ * - 数字字面量改写为 0, 字符串/字符字面量清空, 空白被忽略
+ * 例如 "strcpy(buf, name)" 与 "strcpy(dest, input)" 形状相同
+ */
+
+#pragma once
+
+#include "report/reporter.h"
+#include <cstdint>
+#include <string>
+
+namespace cpp_review {
+
+/**
+ * 问题聚类工具
+ */
+class IssueClusterer {
+public:
+    /**
+     * 计算代码片段的记号形状
+     * @param snippet 代码片段
+     * @return 规范化后的形状文本 (记号以空格分隔)
+     */
+    static std::string shapeOf(const std::string& snippet);
+
+    /**
+     * 计算问题的聚类键
+     * @param issue 问题
+     * @return 64 位聚类键; 键相同的问题共享同一条建议
+     */
+    static uint64_t clusterKey(const Issue& issue);
+};
+
+} // namespace cpp_review
@@ -10,6 +10,16 @@
  */
 
 #include "llm/llm_enhancer.h"
+#include "llm/http_client.h"
+#include "llm/issue_clusterer.h"
+#include "report/fingerprint.h"
+#include "report/json_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <random>
 #include <sstream>
 
 namespace cpp_review {
@@ -18,417 +28,855 @@ namespace cpp_review {
 // RuleBasedProvider 实现 - 基于规则的智能提供者
 // ============================================================================
 
+namespace {
+
+/**
+ * 规则建议表中的一项
+ * 文本是编译期常量, 所有问题共享; has_placeholders 为 true 的文本含 {{...}} 占位符,
+ * 需要按问题替换后使用
+ */
+struct SuggestionEntry {
+    std::string_view rule_id;
+    std::string_view text;
+    bool has_placeholders;
+};
+
+// 7 个规则专属的修复策略
+constexpr SuggestionEntry kRuleSuggestions[] = {
+    {"NULL-PTR-001", R"TXT(🤖 AI-Enhanced Fix Strategy:
+
+1. **Immediate Fix** - Add null check:
+   ```cpp
+   if (ptr != nullptr) {
+       // Use ptr safely
+       *ptr = value;
+   }
+   ```
+
+2. **Better Approach** - Use smart pointers:
+   ```cpp
+   auto ptr = std::make_unique<Type>();
+   *ptr = value;  // Always safe
+   ```
+
+3. **Best Practice** - Use references when possible:
+   ```cpp
+   Type& ref = *ptr;  // Will throw if null
+   ref = value;
+   ```
+
+4. **Design Pattern** - Use Optional for nullable values:
+   ```cpp
+   std::optional<Type> maybeValue;
+   if (maybeValue.has_value()) {
+       *maybeValue = value;
+   }
+   ```)TXT", false},
+    {"MEMORY-LEAK-001", R"TXT(🤖 AI-Enhanced Fix Strategy:
+
+1. **Quick Fix** - Add delete statement:
+   ```cpp
+   Type* ptr = new Type();
+   // Use ptr...
+   delete ptr;  // Don't forget!
+   ptr = nullptr;  // Prevent dangling pointer
+   ```
+
+2. **Recommended** - Use std::unique_ptr:
+   ```cpp
+   auto ptr = std::make_unique<Type>();
+   // Automatic cleanup, exception-safe
+   ```
+
+3. **For Shared Ownership** - Use std::shared_ptr:
+   ```cpp
+   auto ptr = std::make_shared<Type>();
+   // Reference counted, multiple owners OK
+   ```
+
+4. **RAII Pattern** - Wrap resource in class:
+   ```cpp
+   class ResourceWrapper {
+       Type* ptr_;
+   public:
+       ResourceWrapper() : ptr_(new Type()) {}
+       ~ResourceWrapper() { delete ptr_; }
+       // Delete copy, allow move
+   };
+   ```)TXT", false},
+    {"BUFFER-OVERFLOW-001", R"TXT(🤖 AI-Enhanced Fix Strategy:
+
+1. **Immediate Fix** - Add bounds checking:
+   ```cpp
+   if (index >= 0 && index < array_size) {
+       array[index] = value;
+   } else {
+       // Handle error
+       throw std::out_of_range("Invalid index");
+   }
+   ```
+
+2. **Use std::vector with at()** - Automatic bounds checking:
+   ```cpp
+   std::vector<int> vec(size);
+   try {
+       vec.at(index) = value;  // Throws if out of bounds
+   } catch (const std::out_of_range& e) {
+       // Handle error
+   }
+   ```
+
+3. **Use std::span (C++20)** - Safe array views:
+   ```cpp
+   void process(std::span<int> data) {
+       for (size_t i = 0; i < data.size(); ++i) {
+           data[i] = value;  // Size known
+       }
+   }
+   ```
+
+4. **Debug Mode** - Use assertions:
+   ```cpp
+   #include <cassert>
+   assert(index >= 0 && index < size && "Index out of bounds");
+   array[index] = value;
+   ```)TXT", false},
+    {"INTEGER-OVERFLOW-001", R"TXT(🤖 AI-Enhanced Fix Strategy:
+
+1. **Use Larger Types** - Prevent overflow:
+   ```cpp
+   int8_t a = 100, b = 100;
+   int32_t result = static_cast<int32_t>(a) + static_cast<int32_t>(b);
+   ```
+
+2. **Check Before Operation** - Detect potential overflow:
+   ```cpp
+   #include <limits>
+   if (a > std::numeric_limits<int>::max() - b) {
+       // Would overflow
+       throw std::overflow_error("Addition overflow");
+   }
+   int result = a + b;
+   ```
+
+3. **Use Compiler Builtins** - Hardware-assisted checking:
+   ```cpp
+   int result;
+   if (__builtin_add_overflow(a, b, &result)) {
+       // Overflow occurred
+       std::cerr << "Overflow detected!" << std::endl;
+   }
+   ```
+
+4. **Safe Integer Libraries** - Use checked types:
+   ```cpp
+   // Boost.SafeNumerics or similar
+   safe<int> a = 100;
+   safe<int> b = 100;
+   safe<int> result = a + b;  // Throws on overflow
+   ```)TXT", false},
+    {"USE-AFTER-FREE-001", R"TXT(🤖 AI-Enhanced Fix Strategy:
+
+1. **Immediate Fix** - Set to nullptr after delete:
+   ```cpp
+   delete ptr;
+   ptr = nullptr;  // Prevent use-after-free
+   
+   if (ptr != nullptr) {
+       *ptr = value;  // Won't execute
+   }
+   ```
+
+2. **Best Practice** - Use RAII with smart pointers:
+   ```cpp
+   {
+       auto ptr = std::make_unique<Type>();
+       *ptr = value;  // Safe
+   }  // Automatically deleted, can't use after
+   ```
+
+3. **Scope Management** - Limit pointer lifetime:
+   ```cpp
+   void processData() {
+       Type* ptr = new Type();
+       try {
+           // Use ptr
+       } catch (...) {
+           delete ptr;
+           throw;
+       }
+       delete ptr;
+   }
+   // ptr no longer accessible
+   ```
+
+4. **Memory Sanitizers** - Debug detection:
+   ```bash
+   # Compile with AddressSanitizer
+   g++ -fsanitize=address -g code.cpp
+   # Will catch use-after-free at runtime
+   ```)TXT", false},
+    {"SMART-PTR-001", R"TXT(🤖 AI-Enhanced Refactoring Guide:
+
+1. **std::unique_ptr** - For exclusive ownership:
+   ```cpp
+   // Before
+   Widget* widget = new Widget();
+   widget->doSomething();
+   delete widget;
+   
+   // After
+   auto widget = std::make_unique<Widget>();
+   widget->doSomething();
+   // Automatic cleanup
+   ```
+
+2. **std::shared_ptr** - For shared ownership:
+   ```cpp
+   auto resource = std::make_shared<Resource>();
+   
+   // Share with other owners
+   auto copy = resource;  // Reference count++
+   
+   // Last owner cleans up automatically
+   ```
+
+3. **Passing Smart Pointers** - Best practices:
+   ```cpp
+   // By value: Transfer ownership
+   void takeOwnership(std::unique_ptr<T> ptr);
+   
+   // By reference: Borrow temporarily
+   void useTemporarily(const std::unique_ptr<T>& ptr);
+   
+   // Raw pointer: No ownership semantics
+   void observe(T* ptr);
+   ```
+
+4. **Custom Deleters** - For special cleanup:
+   ```cpp
+   auto fileDeleter = [](FILE* f) { if (f) fclose(f); };
+   std::unique_ptr<FILE, decltype(fileDeleter)> 
+       file(fopen("data.txt", "r"), fileDeleter);
+   ```)TXT", false},
+    {"LOOP-COPY-001", R"TXT(🤖 AI-Enhanced Performance Optimization:
+
+1. **Use const reference** - Zero-copy access:
+   ```cpp
+   // Before: Copies each element
+   for (std::string str : container) {
+       process(str);  // Expensive copy!
+   }
+   
+   // After: No copies
+   for (const auto& str : container) {
+       process(str);  // Just a reference
+   }
+   ```
+
+2. **Non-const reference** - For modifications:
+   ```cpp
+   for (auto& element : container) {
+       element.modify();  // Modify in place
+   }
+   ```
+
+3. **Move semantics** - For consuming elements:
+   ```cpp
+   std::vector<std::string> results;
+   for (auto&& str : container) {
+       results.push_back(std::move(str));  // Move, not copy
+   }
+   ```
+
+4. **Performance analysis** - Measure impact:
+   ```cpp
+   #include <chrono>
+   auto start = std::chrono::high_resolution_clock::now();
+   for (const auto& item : container) { /* ... */ }
+   auto end = std::chrono::high_resolution_clock::now();
+   auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+   ```)TXT", false},
+};
+
+// 未知规则的通用建议
+constexpr SuggestionEntry kGenericSuggestion = {"", R"TXT(🤖 AI-Enhanced Analysis:
+
+Based on the detected {{rule_id}} issue, consider these general best practices:
+
+1. **Code Review**: Have a colleague review this code section
+2. **Unit Tests**: Add tests to verify the fix works correctly
+3. **Documentation**: Update code comments if behavior changes
+4. **Static Analysis**: Run additional tools to catch related issues
+
+For more specific guidance, consult:
+- C++ Core Guidelines: https://isocpp.github.io/CppCoreGuidelines/
+- Your team's coding standards
+- Language-specific best practices)TXT", true};
+
+const SuggestionEntry& findSuggestion(const std::string& rule_id) {
+    for (const auto& entry : kRuleSuggestions) {
+        if (entry.rule_id == rule_id) {
+            return entry;
+        }
+    }
+    return kGenericSuggestion;
+}
+
+} // namespace
+
 /**
  * 生成智能建议的主入口
- * 根据规则 ID 路由到专门的处理器
+ * 按规则 ID 查表; 含占位符的文本替换后返回
  */
 std::string RuleBasedProvider::generateSuggestion(const Issue& issue, const std::string& code_context) {
-    // 根据规则 ID 路由到专门的处理器
-    if (issue.rule_id == "NULL-PTR-001") {
-        return generateNullPointerSuggestion(issue);
-    } else if (issue.rule_id == "MEMORY-LEAK-001") {
-        return generateMemoryLeakSuggestion(issue);
-    } else if (issue.rule_id == "BUFFER-OVERFLOW-001") {
-        return generateBufferOverflowSuggestion(issue);
-    } else if (issue.rule_id == "INTEGER-OVERFLOW-001") {
-        return generateIntegerOverflowSuggestion(issue);
-    } else if (issue.rule_id == "USE-AFTER-FREE-001") {
-        return generateUseAfterFreeSuggestion(issue);
-    } else if (issue.rule_id == "SMART-PTR-001") {
-        return generateSmartPointerSuggestion(issue);
-    } else if (issue.rule_id == "LOOP-COPY-001") {
-        return generateLoopCopySuggestion(issue);
+    const SuggestionEntry& entry = findSuggestion(issue.rule_id);
+    if (!entry.has_placeholders) {
+        return std::string(entry.text);
     }
-
-    // 对于未知规则,返回通用建议
-    return generateGenericSuggestion(issue);
+    return expandPlaceholders(entry.text, issue);
 }
 
-std::string RuleBasedProvider::generateNullPointerSuggestion(const Issue& issue) {
-    std::stringstream ss;
-    ss << "🤖 AI-Enhanced Fix Strategy:\n\n";
-    ss << "1. **Immediate Fix** - Add null check:\n";
-    ss << "   ```cpp\n";
-    ss << "   if (ptr != nullptr) {\n";
-    ss << "       // Use ptr safely\n";
-    ss << "       *ptr = value;\n";
-    ss << "   }\n";
-    ss << "   ```\n\n";
-    ss << "2. **Better Approach** - Use smart pointers:\n";
-    ss << "   ```cpp\n";
-    ss << "   auto ptr = std::make_unique<Type>();\n";
-    ss << "   *ptr = value;  // Always safe\n";
-    ss << "   ```\n\n";
-    ss << "3. **Best Practice** - Use references when possible:\n";
-    ss << "   ```cpp\n";
-    ss << "   Type& ref = *ptr;  // Will throw if null\n";
-    ss << "   ref = value;\n";
-    ss << "   ```\n\n";
-    ss << "4. **Design Pattern** - Use Optional for nullable values:\n";
-    ss << "   ```cpp\n";
-    ss << "   std::optional<Type> maybeValue;\n";
-    ss << "   if (maybeValue.has_value()) {\n";
-    ss << "       *maybeValue = value;\n";
-    ss << "   }\n";
-    ss << "   ```";
+/**
+ * 不含占位符的建议直接返回表中的文本 (不分配内存)
+ */
+std::string_view RuleBasedProvider::getStaticSuggestion(const Issue& issue) const {
+    const SuggestionEntry& entry = findSuggestion(issue.rule_id);
+    return entry.has_placeholders ? std::string_view() : entry.text;
+}
 
-    return ss.str();
+/**
+ * 替换占位符 {{rule_id}}; 未知的占位符原样保留
+ */
+std::string RuleBasedProvider::expandPlaceholders(std::string_view text, const Issue& issue) {
+    std::string result;
+    result.reserve(text.size() + 32);
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t open = text.find("{{", pos);
+        size_t close = open == std::string_view::npos ? open : text.find("}}", open + 2);
+        if (close == std::string_view::npos) {
+            result.append(text.substr(pos));
+            break;
+        }
+        result.append(text.substr(pos, open - pos));
+        std::string_view name = text.substr(open + 2, close - open - 2);
+        if (name == "rule_id") {
+            result += issue.rule_id;
+        } else {
+            result.append(text.substr(open, close + 2 - open));
+        }
+        pos = close + 2;
+    }
+    return result;
 }
 
-std::string RuleBasedProvider::generateMemoryLeakSuggestion(const Issue& issue) {
-    std::stringstream ss;
-    ss << "🤖 AI-Enhanced Fix Strategy:\n\n";
-    ss << "1. **Quick Fix** - Add delete statement:\n";
-    ss << "   ```cpp\n";
-    ss << "   Type* ptr = new Type();\n";
-    ss << "   // Use ptr...\n";
-    ss << "   delete ptr;  // Don't forget!\n";
-    ss << "   ptr = nullptr;  // Prevent dangling pointer\n";
-    ss << "   ```\n\n";
-    ss << "2. **Recommended** - Use std::unique_ptr:\n";
-    ss << "   ```cpp\n";
-    ss << "   auto ptr = std::make_unique<Type>();\n";
-    ss << "   // Automatic cleanup, exception-safe\n";
-    ss << "   ```\n\n";
-    ss << "3. **For Shared Ownership** - Use std::shared_ptr:\n";
-    ss << "   ```cpp\n";
-    ss << "   auto ptr = std::make_shared<Type>();\n";
-    ss << "   // Reference counted, multiple owners OK\n";
-    ss << "   ```\n\n";
-    ss << "4. **RAII Pattern** - Wrap resource in class:\n";
-    ss << "   ```cpp\n";
-    ss << "   class ResourceWrapper {\n";
-    ss << "       Type* ptr_;\n";
-    ss << "   public:\n";
-    ss << "       ResourceWrapper() : ptr_(new Type()) {}\n";
-    ss << "       ~ResourceWrapper() { delete ptr_; }\n";
-    ss << "       // Delete copy, allow move\n";
-    ss << "   };\n";
-    ss << "   ```";
+// ============================================================================
+// LLMProvider 默认实现
+// ============================================================================
 
-    return ss.str();
+std::vector<std::string> LLMProvider::generateSuggestions(const std::vector<Issue>& issues) {
+    std::vector<std::string> suggestions;
+    suggestions.reserve(issues.size());
+    for (const auto& issue : issues) {
+        suggestions.push_back(generateSuggestion(issue, issue.code_snippet));
+    }
+    return suggestions;
 }
 
-std::string RuleBasedProvider::generateBufferOverflowSuggestion(const Issue& issue) {
-    std::stringstream ss;
-    ss << "🤖 AI-Enhanced Fix Strategy:\n\n";
-    ss << "1. **Immediate Fix** - Add bounds checking:\n";
-    ss << "   ```cpp\n";
-    ss << "   if (index >= 0 && index < array_size) {\n";
-    ss << "       array[index] = value;\n";
-    ss << "   } else {\n";
-    ss << "       // Handle error\n";
-    ss << "       throw std::out_of_range(\"Invalid index\");\n";
-    ss << "   }\n";
-    ss << "   ```\n\n";
-    ss << "2. **Use std::vector with at()** - Automatic bounds checking:\n";
-    ss << "   ```cpp\n";
-    ss << "   std::vector<int> vec(size);\n";
-    ss << "   try {\n";
-    ss << "       vec.at(index) = value;  // Throws if out of bounds\n";
-    ss << "   } catch (const std::out_of_range& e) {\n";
-    ss << "       // Handle error\n";
-    ss << "   }\n";
-    ss << "   ```\n\n";
-    ss << "3. **Use std::span (C++20)** - Safe array views:\n";
-    ss << "   ```cpp\n";
-    ss << "   void process(std::span<int> data) {\n";
-    ss << "       for (size_t i = 0; i < data.size(); ++i) {\n";
-    ss << "           data[i] = value;  // Size known\n";
-    ss << "       }\n";
-    ss << "   }\n";
-    ss << "   ```\n\n";
-    ss << "4. **Debug Mode** - Use assertions:\n";
-    ss << "   ```cpp\n";
-    ss << "   #include <cassert>\n";
-    ss << "   assert(index >= 0 && index < size && \"Index out of bounds\");\n";
-    ss << "   array[index] = value;\n";
-    ss << "   ```";
+// ============================================================================
+// OpenAIProvider 实现 - OpenAI 兼容的 HTTP 提供者
+// ============================================================================
 
-    return ss.str();
+namespace {
+
+const char* severityName(Severity severity) {
+    switch (severity) {
+        case Severity::CRITICAL: return "CRITICAL";
+        case Severity::HIGH: return "HIGH";
+        case Severity::MEDIUM: return "MEDIUM";
+        case Severity::LOW: return "LOW";
+        case Severity::SUGGESTION: return "SUGGESTION";
+    }
+    return "MEDIUM";
 }
 
-std::string RuleBasedProvider::generateIntegerOverflowSuggestion(const Issue& issue) {
-    std::stringstream ss;
-    ss << "🤖 AI-Enhanced Fix Strategy:\n\n";
-    ss << "1. **Use Larger Types** - Prevent overflow:\n";
-    ss << "   ```cpp\n";
-    ss << "   int8_t a = 100, b = 100;\n";
-    ss << "   int32_t result = static_cast<int32_t>(a) + static_cast<int32_t>(b);\n";
-    ss << "   ```\n\n";
-    ss << "2. **Check Before Operation** - Detect potential overflow:\n";
-    ss << "   ```cpp\n";
-    ss << "   #include <limits>\n";
-    ss << "   if (a > std::numeric_limits<int>::max() - b) {\n";
-    ss << "       // Would overflow\n";
-    ss << "       throw std::overflow_error(\"Addition overflow\");\n";
-    ss << "   }\n";
-    ss << "   int result = a + b;\n";
-    ss << "   ```\n\n";
-    ss << "3. **Use Compiler Builtins** - Hardware-assisted checking:\n";
-    ss << "   ```cpp\n";
-    ss << "   int result;\n";
-    ss << "   if (__builtin_add_overflow(a, b, &result)) {\n";
-    ss << "       // Overflow occurred\n";
-    ss << "       std::cerr << \"Overflow detected!\" << std::endl;\n";
-    ss << "   }\n";
-    ss << "   ```\n\n";
-    ss << "4. **Safe Integer Libraries** - Use checked types:\n";
-    ss << "   ```cpp\n";
-    ss << "   // Boost.SafeNumerics or similar\n";
-    ss << "   safe<int> a = 100;\n";
-    ss << "   safe<int> b = 100;\n";
-    ss << "   safe<int> result = a + b;  // Throws on overflow\n";
-    ss << "   ```";
+// 令牌估计: 英文文本和代码平均每个令牌约 4 个字节; 每个问题的回答按固定令牌数预留
+constexpr size_t kBytesPerToken = 4;
+constexpr size_t kAnswerTokensPerIssue = 400;
 
-    return ss.str();
+// 可重试的 HTTP 状态: 超时、限流、服务端错误
+bool isRetryableStatus(int status) {
+    return status == 408 || status == 429 || status >= 500;
 }
 
-std::string RuleBasedProvider::generateUseAfterFreeSuggestion(const Issue& issue) {
-    std::stringstream ss;
-    ss << "🤖 AI-Enhanced Fix Strategy:\n\n";
-    ss << "1. **Immediate Fix** - Set to nullptr after delete:\n";
-    ss << "   ```cpp\n";
-    ss << "   delete ptr;\n";
-    ss << "   ptr = nullptr;  // Prevent use-after-free\n";
-    ss << "   \n";
-    ss << "   if (ptr != nullptr) {\n";
-    ss << "       *ptr = value;  // Won't execute\n";
-    ss << "   }\n";
-    ss << "   ```\n\n";
-    ss << "2. **Best Practice** - Use RAII with smart pointers:\n";
-    ss << "   ```cpp\n";
-    ss << "   {\n";
-    ss << "       auto ptr = std::make_unique<Type>();\n";
-    ss << "       *ptr = value;  // Safe\n";
-    ss << "   }  // Automatically deleted, can't use after\n";
-    ss << "   ```\n\n";
-    ss << "3. **Scope Management** - Limit pointer lifetime:\n";
-    ss << "   ```cpp\n";
-    ss << "   void processData() {\n";
-    ss << "       Type* ptr = new Type();\n";
-    ss << "       try {\n";
-    ss << "           // Use ptr\n";
-    ss << "       } catch (...) {\n";
-    ss << "           delete ptr;\n";
-    ss << "           throw;\n";
-    ss << "       }\n";
-    ss << "       delete ptr;\n";
-    ss << "   }\n";
-    ss << "   // ptr no longer accessible\n";
-    ss << "   ```\n\n";
-    ss << "4. **Memory Sanitizers** - Debug detection:\n";
-    ss << "   ```bash\n";
-    ss << "   # Compile with AddressSanitizer\n";
-    ss << "   g++ -fsanitize=address -g code.cpp\n";
-    ss << "   # Will catch use-after-free at runtime\n";
-    ss << "   ```";
-
-    return ss.str();
+/**
+ * 第 attempt 次重试前的等待时间
+ * 服务端给出 Retry-After (秒) 时优先使用, 否则 500ms 起指数增长 (上限 8s) 并加抖动
+ */
+std::chrono::milliseconds backoffDelay(int attempt, const std::string& retry_after) {
+    if (!retry_after.empty()) {
+        try {
+            int seconds = std::stoi(retry_after);
+            return std::chrono::milliseconds(std::min(std::max(seconds, 0), 30) * 1000);
+        } catch (const std::exception&) {
+            // HTTP 日期格式的 Retry-After 按指数退避处理
+        }
+    }
+    thread_local std::mt19937 rng(std::random_device{}());
+    int base = std::min(500 << std::min(attempt, 4), 8000);
+    std::uniform_int_distribution<int> jitter(base / 2, base);
+    return std::chrono::milliseconds(jitter(rng));
 }
 
-std::string RuleBasedProvider::generateSmartPointerSuggestion(const Issue& issue) {
-    std::stringstream ss;
-    ss << "🤖 AI-Enhanced Refactoring Guide:\n\n";
-    ss << "1. **std::unique_ptr** - For exclusive ownership:\n";
-    ss << "   ```cpp\n";
-    ss << "   // Before\n";
-    ss << "   Widget* widget = new Widget();\n";
-    ss << "   widget->doSomething();\n";
-    ss << "   delete widget;\n";
-    ss << "   \n";
-    ss << "   // After\n";
-    ss << "   auto widget = std::make_unique<Widget>();\n";
-    ss << "   widget->doSomething();\n";
-    ss << "   // Automatic cleanup\n";
-    ss << "   ```\n\n";
-    ss << "2. **std::shared_ptr** - For shared ownership:\n";
-    ss << "   ```cpp\n";
-    ss << "   auto resource = std::make_shared<Resource>();\n";
-    ss << "   \n";
-    ss << "   // Share with other owners\n";
-    ss << "   auto copy = resource;  // Reference count++\n";
-    ss << "   \n";
-    ss << "   // Last owner cleans up automatically\n";
-    ss << "   ```\n\n";
-    ss << "3. **Passing Smart Pointers** - Best practices:\n";
-    ss << "   ```cpp\n";
-    ss << "   // By value: Transfer ownership\n";
-    ss << "   void takeOwnership(std::unique_ptr<T> ptr);\n";
-    ss << "   \n";
-    ss << "   // By reference: Borrow temporarily\n";
-    ss << "   void useTemporarily(const std::unique_ptr<T>& ptr);\n";
-    ss << "   \n";
-    ss << "   // Raw pointer: No ownership semantics\n";
-    ss << "   void observe(T* ptr);\n";
-    ss << "   ```\n\n";
-    ss << "4. **Custom Deleters** - For special cleanup:\n";
-    ss << "   ```cpp\n";
-    ss << "   auto fileDeleter = [](FILE* f) { if (f) fclose(f); };\n";
-    ss << "   std::unique_ptr<FILE, decltype(fileDeleter)> \n";
-    ss << "       file(fopen(\"data.txt\", \"r\"), fileDeleter);\n";
-    ss << "   ```";
+} // namespace
 
-    return ss.str();
+std::string OpenAIProvider::generateSuggestion(const Issue& issue, const std::string& code_context) {
+    Issue with_context = issue;
+    if (!code_context.empty()) {
+        with_context.code_snippet = code_context;
+    }
+    return generateSuggestions({with_context}).front();
 }
 
-std::string RuleBasedProvider::generateLoopCopySuggestion(const Issue& issue) {
-    std::stringstream ss;
-    ss << "🤖 AI-Enhanced Performance Optimization:\n\n";
-    ss << "1. **Use const reference** - Zero-copy access:\n";
-    ss << "   ```cpp\n";
-    ss << "   // Before: Copies each element\n";
-    ss << "   for (std::string str : container) {\n";
-    ss << "       process(str);  // Expensive copy!\n";
-    ss << "   }\n";
-    ss << "   \n";
-    ss << "   // After: No copies\n";
-    ss << "   for (const auto& str : container) {\n";
-    ss << "       process(str);  // Just a reference\n";
-    ss << "   }\n";
-    ss << "   ```\n\n";
-    ss << "2. **Non-const reference** - For modifications:\n";
-    ss << "   ```cpp\n";
-    ss << "   for (auto& element : container) {\n";
-    ss << "       element.modify();  // Modify in place\n";
-    ss << "   }\n";
-    ss << "   ```\n\n";
-    ss << "3. **Move semantics** - For consuming elements:\n";
-    ss << "   ```cpp\n";
-    ss << "   std::vector<std::string> results;\n";
-    ss << "   for (auto&& str : container) {\n";
-    ss << "       results.push_back(std::move(str));  // Move, not copy\n";
-    ss << "   }\n";
-    ss << "   ```\n\n";
-    ss << "4. **Performance analysis** - Measure impact:\n";
-    ss << "   ```cpp\n";
-    ss << "   #include <chrono>\n";
-    ss << "   auto start = std::chrono::high_resolution_clock::now();\n";
-    ss << "   for (const auto& item : container) { /* ... */ }\n";
-    ss << "   auto end = std::chrono::high_resolution_clock::now();\n";
-    ss << "   auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);\n";
-    ss << "   ```";
+/**
+ * 一批问题合并为一个提示词, 回答按 "### Issue N" 拆分
+ */
+std::vector<std::string> OpenAIProvider::generateSuggestions(const std::vector<Issue>& issues) {
+    if (issues.empty()) {
+        return {};
+    }
+    std::string content;
+    if (!complete(buildPrompt(issues), content)) {
+        return std::vector<std::string>(issues.size());
+    }
+    return splitAnswers(content, issues.size());
+}
 
-    return ss.str();
+/**
+ * 检查提供者是否可用
+ * 要求配置了受支持的 http:// 接口地址 (本地服务不需要 API 密钥)
+ */
+bool OpenAIProvider::isAvailable() const {
+    return HttpClient::isSupportedUrl(options_.endpoint);
 }
 
-std::string RuleBasedProvider::generateGenericSuggestion(const Issue& issue) {
+/**
+ * 按实际要发送的请求体估计令牌数, 再为每个问题的回答预留固定额度
+ */
+size_t OpenAIProvider::estimateTokens(const std::vector<Issue>& issues) const {
+    size_t body_bytes = buildRequestBody(buildPrompt(issues)).size();
+    return (body_bytes + kBytesPerToken - 1) / kBytesPerToken + kAnswerTokensPerIssue * issues.size();
+}
+
+/**
+ * 构建多问题提示词
+ * 包含每个问题的规则、严重性、位置、描述和代码片段
+ */
+std::string OpenAIProvider::buildPrompt(const std::vector<Issue>& issues) const {
     std::stringstream ss;
-    ss << "🤖 AI-Enhanced Analysis:\n\n";
-    ss << "Based on the detected issue, consider these general best practices:\n\n";
-    ss << "1. **Code Review**: Have a colleague review this code section\n";
-    ss << "2. **Unit Tests**: Add tests to verify the fix works correctly\n";
-    ss << "3. **Documentation**: Update code comments if behavior changes\n";
-    ss << "4. **Static Analysis**: Run additional tools to catch related issues\n\n";
-    ss << "For more specific guidance, consult:\n";
-    ss << "- C++ Core Guidelines: https://isocpp.github.io/CppCoreGuidelines/\n";
-    ss << "- Your team's coding standards\n";
-    ss << "- Language-specific best practices";
+    ss << "Analyze the following " << issues.size() << " C++ issue(s) and provide a fix for each.\n";
+    ss << "For every issue give a short explanation, step-by-step fix instructions and a corrected code example.\n";
+    ss << "Answer the issues in order and start each answer with a line \"### Issue <n>\".\n\n";
+
+    for (size_t i = 0; i < issues.size(); ++i) {
+        const Issue& issue = issues[i];
+        ss << "### Issue " << (i + 1) << "\n";
+        ss << "Issue Type: " << issue.rule_id << "\n";
+        ss << "Severity: " << severityName(issue.severity) << "\n";
+        ss << "Location: " << issue.file_path << ":" << issue.line << "\n";
+        ss << "Description: " << issue.description << "\n";
+        if (!issue.code_snippet.empty()) {
+            ss << "Code Context:\n```cpp\n" << issue.code_snippet << "\n```\n";
+        }
+        ss << "\n";
+    }
 
     return ss.str();
 }
 
-// ============================================================================
-// OpenAIProvider Implementation (Placeholder)
-// ============================================================================
-
-std::string OpenAIProvider::generateSuggestion(const Issue& issue, const std::string& code_context) {
-    if (!isAvailable()) {
-        return "OpenAI API not configured. Set OPENAI_API_KEY environment variable.";
-    }
-
-    // TODO: Actual OpenAI API integration
-    // This is a placeholder for future implementation
+std::string OpenAIProvider::buildRequestBody(const std::string& prompt) const {
     std::stringstream ss;
-    ss << "🤖 OpenAI Integration (Not Implemented):\n\n";
-    ss << "To enable OpenAI-powered suggestions:\n";
-    ss << "1. Set OPENAI_API_KEY environment variable\n";
-    ss << "2. Install HTTP client library (e.g., libcurl)\n";
-    ss << "3. Implement API call to GPT-4\n\n";
-    ss << "Prompt would be:\n";
-    ss << buildPrompt(issue, code_context);
-
+    ss << "{\"model\":";
+    JSONUtils::writeString(ss, options_.model);
+    ss << ",\"temperature\":0.2,\"messages\":[{\"role\":\"system\",\"content\":";
+    JSONUtils::writeString(ss, "You are a C++ code review expert.");
+    ss << "},{\"role\":\"user\",\"content\":";
+    JSONUtils::writeString(ss, prompt);
+    ss << "}]}";
     return ss.str();
 }
 
 /**
- * 检查 OpenAI 提供者是否可用
- * 要求配置了有效的 API 密钥
+ * 发送 chat/completions 请求
+ * 网络错误和可重试的状态码按退避重试, 其他错误立即放弃;
+ * 每次尝试的超时不超过截止时间, 重试等待会越过截止时间时放弃
  */
-bool OpenAIProvider::isAvailable() const {
-    // 检查是否设置了 API 密钥
-    return !api_key_.empty() && api_key_ != "none";
+bool OpenAIProvider::complete(const std::string& prompt, std::string& content) {
+    std::string body = buildRequestBody(prompt);
+    std::vector<std::pair<std::string, std::string>> headers;
+    if (!options_.api_key.empty()) {
+        headers.emplace_back("Authorization", "Bearer " + options_.api_key);
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const bool has_deadline = options_.deadline != Clock::time_point::max();
+
+    std::string error;
+    for (int attempt = 0; attempt <= options_.max_retries; ++attempt) {
+        int timeout_ms = options_.timeout_ms;
+        if (has_deadline) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                options_.deadline - Clock::now()).count();
+            if (remaining <= 0) {
+                error = "time budget exhausted";
+                break;
+            }
+            timeout_ms = static_cast<int>(std::min<long long>(timeout_ms, remaining));
+        }
+
+        ++requests_;
+        auto response = HttpClient::post(options_.endpoint, body, headers, timeout_ms, error);
+
+        std::string retry_after;
+        if (response) {
+            if (response->status == 200) {
+                if (JSONUtils::findString(response->body, "content", content)) {
+                    return true;
+                }
+                error = "response has no message content";
+                break;
+            }
+            error = "HTTP " + std::to_string(response->status);
+            if (!isRetryableStatus(response->status)) {
+                break;
+            }
+            retry_after = response->header("retry-after");
+        }
+
+        if (attempt < options_.max_retries) {
+            auto delay = backoffDelay(attempt, retry_after);
+            if (has_deadline && Clock::now() + delay >= options_.deadline) {
+                break;
+            }
+            std::this_thread::sleep_for(delay);
+        }
+    }
+
+    // 只报告第一次失败, 避免每个批次都输出一遍
+    if (failed_requests_++ == 0) {
+        std::cerr << "Warning: LLM request to " << options_.endpoint << " failed (" << error
+                  << "), falling back to rule-based suggestions\n";
+    }
+    return false;
 }
 
-/**
- * 构建发送给 OpenAI 的提示词
- * 包含问题详情、严重性、代码上下文等
- */
-std::string OpenAIProvider::buildPrompt(const Issue& issue, const std::string& code_context) {
-    std::stringstream ss;
-    ss << "You are a C++ code review expert. Analyze this issue and provide a detailed fix:\n\n";
-    ss << "Issue Type: " << issue.rule_id << "\n";
-    ss << "Severity: ";
-    switch (issue.severity) {
-        case Severity::CRITICAL: ss << "CRITICAL"; break;
-        case Severity::HIGH: ss << "HIGH"; break;
-        case Severity::MEDIUM: ss << "MEDIUM"; break;
-        case Severity::LOW: ss << "LOW"; break;
-        case Severity::SUGGESTION: ss << "SUGGESTION"; break;
+std::vector<std::string> OpenAIProvider::splitAnswers(const std::string& content, size_t count) {
+    std::vector<std::string> answers(count);
+
+    // 找到每个 "### Issue N" 标记的位置
+    std::vector<std::pair<size_t, size_t>> markers;  // (标记所在行的起点, 问题序号)
+    const std::string marker = "### Issue ";
+    for (size_t pos = content.find(marker); pos != std::string::npos;
+         pos = content.find(marker, pos + marker.size())) {
+        if (pos != 0 && content[pos - 1] != '\n') continue;
+        size_t number = std::strtoul(content.c_str() + pos + marker.size(), nullptr, 10);
+        if (number >= 1 && number <= count) {
+            markers.emplace_back(pos, number - 1);
+        }
     }
-    ss << "\n";
-    ss << "Description: " << issue.description << "\n\n";
-    if (!code_context.empty()) {
-        ss << "Code Context:\n" << code_context << "\n\n";
+
+    if (markers.empty()) {
+        // 单个问题的回答可以不带标记
+        if (count == 1) {
+            answers[0] = content;
+        }
+        return answers;
     }
-    ss << "Provide:\n";
-    ss << "1. Detailed explanation of the issue\n";
-    ss << "2. Step-by-step fix instructions\n";
-    ss << "3. Complete corrected code example\n";
-    ss << "4. Best practices to prevent similar issues\n";
 
-    return ss.str();
+    for (size_t i = 0; i < markers.size(); ++i) {
+        size_t begin = content.find('\n', markers[i].first);
+        size_t end = i + 1 < markers.size() ? markers[i + 1].first : content.size();
+        if (begin == std::string::npos || begin >= end) continue;
+        std::string answer = content.substr(begin + 1, end - begin - 1);
+        while (!answer.empty() && (answer.back() == '\n' || answer.back() == ' ')) {
+            answer.pop_back();
+        }
+        if (!answer.empty()) {
+            answers[markers[i].second] = "🤖 AI-Enhanced Fix Strategy:\n\n" + answer;
+        }
+    }
+    return answers;
 }
 
 // ============================================================================
 // LLMEnhancer 实现 - LLM 增强器
 // ============================================================================
 
-LLMEnhancer::LLMEnhancer(std::shared_ptr<LLMProvider> provider)
-    : provider_(std::move(provider)) {}
+LLMEnhancer::LLMEnhancer(std::shared_ptr<LLMProvider> provider, size_t max_in_flight)
+    : provider_(std::move(provider)), max_in_flight_(std::max<size_t>(1, max_in_flight)) {}
+
+LLMEnhancer::~LLMEnhancer() {
+    finish();
+}
 
 /**
  * 使用 LLM 生成的建议增强单个问题
- * 将 AI 建议追加到原有建议后面
+ * AI 建议以共享文本的形式附加, 输出时排在原有建议之后
  */
 Issue LLMEnhancer::enhanceIssue(const Issue& issue, const std::string& code_context) {
     Issue enhanced = issue;
 
     if (isEnabled()) {
+        std::string_view fixed = provider_->getStaticSuggestion(issue);
+        if (!fixed.empty()) {
+            attach(enhanced, {fixed, nullptr});
+            return enhanced;
+        }
+
         // 生成 AI 增强的建议
         std::string ai_suggestion = provider_->generateSuggestion(issue, code_context);
+        attach(enhanced, ai_suggestion.empty() ? fallbackFor(issue) : share(std::move(ai_suggestion)));
+    }
+
+    return enhanced;
+}
+
+LLMEnhancer::SharedSuggestion LLMEnhancer::share(std::string text) {
+    auto owner = std::make_shared<const std::string>(std::move(text));
+    return {std::string_view(*owner), owner};
+}
 
-        // 追加到现有建议后
-        if (!enhanced.suggestion.empty()) {
-            enhanced.suggestion += "\n\n" + std::string(70, '=') + "\n";
+LLMEnhancer::SharedSuggestion LLMEnhancer::fallbackFor(const Issue& issue) {
+    std::string_view fixed = fallback_.getStaticSuggestion(issue);
+    if (!fixed.empty()) {
+        return {fixed, nullptr};
+    }
+    return share(fallback_.generateSuggestion(issue, issue.code_snippet));
+}
+
+void LLMEnhancer::attach(Issue& issue, const SharedSuggestion& suggestion) {
+    issue.ai_suggestion = suggestion.text;
+    issue.ai_suggestion_owner = suggestion.owner;
+}
+
+void LLMEnhancer::start() {
+    if (!isEnabled()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!workers_.empty() || closed_) {
+        return;
+    }
+    for (size_t i = 0; i < max_in_flight_; ++i) {
+        workers_.emplace_back([this] { workerLoop(); });
+    }
+}
+
+void LLMEnhancer::submit(const Issue& issue) {
+    if (!isEnabled()) {
+        return;
+    }
+    uint64_t fingerprint = Fingerprint::locationFingerprint(issue);
+    uint64_t group = clustering_ ? IssueClusterer::clusterKey(issue) : fingerprint;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_ || !group_of_.emplace(fingerprint, group).second) {
+            return;
+        }
+        // 每组只有第一个问题 (代表) 进入请求队列, 其余成员共享它的建议
+        if (!groups_.insert(group).second) {
+            return;
         }
-        enhanced.suggestion += ai_suggestion;
+        queue_.emplace(QueueKey(issue.severity, next_sequence_++), std::make_pair(group, issue));
     }
+    queue_cv_.notify_one();
+}
 
-    return enhanced;
+/**
+ * 后台请求线程
+ * 队列不足一批时最多等待 50ms 让分析线程补充问题, 队列关闭后立即发送剩余问题;
+ * 每批从队首 (严重性最高) 取问题, 估计令牌数超过当前窗口余量时把队尾的问题放回队列;
+ * 每分钟预算已满时整批放回并等到窗口有余量, 时间预算用完后剩余问题直接使用规则建议
+ */
+void LLMEnhancer::workerLoop() {
+    const size_t batch_size = std::max<size_t>(1, provider_->getBatchSize());
+    const auto linger = std::chrono::milliseconds(50);
+
+    for (;;) {
+        std::vector<Issue> batch;
+        std::vector<QueueKey> order;
+        std::vector<uint64_t> groups;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            queue_cv_.wait(lock, [&] { return closed_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return;
+            }
+            if (queue_.size() < batch_size && !closed_) {
+                queue_cv_.wait_for(lock, linger, [&] { return closed_ || queue_.size() >= batch_size; });
+                if (queue_.empty()) {
+                    continue;
+                }
+            }
+            size_t count = std::min(batch_size, queue_.size());
+            for (size_t i = 0; i < count; ++i) {
+                auto front = queue_.begin();
+                order.push_back(front->first);
+                groups.push_back(front->second.first);
+                batch.push_back(std::move(front->second.second));
+                queue_.erase(front);
+            }
+        }
+
+        // 静态建议和缓存命中的问题不需要请求, 其余问题合并为一个请求
+        std::optional<RequestBudget::Clock::time_point> wait_until;
+        std::vector<SharedSuggestion> suggestions(batch.size());
+        std::vector<bool> resolved(batch.size(), true);
+        std::vector<size_t> pending;
+        std::vector<uint64_t> keys(batch.size());
+        const std::string identity = cache_ ? provider_->getCacheIdentity() : "";
+        for (size_t i = 0; i < batch.size(); ++i) {
+            std::string_view fixed = provider_->getStaticSuggestion(batch[i]);
+            if (!fixed.empty()) {
+                suggestions[i] = {fixed, nullptr};
+                continue;
+            }
+            if (cache_) {
+                keys[i] = SuggestionCache::makeKey(batch[i], identity);
+                if (auto cached = cache_->lookup(keys[i])) {
+                    suggestions[i] = share(std::move(*cached));
+                    ++cache_hits_;
+                    continue;
+                }
+            }
+            pending.push_back(i);
+        }
+
+        if (!pending.empty()) {
+            std::vector<Issue> request;
+            request.reserve(pending.size());
+            for (size_t i : pending) {
+                request.push_back(batch[i]);
+            }
+
+            // 令牌不够整批时缩小批次, 放回的问题保留原来的排序键
+            size_t tokens = provider_->estimateTokens(request);
+            size_t available = budget_.availableTokens();
+            while (request.size() > 1 && tokens > available) {
+                resolved[pending.back()] = false;
+                pending.pop_back();
+                request.pop_back();
+                tokens = provider_->estimateTokens(request);
+            }
+
+            RequestBudget::Clock::time_point retry_at;
+            auto grant = budget_.tryAcquire(tokens, retry_at);
+            if (grant == RequestBudget::Grant::WAIT) {
+                // 每分钟预算已满: 问题放回队列, 醒来后重新取严重性最高的问题
+                for (size_t i : pending) {
+                    resolved[i] = false;
+                }
+                wait_until = retry_at;
+            } else if (grant == RequestBudget::Grant::EXHAUSTED) {
+                // 时间预算用完: 不再请求, 改用规则建议 (不写入缓存)
+                for (size_t i : pending) {
+                    suggestions[i] = fallbackFor(batch[i]);
+                }
+                fallbacks_ += pending.size();
+                if (over_budget_.fetch_add(pending.size()) == 0) {
+                    std::cerr << "Warning: LLM time budget exhausted, "
+                              << "remaining issues use rule-based suggestions\n";
+                }
+            } else {
+                ++batches_;
+                auto started = RequestBudget::Clock::now();
+                std::vector<std::string> generated;
+                try {
+                    generated = provider_->generateSuggestions(request);
+                } catch (const std::exception& e) {
+                    std::cerr << "Warning: LLM provider error: " << e.what() << "\n";
+                }
+                budget_.recordLatency(RequestBudget::Clock::now() - started);
+                generated.resize(request.size());
+
+                for (size_t j = 0; j < pending.size(); ++j) {
+                    size_t i = pending[j];
+                    if (generated[j].empty()) {
+                        // 回退的规则建议不写入缓存, 下次运行仍会请求提供者
+                        suggestions[i] = fallbackFor(batch[i]);
+                        ++fallbacks_;
+                        continue;
+                    }
+                    if (cache_) {
+                        cache_->store(keys[i], generated[j]);
+                    }
+                    suggestions[i] = share(std::move(generated[j]));
+                }
+            }
+        }
+
+        bool requeued = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (size_t i = 0; i < batch.size(); ++i) {
+                if (resolved[i]) {
+                    suggestions_[groups[i]] = std::move(suggestions[i]);
+                } else {
+                    queue_.emplace(order[i], std::make_pair(groups[i], std::move(batch[i])));
+                    requeued = true;
+                }
+            }
+        }
+        if (requeued) {
+            queue_cv_.notify_one();
+        }
+        if (wait_until) {
+            std::this_thread::sleep_until(*wait_until);
+        }
+    }
+}
+
+void LLMEnhancer::finish() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    queue_cv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
 }
 
 /**
  * 增强报告器中的所有问题
- * 当前为占位符实现
+ * 流水线未启动时 (如 PR 差异模式) 在此启动, 只对最终报告中的问题请求建议
  */
 void LLMEnhancer::enhanceAllIssues(Reporter& reporter) {
     if (!isEnabled()) {
         return;
     }
 
-    // 需要 Reporter 提供修改问题的接口
-    // 当前为占位符
+    // 先全部入队再启动, 第一批就按严重性选取
+    for (const auto& issue : reporter.getIssues()) {
+        submit(issue);
+    }
+    start();
+    finish();
+
+    // 把每组代表的建议分发给组内所有问题
+    std::vector<Issue> issues = reporter.takeIssues();
+    for (auto& issue : issues) {
+        auto group = group_of_.find(Fingerprint::locationFingerprint(issue));
+        if (group == group_of_.end()) continue;
+        auto it = suggestions_.find(group->second);
+        if (it != suggestions_.end()) {
+            attach(issue, it->second);
+        }
+    }
+    reporter.replaceIssues(std::move(issues));
 }
 
 // ============================================================================
@@ -437,19 +885,19 @@ void LLMEnhancer::enhanceAllIssues(Reporter& reporter) {
 
 /**
  * 创建指定类型的 LLM 提供者
- * @param type 提供者类型 (基于规则/OpenAI/无)
- * @param config 配置字符串 (如 API 密钥)
+ * @param type 提供者类型 (基于规则/OpenAI 兼容接口/无)
+ * @param options LLM 阶段配置
  * @return LLM 提供者的共享指针
  */
-std::shared_ptr<LLMProvider> LLMProviderFactory::create(ProviderType type, const std::string& config) {
+std::shared_ptr<LLMProvider> LLMProviderFactory::create(ProviderType type, const LLMOptions& options) {
     switch (type) {
         case ProviderType::RULE_BASED:
             // 创建基于规则的提供者 (内置,无需配置)
             return std::make_shared<RuleBasedProvider>();
 
         case ProviderType::OPENAI:
-            // 创建 OpenAI 提供者 (需要 API 密钥)
-            return std::make_shared<OpenAIProvider>(config);
+            // 创建 OpenAI 兼容的 HTTP 提供者
+            return std::make_shared<OpenAIProvider>(options);
 
         case ProviderType::NONE:
         default:
@@ -458,4 +906,11 @@ std::shared_ptr<LLMProvider> LLMProviderFactory::create(ProviderType type, const
     }
 }
 
+std::optional<LLMProviderFactory::ProviderType> LLMProviderFactory::parseType(const std::string& name) {
+    if (name == "rule-based" || name == "rules") return ProviderType::RULE_BASED;
+    if (name == "openai" || name == "http" || name == "local") return ProviderType::OPENAI;
+    if (name == "none") return ProviderType::NONE;
+    return std::nullopt;
+}
+
 } // namespace cpp_review
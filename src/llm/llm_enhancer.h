@@ -5,18 +5,53 @@
  * 特性:
  * - 基于规则的内置智能系统 (无需外部 API)
  * - 7 种专门的规则处理器,提供详细的修复策略
- * - 支持未来扩展: OpenAI GPT, Anthropic Claude 等
+ * - OpenAI 兼容的 HTTP 提供者 (自托管模型或本地桩服务器)
  * - 插件化设计,易于添加新的 LLM 提供者
+ * - 增强作为流水线阶段与编译单元分析并行: 问题被报告器接收时入队,
+ *   后台按批合并请求, 并发请求数有上限, 失败时指数退避重试
+ * - 请求按严重性排队 (CRITICAL 先请求), 受每分钟请求数/令牌数和运行时间预算约束,
+ *   时间预算用完后剩余问题改用规则建议, 增强不会拖住报告
  */
 
 #pragma once
 
 #include "report/reporter.h"
+#include "cache/suggestion_cache.h"
+#include "llm/request_budget.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace cpp_review {
 
+/**
+ * LLM 阶段的配置
+ */
+struct LLMOptions {
+    std::string endpoint = "http://localhost:8080/v1/chat/completions";  // OpenAI 兼容接口地址
+    std::string model = "gpt-4o-mini";   // 模型名称
+    std::string api_key;                 // API 密钥 (本地服务可为空)
+    size_t batch_size = 8;               // 每个请求合并的问题数
+    size_t max_in_flight = 4;            // 同时进行的请求数上限
+    int max_retries = 3;                 // 失败后的重试次数
+    int timeout_ms = 60000;              // 单次请求超时 (毫秒)
+    size_t requests_per_minute = 0;      // 每分钟请求数上限 (0 表示不限)
+    size_t tokens_per_minute = 0;        // 每分钟令牌数上限 (0 表示不限)
+    // 截止时间: 之后不再发送请求, 进行中的请求也在此前结束
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+};
+
 /**
  * LLM 提供者接口
  * 定义所有 LLM 提供者必须实现的接口
@@ -34,6 +69,37 @@ public:
      */
     virtual std::string generateSuggestion(const Issue& issue, const std::string& code_context) = 0;
 
+    /**
+     * 为一批问题生成建议
+     * 默认逐个调用 generateSuggestion (以代码片段为上下文);
+     * 远程提供者把一批问题合并为一个多问题提示词, 只发一次请求
+     * @param issues 问题列表
+     * @return 与 issues 一一对应的建议, 空字符串表示该问题生成失败
+     */
+    virtual std::vector<std::string> generateSuggestions(const std::vector<Issue>& issues);
+
+    /**
+     * 单个请求建议合并的问题数 (1 表示不合并)
+     */
+    virtual size_t getBatchSize() const { return 1; }
+
+    /**
+     * 估计一个请求消耗的令牌数 (提示词 + 预期回答), 用于每分钟令牌预算
+     * @return 不消耗令牌的本地提供者返回 0
+     */
+    virtual size_t estimateTokens(const std::vector<Issue>& /*issues*/) const { return 0; }
+
+    /**
+     * 只取决于规则的建议: 返回指向静态存储的文本, 所有问题共享, 不分配内存
+     * @return 建议依赖问题的其他信息时返回空视图, 调用方改用 generateSuggestion
+     */
+    virtual std::string_view getStaticSuggestion(const Issue& /*issue*/) const { return {}; }
+
+    /**
+     * 建议缓存使用的提供者标识: 同一标识下相同规则和代码片段的建议可以复用
+     */
+    virtual std::string getCacheIdentity() const { return getName(); }
+
     /**
      * 检查提供者是否可用/已配置
      * @return 如果提供者可用返回 true
@@ -49,6 +115,7 @@ public:
 
 /**
  * 基于规则的智能提供者 (内置,无需外部 API)
+ * 建议文本是按规则 ID 索引的编译期常量表, 问题直接引用表中的文本, 不逐个构造字符串
  *
  * 特性:
  * - 7 种专门的规则处理器
@@ -68,51 +135,84 @@ public:
 class RuleBasedProvider : public LLMProvider {
 public:
     std::string generateSuggestion(const Issue& issue, const std::string& code_context) override;
+    std::string_view getStaticSuggestion(const Issue& issue) const override;
     bool isAvailable() const override { return true; }
     std::string getName() const override { return "Rule-Based Intelligence"; }
 
 private:
-    // 7 个专门的建议生成器
-    std::string generateNullPointerSuggestion(const Issue& issue);
-    std::string generateMemoryLeakSuggestion(const Issue& issue);
-    std::string generateBufferOverflowSuggestion(const Issue& issue);
-    std::string generateIntegerOverflowSuggestion(const Issue& issue);
-    std::string generateUseAfterFreeSuggestion(const Issue& issue);
-    std::string generateSmartPointerSuggestion(const Issue& issue);
-    std::string generateLoopCopySuggestion(const Issue& issue);
-    std::string generateGenericSuggestion(const Issue& issue);
+    // 替换建议模板中的 {{...}} 占位符
+    static std::string expandPlaceholders(std::string_view text, const Issue& issue);
 };
 
 /**
- * OpenAI 提供者 (未来功能)
- * 占位符,用于未来集成 OpenAI GPT API
+ * OpenAI 兼容的 HTTP 提供者
+ * 向可配置的 chat/completions 接口发送多问题提示词,
+ * 可以指向自托管模型、本地桩服务器或本机的 TLS 代理
  *
- * 计划功能:
- * - HTTP 客户端集成
- * - GPT-4 API 调用
- * - 上下文感知的代码建议
- * - 自动代码修复
+ * - 网络错误、408/429/5xx 响应按指数退避 (带抖动) 重试, 遵守 Retry-After
+ * - 请求超时和重试等待不超过 LLMOptions::deadline
+ * - 重试耗尽或响应中缺少某个问题的回答时, 对应建议为空, 由增强器回退到规则建议
  */
 class OpenAIProvider : public LLMProvider {
 public:
-    explicit OpenAIProvider(const std::string& api_key) : api_key_(api_key) {}
+    explicit OpenAIProvider(LLMOptions options) : options_(std::move(options)) {}
 
     std::string generateSuggestion(const Issue& issue, const std::string& code_context) override;
+    std::vector<std::string> generateSuggestions(const std::vector<Issue>& issues) override;
+    size_t getBatchSize() const override { return options_.batch_size; }
+    size_t estimateTokens(const std::vector<Issue>& issues) const override;
+    std::string getCacheIdentity() const override {
+        return std::string("openai/") + options_.model + "/" + kPromptVersion;
+    }
     bool isAvailable() const override;
-    std::string getName() const override { return "OpenAI GPT"; }
+    std::string getName() const override { return "OpenAI-compatible (" + options_.model + ")"; }
+
+    // 已发送的请求数 (含重试)
+    size_t getRequestCount() const { return requests_; }
+
+    // 最终失败的请求数
+    size_t getFailedRequestCount() const { return failed_requests_; }
+
+    // 提示词版本: 修改提示词或回答格式时递增, 使已缓存的建议失效
+    static constexpr const char* kPromptVersion = "prompt-v1";
 
 private:
-    std::string api_key_;
-    std::string buildPrompt(const Issue& issue, const std::string& code_context);
+    LLMOptions options_;
+    std::atomic<size_t> requests_{0};
+    std::atomic<size_t> failed_requests_{0};
+
+    std::string buildPrompt(const std::vector<Issue>& issues) const;
+    std::string buildRequestBody(const std::string& prompt) const;
+
+    // 发送请求 (含重试), 返回模型回答的文本; 失败时返回 false
+    bool complete(const std::string& prompt, std::string& content);
+
+    // 按 "### Issue N" 标记把回答拆分到各个问题
+    static std::vector<std::string> splitAnswers(const std::string& content, size_t count);
 };
 
 /**
  * LLM 增强器
  * 协调 LLM 提供者,为问题添加智能建议
+ *
+ * 流水线用法: start() 启动后台请求线程, 分析过程中 submit() 每个被接收的问题,
+ * 分析结束后 enhanceAllIssues() 等待剩余请求并把建议写回报告器中的问题。
+ * 同一位置指纹的问题只请求一次, 相似问题聚类后只请求代表 (见 IssueClusterer);
+ * 提供者失败的问题回退到基于规则的建议;
+ * 设置建议缓存后, 命中的问题不再请求提供者;
+ * 队列按严重性排序, 设置预算后每个请求先向预算申请, 申请失败 (时间预算用完) 的问题回退到规则建议
  */
 class LLMEnhancer {
 public:
-    explicit LLMEnhancer(std::shared_ptr<LLMProvider> provider);
+    /**
+     * @param provider LLM 提供者
+     * @param max_in_flight 同时进行的请求数上限 (后台线程数)
+     */
+    explicit LLMEnhancer(std::shared_ptr<LLMProvider> provider, size_t max_in_flight = 1);
+    ~LLMEnhancer();
+
+    LLMEnhancer(const LLMEnhancer&) = delete;
+    LLMEnhancer& operator=(const LLMEnhancer&) = delete;
 
     /**
      * 使用 LLM 生成的建议增强单个问题
@@ -122,8 +222,20 @@ public:
      */
     Issue enhanceIssue(const Issue& issue, const std::string& code_context = "");
 
+    /**
+     * 启动后台请求线程 (重复调用无效)
+     */
+    void start();
+
+    /**
+     * 提交一个已解析位置的问题 (线程安全, 不阻塞)
+     * 后台线程攒够一批或短暂等待后发送请求
+     */
+    void submit(const Issue& issue);
+
     /**
      * 增强报告器中的所有问题
+     * 未提交过的问题在此补充提交; 等待所有请求完成后让各问题引用共享的建议文本 (ai_suggestion)
      * @param reporter 包含问题的报告器
      */
     void enhanceAllIssues(Reporter& reporter);
@@ -142,8 +254,97 @@ public:
         return provider_ ? provider_->getName() : "None";
     }
 
+    /**
+     * 设置磁盘建议缓存 (按规则 ID + 规范化代码片段 + 提供者标识复用建议)
+     * 必须在 start() 之前调用
+     */
+    void setSuggestionCache(std::shared_ptr<SuggestionCache> cache) { cache_ = std::move(cache); }
+
+    /**
+     * 设置是否聚类相似问题 (默认开启): 规则、规范化描述和代码片段记号形状都相同的问题
+     * 只请求一次, 建议分发给所有成员; 关闭时每个位置单独请求。必须在 start() 之前调用
+     */
+    void setClustering(bool enabled) { clustering_ = enabled; }
+
+    /**
+     * 设置请求预算 (每分钟请求数、令牌数和截止时间, 见 LLMOptions), 必须在 start() 之前调用
+     */
+    void setBudget(const LLMOptions& options) {
+        budget_.configure(options.requests_per_minute, options.tokens_per_minute, options.deadline);
+    }
+
+    // 已提交的问题数
+    size_t getIssueCount() const { return group_of_.size(); }
+
+    // 问题分组数 (实际需要建议的代表数)
+    size_t getClusterCount() const { return groups_.size(); }
+
+    // 发给提供者的批次数
+    size_t getBatchCount() const { return batches_; }
+
+    // 命中建议缓存的问题数
+    size_t getCacheHitCount() const { return cache_hits_; }
+
+    // 回退到规则建议的问题数
+    size_t getFallbackCount() const { return fallbacks_; }
+
+    // 因时间预算用完而回退到规则建议的问题数 (包含在 getFallbackCount 中)
+    size_t getOverBudgetCount() const { return over_budget_; }
+
+    // 等待请求的问题组数 (加锁, 供指标端点在运行中查询)
+    size_t getQueueDepth() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queue_.size();
+    }
+
+    // 请求预算 (统计等待次数和估计令牌数)
+    const RequestBudget& getBudget() const { return budget_; }
+
 private:
+    // 后台线程: 取一批问题, 调用提供者, 记录建议
+    void workerLoop();
+
+    // 关闭队列并等待后台线程结束
+    void finish();
+
+    // 共享的建议文本: 静态表中的文本只保存视图, 动态生成的文本由 owner 持有
+    struct SharedSuggestion {
+        std::string_view text;
+        std::shared_ptr<const std::string> owner;
+    };
+
+    // 把动态生成的文本转为共享文本
+    static SharedSuggestion share(std::string text);
+
+    // 提供者失败时的规则建议 (优先使用静态文本)
+    SharedSuggestion fallbackFor(const Issue& issue);
+
+    // 让问题引用共享的 AI 建议 (不复制文本)
+    static void attach(Issue& issue, const SharedSuggestion& suggestion);
+
     std::shared_ptr<LLMProvider> provider_;  // LLM 提供者实例
+    RuleBasedProvider fallback_;             // 提供者失败时的回退
+    std::shared_ptr<SuggestionCache> cache_; // 磁盘建议缓存 (可选)
+    RequestBudget budget_;                   // 每分钟请求数/令牌数和时间预算
+    size_t max_in_flight_;
+
+    // 请求队列的排序键: (严重性, 提交序号), 严重性高的先请求, 同级按提交顺序
+    using QueueKey = std::pair<Severity, uint64_t>;
+
+    std::mutex mutex_;
+    std::condition_variable queue_cv_;
+    bool clustering_ = true;                                // 是否聚类相似问题
+    std::map<QueueKey, std::pair<uint64_t, Issue>> queue_;  // 待请求的 (组键, 代表问题)
+    uint64_t next_sequence_ = 0;
+    std::unordered_map<uint64_t, uint64_t> group_of_;       // 已提交问题的位置指纹 -> 组键
+    std::unordered_set<uint64_t> groups_;                   // 已入队的组键
+    std::unordered_map<uint64_t, SharedSuggestion> suggestions_; // 组键 -> 建议
+    bool closed_ = false;
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> batches_{0};
+    std::atomic<size_t> fallbacks_{0};
+    std::atomic<size_t> cache_hits_{0};
+    std::atomic<size_t> over_budget_{0};
 };
 
 /**
@@ -157,17 +358,23 @@ public:
      */
     enum class ProviderType {
         RULE_BASED,  // 基于规则的内置系统
-        OPENAI,      // OpenAI GPT (未来)
+        OPENAI,      // OpenAI 兼容的 HTTP 接口
         NONE         // 禁用 LLM 功能
     };
 
     /**
      * 创建 LLM 提供者
      * @param type 提供者类型
-     * @param config 配置字符串 (如 API 密钥)
+     * @param options LLM 阶段配置 (接口地址、模型、API 密钥等)
      * @return LLM 提供者的共享指针
      */
-    static std::shared_ptr<LLMProvider> create(ProviderType type, const std::string& config = "");
+    static std::shared_ptr<LLMProvider> create(ProviderType type, const LLMOptions& options = LLMOptions());
+
+    /**
+     * 解析提供者名称: "rule-based" / "openai" (或 "http", "local") / "none"
+     * @return 未知名称时返回 std::nullopt
+     */
+    static std::optional<ProviderType> parseType(const std::string& name);
 };
 
 } // namespace cpp_review
@@ -0,0 +1,96 @@
+/*
+ * LLM 请求预算实现
+ */
+
+#include "llm/request_budget.h"
+#include <cstdint>
+
+namespace cpp_review {
+
+namespace {
+
+constexpr auto kWindow = std::chrono::minutes(1);
+
+} // namespace
+
+void RequestBudget::configure(size_t requests_per_minute, size_t tokens_per_minute,
+                              Clock::time_point deadline) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    requests_per_minute_ = requests_per_minute;
+    tokens_per_minute_ = tokens_per_minute;
+    deadline_ = deadline;
+}
+
+void RequestBudget::prune(Clock::time_point now) {
+    while (!window_.empty() && now - window_.front().first >= kWindow) {
+        window_.pop_front();
+    }
+}
+
+size_t RequestBudget::windowTokens() const {
+    size_t used = 0;
+    for (const auto& entry : window_) {
+        used += entry.second;
+    }
+    return used;
+}
+
+bool RequestBudget::fitsBeforeDeadline(Clock::time_point now) const {
+    if (deadline_ == Clock::time_point::max()) {
+        return true;
+    }
+    return now < deadline_ && deadline_ - now > average_latency_;
+}
+
+size_t RequestBudget::availableTokens() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tokens_per_minute_ == 0) {
+        return SIZE_MAX;
+    }
+    prune(Clock::now());
+    size_t used = windowTokens();
+    return used >= tokens_per_minute_ ? 0 : tokens_per_minute_ - used;
+}
+
+/**
+ * 请求数和令牌数都在窗口上限内时放行;
+ * 否则在最早的记录移出窗口时重试, 该时刻已来不及完成请求时视为时间预算用完
+ */
+RequestBudget::Grant RequestBudget::tryAcquire(size_t tokens, Clock::time_point& retry_at) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Clock::time_point now = Clock::now();
+    if (!fitsBeforeDeadline(now)) {
+        return Grant::EXHAUSTED;
+    }
+    prune(now);
+
+    bool requests_ok = requests_per_minute_ == 0 || window_.size() < requests_per_minute_;
+    bool tokens_ok = tokens_per_minute_ == 0 || window_.empty() ||
+                     windowTokens() + tokens <= tokens_per_minute_;
+    if (requests_ok && tokens_ok) {
+        window_.emplace_back(now, tokens);
+        tokens_ += tokens;
+        return Grant::GRANTED;
+    }
+
+    retry_at = window_.front().first + kWindow;
+    if (!fitsBeforeDeadline(retry_at)) {
+        return Grant::EXHAUSTED;
+    }
+    ++waits_;
+    return Grant::WAIT;
+}
+
+/**
+ * 平均耗时使用指数移动平均, 较新的请求权重更大
+ */
+void RequestBudget::recordLatency(Clock::duration elapsed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (average_latency_ == Clock::duration::zero()) {
+        average_latency_ = elapsed;
+    } else {
+        average_latency_ = (average_latency_ * 7 + elapsed * 3) / 10;
+    }
+}
+
+} // namespace cpp_review
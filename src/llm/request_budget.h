@@ -0,0 +1,89 @@
+/*
+ * LLM 请求预算头文件
+ * 外部或自托管模型通常限制每分钟的请求数和令牌数, CI 的运行时间也有硬上限。
+ * 增强器在每次请求提供者之前向预算申请, 预算不足时等待, 时间快用完时放弃请求
+ *
+ * - 每分钟预算使用 60 秒滑动窗口, 记录每个请求的发送时间和估计令牌数
+ * - 窗口已满时告诉调用方何时重试 (最早的请求移出窗口的时刻), 调用方先把问题放回队列,
+ *   醒来后重新按严重性取问题; 重试时刻越过截止时间时直接放弃
+ * - 截止时间前预留最近请求的平均耗时, 不发送在截止时间前完不成的请求
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace cpp_review {
+
+/**
+ * 请求预算 (线程安全, 可被多个请求线程同时使用)
+ * 默认不限制请求数、令牌数和时间
+ */
+class RequestBudget {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * 申请结果
+     */
+    enum class Grant {
+        GRANTED,    // 可以发送, 已记入窗口
+        WAIT,       // 每分钟预算已满, 在 retry_at 之后重试
+        EXHAUSTED   // 时间预算用完, 不应再发送请求
+    };
+
+    /**
+     * 设置预算
+     * @param requests_per_minute 每分钟请求数上限 (0 表示不限)
+     * @param tokens_per_minute 每分钟令牌数上限 (0 表示不限)
+     * @param deadline 截止时间 (Clock::time_point::max() 表示不限)
+     */
+    void configure(size_t requests_per_minute, size_t tokens_per_minute, Clock::time_point deadline);
+
+    /**
+     * 当前窗口内还可使用的令牌数 (不限制令牌数时为 SIZE_MAX)
+     */
+    size_t availableTokens();
+
+    /**
+     * 申请发送一个估计消耗 tokens 个令牌的请求 (不阻塞)
+     * 超过每分钟上限的单个请求在窗口为空时放行, 不会永远等待
+     * @param retry_at 输出: 返回 WAIT 时的重试时刻
+     */
+    Grant tryAcquire(size_t tokens, Clock::time_point& retry_at);
+
+    /**
+     * 记录一个请求的耗时, 用于估计剩余时间是否足够
+     */
+    void recordLatency(Clock::duration elapsed);
+
+    // 申请返回 WAIT 的次数
+    size_t getWaitCount() const { return waits_; }
+
+    // 已申请的估计令牌总数
+    size_t getTokenCount() const { return tokens_; }
+
+private:
+    // 移除窗口中超过 60 秒的记录 (调用方持有锁)
+    void prune(Clock::time_point now);
+    // 窗口内已使用的令牌数 (调用方持有锁)
+    size_t windowTokens() const;
+    // now 时刻开始的请求能否在截止时间前完成 (调用方持有锁)
+    bool fitsBeforeDeadline(Clock::time_point now) const;
+
+    std::mutex mutex_;
+    size_t requests_per_minute_ = 0;
+    size_t tokens_per_minute_ = 0;
+    Clock::time_point deadline_ = Clock::time_point::max();
+    std::deque<std::pair<Clock::time_point, size_t>> window_;  // (发送时间, 估计令牌数)
+    Clock::duration average_latency_ = Clock::duration::zero();
+
+    size_t waits_ = 0;
+    size_t tokens_ = 0;
+};
+
+} // namespace cpp_review
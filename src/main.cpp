@@ -27,20 +27,274 @@
 // 报告生成器
 #include "report/reporter.h"
 #include "report/html_reporter.h"
+#include "report/baseline.h"
+#include "report/fingerprint.h"
+#include "report/sarif_writer.h"
+#include "report/issue_diff.h"
+#include "report/run_stats.h"
+#include "report/hw_counters.h"
+#include "report/metrics.h"
+#include "report/metrics_server.h"
 // 配置管理
 #include "config/config.h"
+#include "config/rule_scope.h"
+// 结果缓存
+#include "cache/result_cache.h"
+#include "cache/suggestion_cache.h"
 // Git 集成 (V1.5)
 #include "git/git_integration.h"
-
+#include "git/git_process.h"
+#include "git/git_blame.h"
+#include "git/revision_file_system.h"
+// 目录扫描
+#include "scan/directory_walker.h"
+#include "llm/llm_enhancer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
 #include <filesystem>
 #include <sstream>
 #include <fstream>
+#include <optional>
+#include <thread>
+
+namespace cpp_review {
+namespace {
+
+/**
+ * 规则是否需要注册
+ * 全局禁用的规则只有在某个路径覆盖中重新启用时才注册
+ */
+bool ruleWanted(const Config& config, const std::string& rule_id) {
+    if (config.disabled_rules.find(rule_id) == config.disabled_rules.end()) {
+        return true;
+    }
+    for (const auto& override_settings : config.overrides) {
+        if (override_settings.enabled_rules.count(rule_id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * 注册配置中未被禁用的所有检测规则
+ * 快速模式下跳过需要语义分析的规则
+ */
+void registerRules(RuleEngine& engine, const Config& config) {
+    // --fast 只注册可以在记号流上运行的词法级规则
+    auto add = [&](std::unique_ptr<Rule> rule) {
+        if (config.fast && rule->getTier() != RuleTier::LEXICAL) {
+            return;
+        }
+        engine.registerRule(std::move(rule));
+    };
+
+    // ===== V1.0 基础检测规则 =====
+    // 空指针解引用检测
+    if (ruleWanted(config, "NULL-PTR-001")) {
+        add(std::make_unique<NullPointerRule>());
+    }
+    // 未初始化变量检测
+    if (ruleWanted(config, "UNINIT-VAR-001")) {
+        add(std::make_unique<UninitializedVarRule>());
+    }
+    // 赋值/比较混淆检测
+    if (ruleWanted(config, "ASSIGN-COND-001")) {
+        add(std::make_unique<AssignmentInConditionRule>());
+    }
+    // 不安全 C 函数检测
+    if (ruleWanted(config, "UNSAFE-C-FUNC-001")) {
+        add(std::make_unique<UnsafeCFunctionsRule>());
+    }
+
+    // ===== V1.5 性能分析规则 =====
+    // 内存泄漏检测
+    if (ruleWanted(config, "MEMORY-LEAK-001")) {
+        add(std::make_unique<MemoryLeakRule>());
+    }
+    // 智能指针建议
+    if (ruleWanted(config, "SMART-PTR-001")) {
+        add(std::make_unique<SmartPointerRule>());
+    }
+    // 循环拷贝优化
+    if (ruleWanted(config, "LOOP-COPY-001")) {
+        add(std::make_unique<LoopCopyRule>());
+    }
+
+    // ===== V2.0 高级安全分析规则 =====
+    // 整数溢出检测
+    if (ruleWanted(config, "INTEGER-OVERFLOW-001")) {
+        add(std::make_unique<IntegerOverflowRule>());
+    }
+    // Use-After-Free 检测
+    if (ruleWanted(config, "USE-AFTER-FREE-001")) {
+        add(std::make_unique<UseAfterFreeRule>());
+    }
+    // 缓冲区溢出检测
+    if (ruleWanted(config, "BUFFER-OVERFLOW-001")) {
+        add(std::make_unique<BufferOverflowRule>());
+    }
+}
+
+/**
+ * 结果缓存的配置键: C++ 标准、是否解析所在函数、规则集合、按路径的规则设置
+ * (分析器结果版本由 ResultCache::makeConfigKey 统一加入)
+ */
+std::string resultCacheKey(const RuleEngine& engine, const Config& config,
+                           const RuleScopes& scopes, bool resolve_enclosing) {
+    std::vector<std::string> key_parts = {config.cpp_standard,
+                                          resolve_enclosing ? "enclosing" : ""};
+    for (const auto& rule : engine.getRuleMetadata()) {
+        key_parts.push_back(rule.id);
+    }
+    key_parts.push_back(scopes.signature());
+    // 伞形编译单元中头文件的结果取决于同批的其他头文件
+    key_parts.push_back(config.header_only ? "umbrella-" + std::to_string(config.header_batch_size) : "");
+    for (const auto& directory : config.include_directories) {
+        key_parts.push_back("-I" + directory);
+    }
+    return ResultCache::makeConfigKey(key_parts);
+}
+
+/**
+ * 按配置创建 AI 增强器
+ * 未知提供者名称回退到基于规则的提供者; 提供者为 none 或不可用时返回 nullptr
+ * @param run_start 运行开始时间, 时间预算从此刻起算
+ */
+std::unique_ptr<LLMEnhancer> createLLMEnhancer(const Config& config,
+                                               std::chrono::steady_clock::time_point run_start) {
+    auto type = LLMProviderFactory::parseType(config.llm_provider);
+    if (!type) {
+        std::cerr << "Warning: Unknown LLM provider '" << config.llm_provider
+                  << "', using rule-based suggestions\n";
+        type = LLMProviderFactory::ProviderType::RULE_BASED;
+    }
+
+    LLMOptions llm_options;
+    llm_options.endpoint = config.llm_endpoint;
+    llm_options.model = config.llm_model;
+    llm_options.api_key = config.llm_api_key;
+    if (llm_options.api_key.empty()) {
+        const char* env_key = std::getenv("OPENAI_API_KEY");
+        llm_options.api_key = env_key ? env_key : "";
+    }
+    llm_options.batch_size = config.llm_batch_size;
+    llm_options.max_in_flight = config.llm_concurrency;
+    llm_options.max_retries = config.llm_max_retries;
+    llm_options.timeout_ms = config.llm_timeout_ms;
+    llm_options.requests_per_minute = config.llm_requests_per_minute;
+    llm_options.tokens_per_minute = config.llm_tokens_per_minute;
+    if (config.llm_time_budget > 0) {
+        llm_options.deadline = run_start + std::chrono::seconds(config.llm_time_budget);
+    }
+
+    auto provider = LLMProviderFactory::create(*type, llm_options);
+    if (!provider) {
+        return nullptr;
+    }
+    if (!provider->isAvailable()) {
+        std::cerr << "Warning: LLM endpoint '" << config.llm_endpoint
+                  << "' is not a supported http:// URL, AI suggestions disabled\n";
+        return nullptr;
+    }
+    // 基于规则的建议是纯计算, 不需要并发请求和缓存
+    bool remote = *type == LLMProviderFactory::ProviderType::OPENAI;
+    auto enhancer = std::make_unique<LLMEnhancer>(provider, remote ? llm_options.max_in_flight : 1);
+    enhancer->setClustering(config.llm_cluster);
+    if (remote) {
+        enhancer->setBudget(llm_options);
+    }
+    if (remote && config.llm_cache) {
+        enhancer->setSuggestionCache(std::make_shared<SuggestionCache>(
+            config.cache_dir.empty() ? ".cpp-agent-cache" : config.cache_dir,
+            static_cast<uint64_t>(config.llm_cache_size_mb) * 1024 * 1024));
+    }
+    return enhancer;
+}
+
+/**
+ * 分析一组文件: 先查结果缓存, 未命中的文件交给 Clang 解析
+ * @param files 要分析的文件
+ * @param config 配置
+ * @param commit 非空时从 git 对象库读取该提交中的文件
+ * @param engine 规则引擎
+ * @param reporter 报告器
+ * @param cache 结果缓存 (可为 nullptr)
+ * @param analyzed 输出: 实际解析的文件数 (可选)
+ * @param stats 运行统计: 记录每个编译单元的内存和节点数 (可选)
+ * @return 解析是否成功
+ */
+bool analyzeFiles(const std::vector<std::string>& files, const Config& config,
+                  const std::string& commit, RuleEngine& engine, Reporter& reporter,
+                  ResultCache* cache, size_t* analyzed = nullptr, RunStats* stats = nullptr) {
+    // 所有规则都是词法级时只做词法切分; 这条路径足够快, 不使用结果缓存
+    bool semantic = engine.requiresSemanticAnalysis();
+    if (!semantic) {
+        cache = nullptr;
+    }
+
+    Metrics* metrics = engine.getMetrics();
+    std::vector<std::string> pending;
+    for (const auto& path : files) {
+        if (engine.limitReached()) {
+            break;
+        }
+        std::optional<std::vector<Issue>> cached;
+        if (cache) {
+            cached = cache->lookup(path);
+            if (metrics) {
+                metrics->countCacheLookup(cached.has_value());
+            }
+        }
+        if (cached) {
+            for (const auto& issue : *cached) {
+                reporter.addIssue(issue);
+            }
+        } else {
+            pending.push_back(path);
+        }
+    }
+    if (analyzed) {
+        *analyzed = pending.size();
+    }
+    if (metrics) {
+        metrics->addQueuedFiles(pending.size());
+    }
+    if (pending.empty() || engine.limitReached()) {
+        return true;
+    }
+
+    ASTParser parser(pending, config.cpp_standard);
+    parser.setIncludeDirectories(config.include_directories);
+    if (config.header_only) {
+        parser.setHeaderBatchSize(config.header_batch_size);
+    }
+    if (!commit.empty()) {
+        parser.setFileSystem(new RevisionFileSystem(
+            GitIntegration::objectReader(), commit, GitIntegration::getRepositoryRoot()));
+    }
+    if (!semantic) {
+        return parser.lex(engine, reporter);
+    }
+    parser.setResultCache(cache);
+    parser.setRunStats(stats);
+    return parser.parse(engine, reporter);
+}
+
+} // namespace
+} // namespace cpp_review
 
 int main(int argc, char* argv[]) {
     using namespace cpp_review;
 
+    // 运行开始时间 (AI 增强的时间预算从此刻起算)
+    const auto run_start = std::chrono::steady_clock::now();
+    RunStats run_stats(run_start);
+
     // 解析命令行参数
     CLIOptions options = CLI::parseArguments(argc, argv);
 
@@ -56,8 +310,54 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
+    // 加载配置文件
+    Config config;
+    if (std::filesystem::exists(".cpp-agent.yml")) {
+        std::cout << "Loading configuration from .cpp-agent.yml...\n";
+        config = ConfigManager::loadConfig(".cpp-agent.yml");
+    } else {
+        // 使用默认配置
+        config = ConfigManager::getDefaultConfig();
+    }
+
+    // 文件枚举相关的命令行选项 (exclude 同时作用于增量和 --rev 的文件列表)
+    config.exclude_paths.insert(config.exclude_paths.end(),
+                                options.exclude_patterns.begin(), options.exclude_patterns.end());
+    if (options.include_headers) {
+        config.scan_headers = true;
+    }
+    if (options.header_only) {
+        config.header_only = true;
+    }
+    if (options.fast) {
+        config.fast = true;
+    }
+    if (options.enable_ai) {
+        config.enable_ai_suggestions = true;
+    }
+    if (!options.llm_provider.empty()) {
+        config.llm_provider = options.llm_provider;
+    }
+    if (!options.llm_endpoint.empty()) {
+        config.llm_endpoint = options.llm_endpoint;
+    }
+    if (options.llm_time_budget >= 0) {
+        config.llm_time_budget = options.llm_time_budget;
+    }
+    if (options.header_batch_size > 0) {
+        config.header_batch_size = options.header_batch_size;
+    }
+    if (config.header_only) {
+        // 仅头文件库: 收集头文件 (分批分析), 扫描目录本身作为头文件搜索目录
+        config.scan_headers = true;
+        config.include_directories.insert(config.include_directories.end(),
+                                          options.scan_directories.begin(), options.scan_directories.end());
+    }
+
     // ===== V1.5 Git 集成: 增量分析 =====
     std::optional<PREnvironment> pr_env;
+    std::string pr_merge_base;                 // PR 模式的对比基准
+    std::vector<std::string> pr_base_files;    // 变更文件中在 merge-base 已存在的文件
 
     if (options.incremental) {
         // 检查是否为 Git 仓库
@@ -81,6 +381,13 @@ int main(int argc, char* argv[]) {
             pr_env = GitIntegration::detectPREnvironment();
         }
 
+        // PR 模式只保留新增问题, 用它覆盖基线会丢失所有已知问题
+        if (mode == IncrementalMode::PR && options.update_baseline) {
+            std::cerr << "Error: --update-baseline cannot be used in PR diff mode; "
+                      << "update the baseline from a full scan instead\n";
+            return 1;
+        }
+
         // 获取变更文件列表
         std::cout << "🔍 Git incremental analysis mode: " << options.incremental_mode << "\n";
         if (!options.git_reference.empty()) {
@@ -94,10 +401,72 @@ int main(int argc, char* argv[]) {
             return 0;
         }
 
-        std::cout << "   Found " << changed_files.size() << " changed C++ file(s)\n\n";
+        std::cout << "   Found " << changed_files.size() << " changed C++ file(s)\n";
+
+        // PR 模式: 与 merge-base 的结果对比, 只报告本次 PR 新增和修复的问题
+        if (mode == IncrementalMode::PR) {
+            std::string base_branch = pr_env && !pr_env->base_branch.empty()
+                ? pr_env->base_branch : GitIntegration::getDefaultBranch();
+            if (auto merge_base = GitIntegration::getMergeBase(base_branch)) {
+                pr_merge_base = *merge_base;
+                pr_base_files = GitIntegration::listRevisionFiles(pr_merge_base, changed_files);
+                std::cout << "   Merge-base with " << base_branch << ": "
+                          << pr_merge_base.substr(0, 12) << "\n";
+            } else {
+                std::cerr << "Warning: Cannot determine merge-base with " << base_branch
+                          << ", reporting all issues in changed files\n";
+            }
+        }
+
+        std::cout << "\n";
         options.source_paths = changed_files;
     }
 
+    // ===== 直接分析指定提交 (从对象库读取, 不检出) =====
+    std::string revision_commit;
+    if (!options.revision.empty()) {
+        if (!GitIntegration::isGitRepository()) {
+            std::cerr << "Error: Not a Git repository. --rev requires Git.\n";
+            return 1;
+        }
+
+        auto commit = GitIntegration::resolveCommit(options.revision);
+        if (!commit) {
+            std::cerr << "Error: Cannot resolve revision '" << options.revision << "'\n";
+            return 1;
+        }
+        revision_commit = *commit;
+
+        std::cout << "📦 Analyzing revision " << options.revision
+                  << " (" << revision_commit.substr(0, 12) << ") from git object store\n";
+
+        // 文件列表以该提交中的内容为准 (增量模式已经给出了变更文件)
+        if (!options.incremental) {
+            options.source_paths = GitIntegration::listRevisionFiles(revision_commit, options.scan_targets);
+            // 与目录扫描一致: 默认只分析实现文件, 命令行直接给出的头文件除外
+            if (!config.scan_headers) {
+                auto& paths = options.source_paths;
+                paths.erase(std::remove_if(paths.begin(), paths.end(), [&](const std::string& path) {
+                    return DirectoryWalker::isHeaderFile(path) &&
+                           std::find(options.scan_targets.begin(), options.scan_targets.end(), path) ==
+                               options.scan_targets.end();
+                }), paths.end());
+            }
+        }
+    }
+
+    // ===== 工作区目录扫描: 并行遍历, 遵守 .gitignore 与 exclude, 剪枝被忽略的子树 =====
+    if (!options.incremental && options.revision.empty() && !options.scan_directories.empty()) {
+        WalkOptions walk;
+        walk.exclude = config.exclude_paths;
+        walk.include_headers = config.scan_headers;
+        walk.use_gitignore = config.use_gitignore;
+        for (const auto& directory : options.scan_directories) {
+            auto files = DirectoryWalker::collect(directory, walk);
+            options.source_paths.insert(options.source_paths.end(), files.begin(), files.end());
+        }
+    }
+
     // 检查是否指定了源文件
     if (options.source_paths.empty()) {
         std::cerr << "Error: No source files specified\n";
@@ -105,16 +474,6 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    // 加载配置文件
-    Config config;
-    if (std::filesystem::exists(".cpp-agent.yml")) {
-        std::cout << "Loading configuration from .cpp-agent.yml...\n";
-        config = ConfigManager::loadConfig(".cpp-agent.yml");
-    } else {
-        // 使用默认配置
-        config = ConfigManager::getDefaultConfig();
-    }
-
     // 命令行选项覆盖配置文件设置
     if (!options.cpp_standard.empty()) {
         config.cpp_standard = options.cpp_standard;
@@ -124,6 +483,56 @@ int main(int argc, char* argv[]) {
         if (!options.html_output.empty()) {
             config.html_output_file = options.html_output;
         }
+        if (!options.html_dir.empty()) {
+            config.html_output_dir = options.html_dir;
+        }
+    }
+    if (!options.baseline_file.empty()) {
+        config.baseline_file = options.baseline_file;
+    }
+    if (options.update_baseline && config.baseline_file.empty()) {
+        config.baseline_file = ".cpp-agent-baseline";
+    }
+    if (options.metrics_port >= 0) {
+        config.metrics_port = options.metrics_port;
+    }
+    if (!options.cache_dir.empty()) {
+        config.cache_dir = options.cache_dir;
+    }
+
+    // 配置中的 include / exclude 限定分析范围
+    if (!config.include_paths.empty() || !config.exclude_paths.empty()) {
+        PathFilter filter(config.include_paths, config.exclude_paths);
+        auto filterPaths = [&](std::vector<std::string>& paths) {
+            paths.erase(std::remove_if(paths.begin(), paths.end(),
+                                       [&](const std::string& path) { return !filter.accepts(path); }),
+                        paths.end());
+        };
+        filterPaths(options.source_paths);
+        filterPaths(pr_base_files);
+        if (options.source_paths.empty()) {
+            std::cout << "No files left to analyze after applying include/exclude configuration\n";
+            return 0;
+        }
+    }
+
+    // 校验输出格式
+    if (options.output_format != "console" && options.output_format != "sarif") {
+        std::cerr << "Error: Unknown output format '" << options.output_format
+                  << "' (expected console or sarif)\n";
+        return 1;
+    }
+    bool sarif_output = options.output_format == "sarif";
+    if (sarif_output && options.output_file.empty()) {
+        options.output_file = "cpp-agent.sarif";
+    }
+
+    // --fast 不构建 AST, 问题没有所在函数名, 其稳定指纹与完整分析的不一致;
+    // 基线、PR 差异比较和 SARIF 都依赖稳定指纹, 此时回退到完整分析
+    if (config.fast && (!config.baseline_file.empty() || !pr_merge_base.empty() || sarif_output)) {
+        std::cerr << "Warning: --fast is ignored with --baseline, --pr and --format=sarif "
+                  << "(their fingerprints need the full analysis)\n";
+        config.fast = false;
     }
 
     // 显示启动信息
@@ -134,7 +543,16 @@ int main(int argc, char* argv[]) {
     std::cout << "Configuration:\n";
     std::cout << "  C++ Standard: " << config.cpp_standard << "\n";
     std::cout << "  Files to analyze: " << options.source_paths.size() << "\n";
-    std::cout << "  HTML Report: " << (config.generate_html ? "Yes (" + config.html_output_file + ")" : "No") << "\n";
+    if (config.header_only) {
+        std::cout << "  Header-only mode: " << config.header_batch_size << " header(s) per umbrella unit\n";
+    }
+    std::string html_target = config.html_output_dir.empty()
+        ? config.html_output_file : config.html_output_dir + "/index.html";
+    std::cout << "  HTML Report: " << (config.generate_html ? "Yes (" + html_target + ")" : "No") << "\n";
+    if (!config.baseline_file.empty()) {
+        std::cout << "  Baseline: " << config.baseline_file
+                  << (options.update_baseline ? " (update)" : "") << "\n";
+    }
     std::cout << "\n";
 
     // 显示待分析的文件列表
@@ -146,77 +564,299 @@ int main(int argc, char* argv[]) {
 
     // 创建规则引擎并注册所有检测规则
     RuleEngine engine;
+    registerRules(engine, config);
 
-    // ===== V1.0 基础检测规则 =====
-    // 空指针解引用检测
-    if (config.disabled_rules.find("NULL-PTR-001") == config.disabled_rules.end()) {
-        engine.registerRule(std::make_unique<NullPointerRule>());
-    }
-    // 未初始化变量检测
-    if (config.disabled_rules.find("UNINIT-VAR-001") == config.disabled_rules.end()) {
-        engine.registerRule(std::make_unique<UninitializedVarRule>());
+    // 按注册顺序编译按路径的规则范围 (全局严重性覆盖也在其中应用)
+    std::vector<std::string> rule_ids;
+    for (const auto& rule : engine.getRuleMetadata()) {
+        rule_ids.push_back(rule.id);
     }
-    // 赋值/比较混淆检测
-    if (config.disabled_rules.find("ASSIGN-COND-001") == config.disabled_rules.end()) {
-        engine.registerRule(std::make_unique<AssignmentInConditionRule>());
+    std::shared_ptr<const RuleScopes> rule_scopes;
+    try {
+        rule_scopes = RuleScopes::compile(config, rule_ids);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
     }
-    // 不安全 C 函数检测
-    if (config.disabled_rules.find("UNSAFE-C-FUNC-001") == config.disabled_rules.end()) {
-        engine.registerRule(std::make_unique<UnsafeCFunctionsRule>());
+    engine.setRuleScopes(rule_scopes);
+
+    std::cout << "Registered " << engine.getRuleCount() << " analysis rules (V2.0)";
+    if (!engine.requiresSemanticAnalysis()) {
+        std::cout << " - lexical tier, no semantic analysis";
     }
+    std::cout << "\n";
+    std::cout << "\n";
+    std::cout << "Analyzing...\n";
 
-    // ===== V1.5 性能分析规则 =====
-    // 内存泄漏检测
-    if (config.disabled_rules.find("MEMORY-LEAK-001") == config.disabled_rules.end()) {
-        engine.registerRule(std::make_unique<MemoryLeakRule>());
+    // 硬件计数器剖析: 内核不允许 perf_event_open 时给出警告并照常分析
+    HardwareProfile hw_profile;
+    if (options.hw_counters) {
+        std::string error;
+        if (HardwareProfile::probe(error)) {
+            engine.setHardwareProfile(&hw_profile);
+            run_stats.setHardwareProfile(&hw_profile);
+        } else {
+            std::cerr << "Warning: Hardware counters unavailable (" << error << "), --hw-counters ignored\n";
+        }
     }
-    // 智能指针建议
-    if (config.disabled_rules.find("SMART-PTR-001") == config.disabled_rules.end()) {
-        engine.registerRule(std::make_unique<SmartPointerRule>());
+
+    // 创建报告生成器
+    Reporter reporter;
+
+    // 基线指纹、PR 差异比较和 SARIF partialFingerprints 都需要问题所在的函数名
+    bool resolve_enclosing = !config.baseline_file.empty() || !pr_merge_base.empty() || sarif_output;
+    engine.setResolveEnclosingFunctions(resolve_enclosing);
+
+    // 稳定指纹中的路径相对仓库根目录, 与检出位置和运行目录无关
+    if (GitIntegration::isGitRepository()) {
+        Fingerprint::setRepositoryRoot(GitIntegration::getRepositoryRoot());
     }
-    // 循环拷贝优化
-    if (config.disabled_rules.find("LOOP-COPY-001") == config.disabled_rules.end()) {
-        engine.registerRule(std::make_unique<LoopCopyRule>());
+
+    // 加载基线: 基线中的已知问题在 addIssue 时直接丢弃
+    // (更新基线时需要完整结果, 不加载)
+    std::shared_ptr<Baseline> baseline;
+    if (!config.baseline_file.empty() && !options.update_baseline) {
+        baseline = std::make_shared<Baseline>();
+        if (baseline->load(config.baseline_file)) {
+            std::cout << "Loaded " << baseline->size() << " known issue(s) from baseline\n";
+            reporter.setBaseline(baseline);
+        } else {
+            std::cerr << "Warning: Cannot read baseline file " << config.baseline_file
+                      << ", reporting all issues\n";
+            baseline.reset();
+        }
     }
 
-    // ===== V2.0 高级安全分析规则 =====
-    // 整数溢出检测
-    if (config.disabled_rules.find("INTEGER-OVERFLOW-001") == config.disabled_rules.end()) {
-        engine.registerRule(std::make_unique<IntegerOverflowRule>());
+    // 提前终止: 由最终报告器判断问题是否计入 (基线、去重之后),
+    // 规则遍历与剩余编译单元协作地停止
+    std::shared_ptr<IssueLimit> issue_limit;
+    if (!options.fail_fast.empty() || options.max_issues > 0) {
+        issue_limit = std::make_shared<IssueLimit>();
+        if (!options.fail_fast.empty()) {
+            issue_limit->fail_at = RuleScopes::parseSeverity(options.fail_fast);
+            if (!issue_limit->fail_at) {
+                std::cerr << "Warning: Unknown severity '" << options.fail_fast
+                          << "' for --fail-fast, using CRITICAL\n";
+                issue_limit->fail_at = Severity::CRITICAL;
+            }
+        }
+        issue_limit->max_issues = options.max_issues;
+
+        if (!pr_merge_base.empty()) {
+            // 新增问题要在与 merge-base 比较之后才能确定, 中途停止会误报
+            std::cerr << "Warning: --fail-fast/--max-issues are ignored in PR diff mode\n";
+            issue_limit.reset();
+        } else if (options.update_baseline) {
+            // 基线需要完整结果
+            std::cerr << "Warning: --fail-fast/--max-issues are ignored with --update-baseline\n";
+            issue_limit.reset();
+        } else {
+            reporter.setIssueLimit(issue_limit);
+            engine.setIssueLimit(issue_limit, &reporter);
+        }
     }
-    // Use-After-Free 检测
-    if (config.disabled_rules.find("USE-AFTER-FREE-001") == config.disabled_rules.end()) {
-        engine.registerRule(std::make_unique<UseAfterFreeRule>());
+
+    // AI 增强流水线: 问题被报告器接收时入队, 请求与编译单元分析并行进行;
+    // PR 差异模式只增强最终保留的新增问题, 在比较之后统一提交
+    std::unique_ptr<LLMEnhancer> enhancer;
+    if (config.enable_ai_suggestions) {
+        enhancer = createLLMEnhancer(config, run_start);
+        if (enhancer && pr_merge_base.empty()) {
+            enhancer->start();
+            reporter.setAcceptedIssueListener([&enhancer](const Issue& issue) { enhancer->submit(issue); });
+        }
     }
-    // 缓冲区溢出检测
-    if (config.disabled_rules.find("BUFFER-OVERFLOW-001") == config.disabled_rules.end()) {
-        engine.registerRule(std::make_unique<BufferOverflowRule>());
+
+    // 结果缓存: 内容未变的编译单元直接复用上次的结果
+    std::unique_ptr<ResultCache> result_cache;
+    if (!config.cache_dir.empty()) {
+        if (!GitIntegration::isGitRepository()) {
+            std::cerr << "Warning: Result cache requires a Git repository, cache disabled\n";
+        } else {
+            result_cache = std::make_unique<ResultCache>(
+                config.cache_dir, resultCacheKey(engine, config, *rule_scopes, resolve_enclosing),
+                GitIntegration::getRepositoryRoot(), GitIntegration::getBlobIndex(revision_commit));
+        }
     }
 
-    std::cout << "Registered " << engine.getRuleCount() << " analysis rules (V2.0)\n";
-    std::cout << "\n";
-    std::cout << "Analyzing...\n";
+    // 运行指标端点: 长时间扫描期间供监控面板抓取 (在 AI 增强流水线之后创建, 先于其销毁)
+    Metrics metrics;
+    std::unique_ptr<MetricsServer> metrics_server;
+    if (config.metrics_port > 0) {
+        metrics.setReporter(&reporter);
+        if (enhancer) {
+            metrics.setLLMQueueDepth([&enhancer]() { return enhancer->getQueueDepth(); });
+        }
+        metrics_server = std::make_unique<MetricsServer>(metrics);
+        std::string error;
+        if (metrics_server->start(config.metrics_port, error)) {
+            engine.setMetrics(&metrics);
+            std::cout << "Metrics: http://127.0.0.1:" << metrics_server->getPort() << "/metrics\n";
+        } else {
+            std::cerr << "Warning: Cannot serve metrics on port " << config.metrics_port << ": " << error
+                      << ", metrics disabled\n";
+            metrics_server.reset();
+        }
+    }
 
-    // 创建报告生成器
-    Reporter reporter;
+    // PR 模式: 在独立线程中分析 merge-base 版本 (从对象库读取, 不检出),
+    // 与 HEAD 的分析同时进行; 基准结果总是缓存, 基于同一 merge-base 的 PR 共享
+    std::thread base_thread;
+    std::vector<Issue> base_issues;
+    bool base_success = true;
+    size_t base_analyzed = 0;
+    std::unique_ptr<ResultCache> base_cache;
+    std::unique_ptr<RuleEngine> base_engine;
+    if (!pr_merge_base.empty() && !pr_base_files.empty()) {
+        base_engine = std::make_unique<RuleEngine>();
+        registerRules(*base_engine, config);
+        base_engine->setRuleScopes(rule_scopes);
+        base_engine->setResolveEnclosingFunctions(true);
+        base_cache = std::make_unique<ResultCache>(
+            config.cache_dir.empty() ? ".cpp-agent-cache" : config.cache_dir,
+            resultCacheKey(*base_engine, config, *rule_scopes, true),
+            GitIntegration::getRepositoryRoot(), GitIntegration::getBlobIndex(pr_merge_base));
+
+        base_thread = std::thread([&] {
+            // merge-base 一侧同样过滤基线, 否则基线中的问题会被当作本次 PR 修复
+            Reporter base_reporter;
+            if (baseline) {
+                base_reporter.setBaseline(baseline);
+            }
+            base_success = analyzeFiles(pr_base_files, config, pr_merge_base, *base_engine,
+                                        base_reporter, base_cache.get(), &base_analyzed);
+            base_issues = base_reporter.takeIssues();
+        });
+    }
 
     // 创建 AST 解析器并运行分析
-    ASTParser parser(options.source_paths, config.cpp_standard);
-    bool success = parser.parse(engine, reporter);
+    run_stats.beginPhase("analyze");
+    size_t analyzed = 0;
+    bool success = analyzeFiles(options.source_paths, config, revision_commit, engine, reporter,
+                                result_cache.get(), &analyzed,
+                                options.stats_file.empty() ? nullptr : &run_stats);
+    run_stats.setFileCounts(options.source_paths.size(), analyzed);
+    if (result_cache) {
+        std::cout << "Result cache: " << result_cache->getHitCount() << " hit(s), "
+                  << analyzed << " file(s) analyzed\n";
+    }
+    if (!options.stats_file.empty()) {
+        run_stats.printTranslationUnitSummary(std::cout);
+    }
+    if (engine.getHardwareProfile()) {
+        hw_profile.printSummary(std::cout);
+    }
+
+    if (base_thread.joinable()) {
+        base_thread.join();
+    }
+
+    // 只保留相对 merge-base 新增的问题
+    std::optional<IssueDiff> pr_diff;
+    if (!pr_merge_base.empty()) {
+        if (!base_success) {
+            std::cerr << "Warning: Analysis of merge-base " << pr_merge_base.substr(0, 12)
+                      << " failed, reporting all issues in changed files\n";
+        } else {
+            pr_diff = IssueDiff::compute(base_issues, reporter.getIssues());
+            std::cout << "PR diff vs merge-base " << pr_merge_base.substr(0, 12) << ": "
+                      << pr_diff->new_issues.size() << " new, "
+                      << pr_diff->fixed_issues.size() << " fixed, "
+                      << pr_diff->unchanged << " pre-existing";
+            if (base_cache) {
+                std::cout << " (base: " << base_cache->getHitCount() << " cached, "
+                          << base_analyzed << " analyzed)";
+            }
+            std::cout << "\n";
+            reporter.replaceIssues(pr_diff->new_issues);
+        }
+    }
 
     if (!success) {
         std::cerr << "\nError: Analysis failed\n";
         return 1;
     }
 
-    // 生成并显示控制台报告
-    reporter.generateReport(std::cout);
+    // 为最终报告中的问题标注作者和提交 (所有输出格式共用)
+    run_stats.beginPhase("blame");
+    if (options.blame) {
+        if (!GitIntegration::isGitRepository()) {
+            std::cerr << "Warning: --blame requires a Git repository, skipped\n";
+        } else {
+            // blame 可能耗时较长, 在副本上标注 (不持有报告器的锁), 再在锁内原地写回;
+            // 问题列表始终完整, 指标端点的问题数不会在标注期间归零
+            std::vector<Issue> annotated = reporter.getIssues();
+            GitBlame::annotate(annotated, revision_commit);
+            reporter.updateIssues([&annotated](std::vector<Issue>& issues) {
+                for (size_t i = 0; i < issues.size() && i < annotated.size(); ++i) {
+                    issues[i].blame_author = std::move(annotated[i].blame_author);
+                    issues[i].blame_commit = std::move(annotated[i].blame_commit);
+                }
+            });
+        }
+    }
+
+    // 等待剩余的 AI 请求并把建议写入最终报告中的问题
+    run_stats.beginPhase("ai");
+    if (enhancer) {
+        enhancer->enhanceAllIssues(reporter);
+        std::cout << "AI suggestions: " << enhancer->getProviderName() << ", "
+                  << enhancer->getIssueCount() << " issue(s) in "
+                  << enhancer->getClusterCount() << " cluster(s), "
+                  << enhancer->getBatchCount() << " batch(es)";
+        if (enhancer->getCacheHitCount() > 0) {
+            std::cout << ", " << enhancer->getCacheHitCount() << " cached";
+        }
+        if (enhancer->getFallbackCount() > 0) {
+            std::cout << ", " << enhancer->getFallbackCount() << " rule-based fallback(s)";
+        }
+        if (enhancer->getOverBudgetCount() > 0) {
+            std::cout << " (" << enhancer->getOverBudgetCount() << " over time budget)";
+        }
+        if (enhancer->getBudget().getWaitCount() > 0) {
+            std::cout << ", " << enhancer->getBudget().getWaitCount() << " rate-limit wait(s)";
+        }
+        std::cout << "\n";
+    }
+
+    // 生成并显示控制台报告 (SARIF 模式只显示摘要, 详情写入文件)
+    run_stats.beginPhase("report");
+    if (sarif_output) {
+        reporter.generateSummary(std::cout);
+        std::cout << "Writing SARIF report: " << options.output_file << "\n";
+        try {
+            SarifWriter::generateSarifReport(reporter, engine.getRuleMetadata(), options.output_file);
+            std::cout << "✓ SARIF report generated successfully!\n";
+        } catch (const std::exception& e) {
+            std::cerr << "Error generating SARIF report: " << e.what() << "\n";
+        }
+    } else {
+        reporter.generateReport(std::cout);
+    }
+    if (pr_diff) {
+        std::cout << "\n";
+        pr_diff->writeFixedIssues(std::cout);
+    }
+
+    // 如果请求,用本次结果重新生成基线
+    if (options.update_baseline) {
+        if (Baseline::save(config.baseline_file, reporter.getIssues())) {
+            std::cout << "\n✓ Baseline updated: " << config.baseline_file
+                      << " (" << reporter.getIssueCount() << " issue(s))\n";
+        } else {
+            std::cerr << "Error: Cannot write baseline file " << config.baseline_file << "\n";
+        }
+    }
 
     // 如果请求,生成 HTML 报告
     if (config.generate_html) {
-        std::cout << "\nGenerating HTML report: " << config.html_output_file << "\n";
+        std::cout << "\nGenerating HTML report: " << html_target << "\n";
         try {
-            HTMLReporter::generateHTMLReport(reporter, config.html_output_file);
+            if (!config.html_output_dir.empty()) {
+                HTMLReporter::generateSplitHTMLReport(reporter, config.html_output_dir);
+            } else {
+                HTMLReporter::generateHTMLReport(reporter, config.html_output_file);
+            }
             std::cout << "✓ HTML report generated successfully!\n";
         } catch (const std::exception& e) {
             std::cerr << "Error generating HTML report: " << e.what() << "\n";
@@ -230,6 +870,10 @@ int main(int argc, char* argv[]) {
         // 生成报告内容
         std::ostringstream report_stream;
         reporter.generateReport(report_stream);
+        if (pr_diff) {
+            report_stream << "\n";
+            pr_diff->writeFixedIssues(report_stream);
+        }
         std::string report_content = report_stream.str();
 
         // 如果在 PR 环境中,使用 PR 环境信息
@@ -258,10 +902,22 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    // 运行统计 (供语料库基准汇总)
+    if (!options.stats_file.empty() && !run_stats.write(options.stats_file, reporter)) {
+        std::cerr << "Error: Cannot write statistics file " << options.stats_file << "\n";
+    }
+
     // 如果发现严重问题,返回错误码
     if (reporter.getCriticalCount() > 0) {
         return 2;
     }
+    if (issue_limit && issue_limit->fail_at) {
+        for (const auto& issue : reporter.getIssues()) {
+            if (issue_limit->triggers(issue)) {
+                return 2;
+            }
+        }
+    }
 
     return 0;
 }
@@ -6,31 +6,203 @@
 #include "parser/ast_parser.h"
 #include "rules/rule_engine.h"
 #include "report/reporter.h"
-#include <clang/Tooling/CommonOptionsParser.h>
+#include "cache/result_cache.h"
+#include "parser/umbrella_units.h"
+#include "report/run_stats.h"
+#include "parser/token_stream.h"
+#include "scan/directory_walker.h"
+#include <clang/AST/RecursiveASTVisitor.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Tooling/CompilationDatabase.h>
 #include <clang/Tooling/Tooling.h>
-#include <llvm/Support/CommandLine.h>
+#include <filesystem>
 #include <iostream>
+#include <map>
 
 namespace cpp_review {
 
+namespace {
+
+/**
+ * 绝对规范化路径, 与 ClangTool 报告的主文件路径和结果缓存 lookup 返回的路径一致
+ */
+std::string absolutePath(const std::string& path) {
+    std::error_code ec;
+    std::filesystem::path absolute = std::filesystem::absolute(path, ec);
+    return ec ? path : absolute.lexically_normal().string();
+}
+
+/**
+ * 编译单元实际进入过的所有文件 (缓存的依赖集合)
+ */
+std::vector<std::string> collectDependencies(const clang::SourceManager& sm) {
+    std::vector<std::string> dependencies;
+    for (unsigned i = 0, n = sm.local_sloc_entry_size(); i < n; ++i) {
+        const clang::SrcMgr::SLocEntry& entry = sm.getLocalSLocEntry(i);
+        if (!entry.isFile()) continue;
+        llvm::StringRef name = entry.getFile().getName();
+        // 跳过 <built-in>、<command line> 等虚拟缓冲区
+        if (name.empty() || name[0] == '<') continue;
+        dependencies.push_back(name.str());
+    }
+    return dependencies;
+}
+
+/**
+ * 统计 AST 节点数 (含隐式代码和模板实例化, 反映 ASTContext 中实际存在的节点)
+ */
+class NodeCounter : public clang::RecursiveASTVisitor<NodeCounter> {
+public:
+    bool shouldVisitImplicitCode() const { return true; }
+    bool shouldVisitTemplateInstantiations() const { return true; }
+
+    bool VisitDecl(clang::Decl*) {
+        ++decls;
+        return true;
+    }
+
+    bool VisitStmt(clang::Stmt*) {
+        ++stmts;
+        return true;
+    }
+
+    uint64_t decls = 0;
+    uint64_t stmts = 0;
+};
+
+} // namespace
+
 // ===== AnalysisConsumer 实现 =====
 
-AnalysisConsumer::AnalysisConsumer(RuleEngine& engine, Reporter& reporter)
-    : rule_engine_(engine), reporter_(reporter) {}
+AnalysisConsumer::AnalysisConsumer(RuleEngine& engine, Reporter& reporter,
+                                   ResultCache* cache, std::string file,
+                                   const UmbrellaUnit* umbrella, RunStats* stats)
+    : rule_engine_(engine), reporter_(reporter), cache_(cache), file_(std::move(file)),
+      umbrella_(umbrella), stats_(stats), start_(std::chrono::steady_clock::now()),
+      start_rss_kb_(stats ? RunStats::peakRSSKilobytes() : 0) {
+    parse_counted_ = engine.getHardwareProfile() && HardwareProfile::read(parse_counters_);
+}
 
 /**
  * 当 AST 构建完成时被调用
  * 在这里运行所有注册的分析规则
  */
 void AnalysisConsumer::HandleTranslationUnit(clang::ASTContext& context) {
-    // 在整个编译单元上运行所有已注册的规则
-    rule_engine_.runAllRules(&context, reporter_);
+    // 解析阶段 (预处理、语法和语义分析) 到此结束
+    CounterValues parsed;
+    if (parse_counted_ && HardwareProfile::read(parsed)) {
+        // 与规则记录使用同一个主文件名
+        const clang::SourceManager& sm = context.getSourceManager();
+        std::string main_file = sm.getFilename(sm.getLocForStartOfFile(sm.getMainFileID())).str();
+        rule_engine_.getHardwareProfile()->record(main_file, HardwareProfile::kParseScope,
+                                                  parsed - parse_counters_);
+    }
+
+    RuleVisitCounts visits;
+    RuleVisitCounts* counts = stats_ ? &visits : nullptr;
+
+    if (umbrella_) {
+        handleUmbrella(context, cache_ ? collectDependencies(context.getSourceManager())
+                                       : std::vector<std::string>(),
+                       counts);
+    } else if (!cache_) {
+        // 在整个编译单元上运行所有已注册的规则
+        rule_engine_.runAllRules(&context, reporter_, {}, counts);
+    } else {
+        // 先收集本编译单元的完整结果 (未经全局去重/基线过滤) 写入缓存
+        Reporter tu_reporter;
+        bool complete = rule_engine_.runAllRules(&context, tu_reporter, {}, counts);
+        std::vector<Issue> issues = tu_reporter.takeIssues();
+
+        // 提前终止的编译单元结果不完整, 不能写入缓存
+        if (complete) {
+            cache_->store(file_, collectDependencies(context.getSourceManager()), issues);
+        }
+
+        for (const auto& issue : issues) {
+            reporter_.addIssue(issue);
+        }
+    }
+
+    if (stats_) {
+        recordStats(context, std::move(visits));
+    }
+}
+
+/**
+ * 记录编译单元的资源统计
+ * 峰值内存是进程级的: 本编译单元没有超过之前的峰值时增量为 0
+ */
+void AnalysisConsumer::recordStats(clang::ASTContext& context, RuleVisitCounts visits) {
+    TranslationUnitStats stats;
+    stats.file = file_;
+    stats.time_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start_).count();
+
+    stats.ast_bytes = context.getASTAllocatedMemory() + context.getSideTableAllocatedMemory();
+    const clang::SourceManager& sm = context.getSourceManager();
+    clang::SourceManager::MemoryBufferSizes buffers = sm.getMemoryBufferSizes();
+    stats.source_buffer_bytes = buffers.malloc_bytes + buffers.mmap_bytes;
+    stats.source_manager_bytes = sm.getDataStructureSizes();
+    stats.peak_rss_delta_kb = RunStats::peakRSSKilobytes() - start_rss_kb_;
+
+    NodeCounter counter;
+    counter.TraverseDecl(context.getTranslationUnitDecl());
+    stats.decls = counter.decls;
+    stats.stmts = counter.stmts;
+    stats.rule_nodes = std::move(visits);
+
+    stats_->addTranslationUnit(std::move(stats));
+}
+
+/**
+ * 处理伞形编译单元
+ * 规则范围按本批头文件计算; 问题归属回头文件的原始路径,
+ * 其他文件 (共享依赖、其他批次的头文件) 中的问题丢弃
+ */
+void AnalysisConsumer::handleUmbrella(clang::ASTContext& context,
+                                      const std::vector<std::string>& dependencies,
+                                      RuleVisitCounts* visits) {
+    Reporter tu_reporter;
+    bool complete = rule_engine_.runAllRules(&context, tu_reporter, umbrella_->headers, visits);
+
+    std::map<std::string, std::vector<Issue>> by_header;
+    for (const auto& header : umbrella_->headers) {
+        by_header[absolutePath(header)];
+    }
+    for (auto& issue : tu_reporter.takeIssues()) {
+        std::string origin = umbrella_->originOf(issue.file_path);
+        if (origin.empty()) continue;
+        // 与单独分析头文件 (和缓存命中) 时报告的路径相同
+        issue.file_path = absolutePath(origin);
+        by_header[issue.file_path].push_back(std::move(issue));
+    }
+
+    if (cache_ && complete) {
+        // 虚拟主文件不在仓库中, 不能作为依赖; 每个头文件以整批的依赖保守地缓存
+        std::vector<std::string> real_dependencies;
+        for (const auto& dependency : dependencies) {
+            if (dependency != file_ && dependency != umbrella_->path) {
+                real_dependencies.push_back(dependency);
+            }
+        }
+        for (const auto& entry : by_header) {
+            cache_->store(entry.first, real_dependencies, entry.second);
+        }
+    }
+
+    for (const auto& entry : by_header) {
+        for (const auto& issue : entry.second) {
+            reporter_.addIssue(issue);
+        }
+    }
 }
 
 // ===== AnalysisAction 实现 =====
 
-AnalysisAction::AnalysisAction(RuleEngine& engine, Reporter& reporter)
-    : rule_engine_(engine), reporter_(reporter) {}
+AnalysisAction::AnalysisAction(RuleEngine& engine, Reporter& reporter, ResultCache* cache,
+                               const UmbrellaMap* umbrellas, RunStats* stats)
+    : rule_engine_(engine), reporter_(reporter), cache_(cache), umbrellas_(umbrellas), stats_(stats) {}
 
 /**
  * 为每个源文件创建 AST 消费者
@@ -39,78 +211,129 @@ AnalysisAction::AnalysisAction(RuleEngine& engine, Reporter& reporter)
 std::unique_ptr<clang::ASTConsumer> AnalysisAction::CreateASTConsumer(
     clang::CompilerInstance& compiler,
     llvm::StringRef file) {
-    return std::make_unique<AnalysisConsumer>(rule_engine_, reporter_);
+    const UmbrellaUnit* umbrella = nullptr;
+    if (umbrellas_) {
+        auto it = umbrellas_->find(file.str());
+        if (it != umbrellas_->end()) {
+            umbrella = it->second;
+        }
+    }
+    return std::make_unique<AnalysisConsumer>(rule_engine_, reporter_, cache_, file.str(), umbrella,
+                                              stats_);
 }
 
 // ===== AnalysisActionFactory 实现 =====
 
-AnalysisActionFactory::AnalysisActionFactory(RuleEngine& engine, Reporter& reporter)
-    : rule_engine_(engine), reporter_(reporter) {}
+AnalysisActionFactory::AnalysisActionFactory(RuleEngine& engine, Reporter& reporter,
+                                             ResultCache* cache, const UmbrellaMap* umbrellas,
+                                             RunStats* stats)
+    : rule_engine_(engine), reporter_(reporter), cache_(cache), umbrellas_(umbrellas), stats_(stats) {}
 
 /**
  * 创建新的前端操作实例
  * 工厂模式允许为每个文件创建独立的操作
  */
 std::unique_ptr<clang::FrontendAction> AnalysisActionFactory::create() {
-    return std::make_unique<AnalysisAction>(rule_engine_, reporter_);
+    return std::make_unique<AnalysisAction>(rule_engine_, reporter_, cache_, umbrellas_, stats_);
 }
 
 // ===== ASTParser 实现 =====
 
 ASTParser::ASTParser(const std::vector<std::string>& source_paths,
                      const std::string& cpp_standard)
-    : source_paths_(source_paths), cpp_standard_(cpp_standard) {}
+    : source_paths_(source_paths),
+      cpp_standard_(cpp_standard),
+      file_system_(llvm::vfs::getRealFileSystem()) {}
 
 /**
  * 解析源文件并运行分析
  * 创建 Clang 工具实例并执行分析规则
  */
 bool ASTParser::parse(RuleEngine& engine, Reporter& reporter) {
-    // 构建命令行参数列表
-    std::vector<std::string> args;
-    args.push_back("cpp-agent");  // 程序名称
-
-    // 添加所有源文件路径
-    for (const auto& path : source_paths_) {
-        args.push_back(path);
+    // 编译器选项 (等价于命令行 "-- <flags>" 的固定编译数据库)
+    // 直接构造而不经过 CommonOptionsParser, 避免修改 llvm::cl 全局状态,
+    // 多个解析器可以在不同线程中同时运行
+    std::vector<std::string> compiler_args;
+    compiler_args.push_back("-std=" + cpp_standard_);  // 指定 C++ 标准
+    compiler_args.push_back("-fsyntax-only");           // 只检查语法,不生成代码
+    compiler_args.push_back("-w");                      // 抑制编译器警告
+    for (const auto& directory : include_directories_) {
+        compiler_args.push_back("-I" + directory);
     }
 
-    // 添加编译器选项
-    args.push_back("--");
-    args.push_back("-std=" + cpp_standard_);  // 指定 C++ 标准
-    args.push_back("-fsyntax-only");           // 只检查语法,不生成代码
-    args.push_back("-w");                      // 抑制编译器警告
+    clang::tooling::FixedCompilationDatabase compilations(".", compiler_args);
 
-    // 转换为 C 风格字符串数组 (Clang 工具接口要求)
-    std::vector<const char*> c_args;
-    for (const auto& arg : args) {
-        c_args.push_back(arg.c_str());
+    // 仅头文件库模式: 头文件分批合成伞形编译单元, 实现文件照常逐个分析
+    std::vector<std::string> sources;
+    std::vector<UmbrellaUnit> umbrellas;
+    UmbrellaMap umbrella_map;
+    if (header_batch_size_ > 0) {
+        std::vector<std::string> headers;
+        for (const auto& path : source_paths_) {
+            (DirectoryWalker::isHeaderFile(path) ? headers : sources).push_back(path);
+        }
+        umbrellas = UmbrellaPlanner::plan(std::move(headers), header_batch_size_);
+        for (const auto& unit : umbrellas) {
+            sources.push_back(unit.path);
+            umbrella_map[unit.path] = &unit;
+        }
+    } else {
+        sources = source_paths_;
     }
 
-    int argc = static_cast<int>(c_args.size());
-
-    // 解析命令行选项
-    llvm::cl::OptionCategory category("cpp-agent options");
-    auto expected_parser = clang::tooling::CommonOptionsParser::create(
-        argc, c_args.data(), category);
+    // 使用我们的分析操作工厂运行工具
+    AnalysisActionFactory factory(engine, reporter, cache_, umbrellas.empty() ? nullptr : &umbrella_map,
+                                  stats_);
+    auto run = [&](const std::vector<std::string>& files) {
+        // 创建 Clang 工具实例
+        clang::tooling::ClangTool tool(compilations,
+                                       files,
+                                       std::make_shared<clang::PCHContainerOperations>(),
+                                       file_system_);
+        for (const auto& unit : umbrellas) {
+            tool.mapVirtualFile(unit.path, unit.content);
+        }
+        return tool.run(&factory);
+    };
 
-    if (!expected_parser) {
-        std::cerr << "Error creating parser: "
-                 << llvm::toString(expected_parser.takeError()) << "\n";
-        return false;
+    // 未设置提前终止条件时一次运行所有编译单元
+    if (!engine.hasIssueLimit()) {
+        // 返回分析是否成功 (0 表示成功)
+        return run(sources) == 0;
     }
 
-    // 创建 Clang 工具实例
-    clang::tooling::CommonOptionsParser& options_parser = expected_parser.get();
-    clang::tooling::ClangTool tool(options_parser.getCompilations(),
-                                   options_parser.getSourcePathList());
+    // --fail-fast / --max-issues: 逐个编译单元运行, 达到条件后取消剩余的编译单元
+    bool success = true;
+    for (const auto& source : sources) {
+        if (engine.limitReached()) {
+            break;
+        }
+        success = run({source}) == 0 && success;
+    }
+    return success;
+}
 
-    // 使用我们的分析操作工厂运行工具
-    AnalysisActionFactory factory(engine, reporter);
-    int result = tool.run(&factory);
+/**
+ * 词法级分析
+ * 每个文件独立读取和切分, 问题路径与 ClangTool 一样使用绝对路径
+ */
+bool ASTParser::lex(RuleEngine& engine, Reporter& reporter) {
+    bool success = true;
+    for (const auto& path : source_paths_) {
+        if (engine.limitReached()) {
+            break;
+        }
+        auto buffer = file_system_->getBufferForFile(path);
+        if (!buffer) {
+            std::cerr << "Error: Cannot read " << path << ": " << buffer.getError().message() << "\n";
+            success = false;
+            continue;
+        }
 
-    // 返回分析是否成功 (0 表示成功)
-    return result == 0;
+        TokenStream tokens = TokenStream::lex(absolutePath(path), (*buffer)->getBuffer().str(), cpp_standard_);
+        engine.runLexicalRules(tokens, reporter);
+    }
+    return success;
 }
 
 } // namespace cpp_review
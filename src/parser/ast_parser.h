@@ -5,6 +5,10 @@
 
 #pragma once
 
+#include "rules/rule_engine.h"
+#include "report/hw_counters.h"
+#include <chrono>
+#include <map>
 #include <string>
 #include <vector>
 #include <memory>
@@ -12,11 +16,16 @@
 #include <clang/Frontend/FrontendActions.h>
 #include <clang/AST/ASTConsumer.h>
 #include <clang/AST/ASTContext.h>
+#include <llvm/Support/VirtualFileSystem.h>
 
 namespace cpp_review {
 
-class Reporter;
-class RuleEngine;
+class ResultCache;
+class RunStats;
+struct UmbrellaUnit;
+
+// 伞形编译单元: 虚拟主文件路径 -> 编译单元
+using UmbrellaMap = std::map<std::string, const UmbrellaUnit*>;
 
 /**
  * AST 消费者类 - 在编译单元解析完成后执行分析规则
@@ -24,14 +33,31 @@ class RuleEngine;
  */
 class AnalysisConsumer : public clang::ASTConsumer {
 public:
-    AnalysisConsumer(RuleEngine& engine, Reporter& reporter);
+    AnalysisConsumer(RuleEngine& engine, Reporter& reporter,
+                     ResultCache* cache = nullptr, std::string file = "",
+                     const UmbrellaUnit* umbrella = nullptr, RunStats* stats = nullptr);
 
     // 处理整个编译单元的 AST
     void HandleTranslationUnit(clang::ASTContext& context) override;
 
 private:
+    // 伞形编译单元: 只保留本批头文件中的问题, 按头文件分别写入缓存
+    void handleUmbrella(clang::ASTContext& context, const std::vector<std::string>& dependencies,
+                        RuleVisitCounts* visits);
+
+    // 记录本编译单元的 AST/SourceManager 内存、峰值内存增量和节点数 (--stats)
+    void recordStats(clang::ASTContext& context, RuleVisitCounts visits);
+
     RuleEngine& rule_engine_;  // 规则引擎引用
     Reporter& reporter_;       // 报告生成器引用
+    ResultCache* cache_;       // 结果缓存 (可选)
+    std::string file_;         // 编译单元主文件
+    const UmbrellaUnit* umbrella_;  // 主文件为伞形编译单元时非空
+    RunStats* stats_;               // 运行统计 (可选)
+    std::chrono::steady_clock::time_point start_;  // 消费者创建 (解析开始) 的时间
+    long start_rss_kb_ = 0;                        // 解析开始时的进程峰值内存
+    CounterValues parse_counters_;                 // 解析开始时的硬件计数器 (--hw-counters)
+    bool parse_counted_ = false;                   // parse_counters_ 是否有效
 };
 
 /**
@@ -40,7 +66,8 @@ private:
  */
 class AnalysisAction : public clang::ASTFrontendAction {
 public:
-    AnalysisAction(RuleEngine& engine, Reporter& reporter);
+    AnalysisAction(RuleEngine& engine, Reporter& reporter, ResultCache* cache = nullptr,
+                   const UmbrellaMap* umbrellas = nullptr, RunStats* stats = nullptr);
 
     // 为每个源文件创建一个 AST 消费者
     std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(
@@ -50,6 +77,9 @@ public:
 private:
     RuleEngine& rule_engine_;
     Reporter& reporter_;
+    ResultCache* cache_;
+    const UmbrellaMap* umbrellas_;
+    RunStats* stats_;
 };
 
 /**
@@ -58,7 +88,8 @@ private:
  */
 class AnalysisActionFactory : public clang::tooling::FrontendActionFactory {
 public:
-    AnalysisActionFactory(RuleEngine& engine, Reporter& reporter);
+    AnalysisActionFactory(RuleEngine& engine, Reporter& reporter, ResultCache* cache = nullptr,
+                          const UmbrellaMap* umbrellas = nullptr, RunStats* stats = nullptr);
 
     // 创建新的前端操作实例
     std::unique_ptr<clang::FrontendAction> create() override;
@@ -66,6 +97,9 @@ public:
 private:
     RuleEngine& rule_engine_;
     Reporter& reporter_;
+    ResultCache* cache_;
+    const UmbrellaMap* umbrellas_;
+    RunStats* stats_;
 };
 
 /**
@@ -90,9 +124,57 @@ public:
      */
     bool parse(RuleEngine& engine, Reporter& reporter);
 
+    /**
+     * 只做词法切分并运行 LEXICAL 级别的规则 (--fast, 或所有启用的规则都是词法级)
+     * 不预处理、不展开 #include, 不启动 Clang 前端
+     * @param engine 规则引擎
+     * @param reporter 报告生成器
+     * @return 所有文件都能读取返回 true
+     */
+    bool lex(RuleEngine& engine, Reporter& reporter);
+
+    /**
+     * 设置读取源文件使用的文件系统 (默认为真实文件系统)
+     * 例如 RevisionFileSystem 可直接分析 git 对象库中的某个提交
+     * @param fs 文件系统
+     */
+    void setFileSystem(llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs) { file_system_ = std::move(fs); }
+
+    /**
+     * 设置结果缓存: 每个编译单元分析完成后保存其结果及依赖的文件
+     * @param cache 结果缓存 (不转移所有权, nullptr 表示不缓存)
+     */
+    void setResultCache(ResultCache* cache) { cache_ = cache; }
+
+    /**
+     * 设置运行统计: 每个编译单元分析完成后记录其内存占用、节点数和各规则访问的节点数
+     * 节点计数需要额外遍历一次 AST, 只在 --stats 时设置
+     * @param stats 运行统计 (不转移所有权, nullptr 表示不统计)
+     */
+    void setRunStats(RunStats* stats) { stats_ = stats; }
+
+    /**
+     * 仅头文件库模式: 头文件每 batch_size 个合成一个内存中的伞形编译单元
+     * 实现文件仍各自作为编译单元分析
+     * @param batch_size 每批头文件数, 0 表示关闭 (每个头文件单独分析)
+     */
+    void setHeaderBatchSize(size_t batch_size) { header_batch_size_ = batch_size; }
+
+    /**
+     * 设置额外的头文件搜索目录 (-I)
+     */
+    void setIncludeDirectories(std::vector<std::string> directories) {
+        include_directories_ = std::move(directories);
+    }
+
 private:
     std::vector<std::string> source_paths_;  // 源文件路径列表
     std::string cpp_standard_;                // C++ 标准版本
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> file_system_;  // 源文件所在的文件系统
+    ResultCache* cache_ = nullptr;                                  // 结果缓存 (可选)
+    RunStats* stats_ = nullptr;                                     // 运行统计 (可选)
+    size_t header_batch_size_ = 0;                                  // 伞形编译单元批大小 (0 为关闭)
+    std::vector<std::string> include_directories_;                  // 额外的 -I 目录
 };
 
 } // namespace cpp_review
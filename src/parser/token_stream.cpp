@@ -0,0 +1,123 @@
+/*
+ * 词法记号流实现
+ */
+
+#include "parser/token_stream.h"
+#include <clang/Basic/LangOptions.h>
+#include <clang/Basic/TokenKinds.h>
+#include <clang/Lex/Lexer.h>
+#include <clang/Lex/Token.h>
+#include <algorithm>
+
+namespace cpp_review {
+
+namespace {
+
+/**
+ * 按 C++ 标准设置影响词法的语言选项
+ */
+clang::LangOptions makeLangOptions(const std::string& cpp_standard) {
+    clang::LangOptions options;
+    options.CPlusPlus = 1;
+    options.CPlusPlus11 = cpp_standard != "c++98" && cpp_standard != "c++03";
+    options.CPlusPlus14 = options.CPlusPlus11 && cpp_standard != "c++11";
+    options.CPlusPlus17 = options.CPlusPlus14 && cpp_standard != "c++14";
+    options.CPlusPlus20 = options.CPlusPlus17 && cpp_standard != "c++17";
+    options.LineComment = 1;
+    options.Digraphs = 1;
+    return options;
+}
+
+} // namespace
+
+TokenStream TokenStream::lex(const std::string& path, const std::string& content,
+                             const std::string& cpp_standard) {
+    TokenStream stream;
+    stream.path_ = path;
+    stream.content_ = content;
+
+    const std::string& text = stream.content_;
+    const char* begin = text.c_str();
+    const char* end = begin + text.size();
+
+    clang::LangOptions options = makeLangOptions(cpp_standard);
+    clang::Lexer lexer(clang::SourceLocation(), options, begin, begin, end);
+
+    // 行号/列号按偏移递增计算, 只向前扫描一遍
+    unsigned line = 1;
+    size_t line_start = 0;
+    size_t scanned = 0;
+
+    bool in_directive = false;
+    clang::Token token;
+    for (;;) {
+        lexer.LexFromRawLexer(token);
+        if (token.is(clang::tok::eof)) {
+            break;
+        }
+
+        // 预处理指令: 从行首的 "#" 到下一个位于行首的记号
+        if (token.isAtStartOfLine()) {
+            in_directive = token.is(clang::tok::hash);
+        }
+        if (in_directive) {
+            continue;
+        }
+
+        size_t offset = static_cast<size_t>(lexer.getBufferLocation() - begin) - token.getLength();
+        for (; scanned < offset; ++scanned) {
+            if (text[scanned] == '\n') {
+                ++line;
+                line_start = scanned + 1;
+            }
+        }
+
+        LexToken lexed;
+        lexed.offset = static_cast<unsigned>(offset);
+        lexed.line = line;
+        lexed.column = static_cast<unsigned>(offset - line_start + 1);
+        lexed.text = text.substr(offset, token.getLength());
+        if (token.is(clang::tok::raw_identifier)) {
+            lexed.kind = LexToken::Kind::IDENTIFIER;
+        } else if (token.isLiteral()) {
+            lexed.kind = LexToken::Kind::LITERAL;
+        } else {
+            lexed.kind = LexToken::Kind::PUNCTUATION;
+        }
+        stream.tokens_.push_back(std::move(lexed));
+    }
+
+    return stream;
+}
+
+size_t TokenStream::findClosing(size_t open) const {
+    if (open >= tokens_.size()) {
+        return tokens_.size();
+    }
+    const std::string& opening = tokens_[open].text;
+    const char* closing = opening == "(" ? ")" : opening == "[" ? "]" : opening == "{" ? "}" : nullptr;
+    if (!closing) {
+        return tokens_.size();
+    }
+
+    int depth = 0;
+    for (size_t i = open; i < tokens_.size(); ++i) {
+        if (tokens_[i].isPunct(opening.c_str())) {
+            ++depth;
+        } else if (tokens_[i].isPunct(closing) && --depth == 0) {
+            return i;
+        }
+    }
+    return tokens_.size();
+}
+
+std::string TokenStream::text(size_t first, size_t last) const {
+    if (first > last || last >= tokens_.size()) {
+        return "";
+    }
+    size_t begin = tokens_[first].offset;
+    size_t end = tokens_[last].offset + tokens_[last].text.size();
+    return content_.substr(begin, end - begin);
+}
+
+} // namespace cpp_review
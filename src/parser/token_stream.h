@@ -0,0 +1,76 @@
+/*
+ * 词法记号流头文件
+ * --fast 分级使用: 用 Clang 原始词法分析器 (raw lexer) 切分单个源文件,
+ * 不做预处理、不展开 #include、不进行语义分析
+ *
+ * 只需要标识符和简单语法的规则 (如不安全 C 函数、条件中的赋值)
+ * 可以在记号流上运行, 每个文件的开销只有一次线性扫描
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace cpp_review {
+
+/**
+ * 一个词法记号
+ */
+struct LexToken {
+    enum class Kind {
+        IDENTIFIER,    // 标识符和关键字
+        PUNCTUATION,   // 运算符和分隔符
+        LITERAL,       // 数字、字符和字符串字面量
+    };
+
+    Kind kind = Kind::PUNCTUATION;
+    std::string text;      // 记号文本
+    unsigned offset = 0;   // 在文件中的字节偏移
+    unsigned line = 0;     // 行号 (从 1 开始)
+    unsigned column = 0;   // 列号 (从 1 开始)
+
+    bool is(Kind k, const char* spelling) const { return kind == k && text == spelling; }
+    bool isPunct(const char* spelling) const { return is(Kind::PUNCTUATION, spelling); }
+    bool isIdentifier() const { return kind == Kind::IDENTIFIER; }
+};
+
+/**
+ * 单个源文件的记号流
+ * 预处理指令行整行跳过, 注释不产生记号
+ */
+class TokenStream {
+public:
+    /**
+     * 对文件内容做词法切分
+     * @param path 文件路径 (写入问题的 file_path)
+     * @param content 文件内容
+     * @param cpp_standard C++ 标准 (影响原始字符串、数字分隔符等词法规则)
+     * @return 记号流
+     */
+    static TokenStream lex(const std::string& path, const std::string& content,
+                           const std::string& cpp_standard = "c++17");
+
+    const std::string& path() const { return path_; }
+    const std::vector<LexToken>& tokens() const { return tokens_; }
+    size_t size() const { return tokens_.size(); }
+    const LexToken& operator[](size_t index) const { return tokens_[index]; }
+
+    /**
+     * 从 open 处的 "(" "[" "{" 找到匹配的闭括号
+     * @return 闭括号的下标; 没有匹配时返回 size()
+     */
+    size_t findClosing(size_t open) const;
+
+    /**
+     * 取记号 [first, last] 覆盖的源码文本 (用作代码片段)
+     */
+    std::string text(size_t first, size_t last) const;
+
+private:
+    std::string path_;
+    std::string content_;
+    std::vector<LexToken> tokens_;
+};
+
+} // namespace cpp_review
@@ -0,0 +1,54 @@
+/*
+ * 伞形编译单元实现
+ */
+
+#include "parser/umbrella_units.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace cpp_review {
+
+namespace fs = std::filesystem;
+
+std::string UmbrellaPlanner::normalize(const std::string& path) {
+    std::error_code ec;
+    fs::path absolute = fs::absolute(path, ec);
+    if (ec) {
+        absolute = path;
+    }
+    return absolute.lexically_normal().generic_string();
+}
+
+std::string UmbrellaUnit::originOf(const std::string& file) const {
+    auto it = origin_.find(UmbrellaPlanner::normalize(file));
+    return it == origin_.end() ? "" : it->second;
+}
+
+std::vector<UmbrellaUnit> UmbrellaPlanner::plan(std::vector<std::string> headers, size_t batch_size) {
+    std::sort(headers.begin(), headers.end());
+    headers.erase(std::unique(headers.begin(), headers.end()), headers.end());
+    batch_size = std::max<size_t>(1, batch_size);
+
+    // 虚拟主文件放在当前目录下, 文件名不会与真实文件冲突
+    std::error_code ec;
+    fs::path cwd = fs::current_path(ec);
+
+    std::vector<UmbrellaUnit> units;
+    for (size_t begin = 0; begin < headers.size(); begin += batch_size) {
+        UmbrellaUnit unit;
+        unit.path = (cwd / (".cpp-agent-umbrella-" + std::to_string(units.size()) + ".cpp"))
+                        .generic_string();
+
+        size_t end = std::min(headers.size(), begin + batch_size);
+        for (size_t i = begin; i < end; ++i) {
+            std::string absolute = normalize(headers[i]);
+            unit.content += "#include \"" + absolute + "\"\n";
+            unit.headers.push_back(headers[i]);
+            unit.origin_.emplace(absolute, headers[i]);
+        }
+        units.push_back(std::move(unit));
+    }
+    return units;
+}
+
+} // namespace cpp_review
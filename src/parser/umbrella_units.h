@@ -0,0 +1,61 @@
+/*
+ * 伞形编译单元头文件
+ * 仅头文件库的分析模式: 把一批头文件合成为一个内存中的编译单元,
+ * 共享的依赖在每批中只解析一次
+ *
+ * 设计要点:
+ * - 头文件按路径排序后分批, 同一目录下的头文件通常落在同一批
+ * - 伞形文件用绝对路径 #include 各头文件, 只存在于内存 (映射为虚拟文件)
+ * - 分析结果只保留本批头文件中的问题, 并归属回命令行给出的原始路径;
+ *   依赖 (包括其他批次的头文件) 中的问题由各自所在的批次报告
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cpp_review {
+
+/**
+ * 一个伞形编译单元
+ */
+struct UmbrellaUnit {
+    std::string path;                    // 虚拟主文件路径 (绝对路径)
+    std::string content;                 // 虚拟主文件内容 (#include 列表)
+    std::vector<std::string> headers;    // 本批头文件 (原始路径)
+
+    /**
+     * 查询文件对应的本批头文件
+     * @param file SourceManager 给出的文件名
+     * @return 原始路径; 不属于本批时返回空字符串
+     */
+    std::string originOf(const std::string& file) const;
+
+private:
+    friend class UmbrellaPlanner;
+    std::unordered_map<std::string, std::string> origin_;   // 规范化绝对路径 -> 原始路径
+};
+
+/**
+ * 伞形编译单元规划器
+ */
+class UmbrellaPlanner {
+public:
+    /**
+     * 把头文件分批合成伞形编译单元
+     * @param headers 头文件路径
+     * @param batch_size 每批头文件数 (至少为 1)
+     * @return 伞形编译单元列表
+     */
+    static std::vector<UmbrellaUnit> plan(std::vector<std::string> headers, size_t batch_size);
+
+private:
+    friend struct UmbrellaUnit;
+
+    // 规范化为绝对路径 (与伞形文件中 #include 的写法一致)
+    static std::string normalize(const std::string& path);
+};
+
+} // namespace cpp_review
@@ -0,0 +1,67 @@
+/*
+ * 问题基线实现
+ */
+
+#include "report/baseline.h"
+#include "report/fingerprint.h"
+#include <algorithm>
+#include <fstream>
+
+namespace cpp_review {
+
+bool Baseline::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        // 跳过空行和注释
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        try {
+            fingerprints_.insert(std::stoull(line, nullptr, 16));
+        } catch (const std::exception&) {
+            // 忽略格式错误的行
+        }
+    }
+
+    return true;
+}
+
+bool Baseline::save(const std::string& path, const std::vector<Issue>& issues) {
+    std::vector<uint64_t> fingerprints;
+    fingerprints.reserve(issues.size());
+    for (const auto& issue : issues) {
+        fingerprints.push_back(Fingerprint::stableFingerprint(issue));
+    }
+    std::sort(fingerprints.begin(), fingerprints.end());
+    fingerprints.erase(std::unique(fingerprints.begin(), fingerprints.end()), fingerprints.end());
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << "# cpp-agent baseline v1\n";
+    file << "# " << fingerprints.size() << " known issue(s); regenerate with --update-baseline\n";
+    for (uint64_t fingerprint : fingerprints) {
+        file << Fingerprint::toHex(fingerprint) << "\n";
+    }
+
+    return static_cast<bool>(file);
+}
+
+bool Baseline::contains(const Issue& issue) const {
+    if (fingerprints_.empty()) {
+        return false;
+    }
+    return fingerprints_.count(Fingerprint::stableFingerprint(issue)) > 0;
+}
+
+} // namespace cpp_review
@@ -0,0 +1,49 @@
+/*
+ * 问题基线头文件
+ * 记录已知问题的稳定指纹, 使 CI 门禁只关注新增问题
+ */
+
+#pragma once
+
+#include "report/reporter.h"
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace cpp_review {
+
+/**
+ * 问题基线
+ *
+ * 文件格式: 每行一个 16 位十六进制指纹, '#' 开头的行为注释
+ * 指纹由 Fingerprint::stableFingerprint 计算, 不含行号, 代码移动后依然匹配
+ */
+class Baseline {
+public:
+    /**
+     * 从文件加载基线
+     * @param path 基线文件路径
+     * @return 文件无法打开时返回 false
+     */
+    bool load(const std::string& path);
+
+    /**
+     * 将问题列表写入基线文件 (指纹排序后输出, 便于版本控制比较)
+     * @param path 基线文件路径
+     * @param issues 要记录的问题
+     * @return 写入成功返回 true
+     */
+    static bool save(const std::string& path, const std::vector<Issue>& issues);
+
+    // 检查问题是否已在基线中 (O(1) 哈希查找)
+    bool contains(const Issue& issue) const;
+
+    // 基线中的指纹数量
+    size_t size() const { return fingerprints_.size(); }
+
+private:
+    std::unordered_set<uint64_t> fingerprints_;  // 已知问题的指纹集合
+};
+
+} // namespace cpp_review
@@ -0,0 +1,161 @@
+/*
+ * 问题指纹工具实现
+ */
+
+#include "report/fingerprint.h"
+#include <cctype>
+#include <filesystem>
+#include <system_error>
+
+namespace cpp_review {
+
+namespace {
+
+// FNV-1a 质数
+constexpr uint64_t kPrime = 1099511628211ULL;
+
+} // namespace
+
+uint64_t Fingerprint::mix(uint64_t hash, const std::string& text) {
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= kPrime;
+    }
+    // 分隔字节
+    hash ^= 0xff;
+    hash *= kPrime;
+    return hash;
+}
+
+std::string Fingerprint::normalizeMessage(const std::string& message) {
+    std::string result;
+    result.reserve(message.size());
+
+    bool in_quote = false;
+    bool pending_space = false;
+
+    for (char c : message) {
+        if (c == '\'') {
+            // 引号保留, 引号内的标识符/类型名丢弃
+            if (!in_quote && pending_space) {
+                result.push_back(' ');
+                pending_space = false;
+            }
+            in_quote = !in_quote;
+            result.push_back(c);
+            continue;
+        }
+        if (in_quote) {
+            continue;
+        }
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            pending_space = !result.empty();
+            continue;
+        }
+        if (pending_space) {
+            result.push_back(' ');
+            pending_space = false;
+        }
+        result.push_back(c);
+    }
+
+    return result;
+}
+
+std::string Fingerprint::normalizeSnippet(const std::string& snippet) {
+    std::string result;
+    result.reserve(snippet.size());
+
+    bool pending_space = false;
+    for (char c : snippet) {
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            pending_space = !result.empty();
+            continue;
+        }
+        if (pending_space) {
+            result.push_back(' ');
+            pending_space = false;
+        }
+        result.push_back(c);
+    }
+
+    return result;
+}
+
+namespace {
+
+// 路径规范化的基准目录: 工作目录和仓库根目录只在启动时确定一次, 不在每个问题上查询
+struct PathBase {
+    std::filesystem::path cwd;
+    std::filesystem::path root;
+};
+
+PathBase& pathBase() {
+    static PathBase base = [] {
+        PathBase initial;
+        std::error_code ec;
+        initial.cwd = std::filesystem::current_path(ec);
+        initial.root = initial.cwd;
+        return initial;
+    }();
+    return base;
+}
+
+} // namespace
+
+void Fingerprint::setRepositoryRoot(const std::string& root) {
+    if (!root.empty()) {
+        pathBase().root = std::filesystem::path(root).lexically_normal();
+    }
+}
+
+std::string Fingerprint::normalizePath(const std::string& path) {
+    namespace fs = std::filesystem;
+    const PathBase& base = pathBase();
+    fs::path p = fs::path(path);
+    if (p.is_relative() && !base.cwd.empty()) {
+        p = base.cwd / p;
+    }
+    p = p.lexically_normal();
+    if (p.is_absolute() && !base.root.empty()) {
+        fs::path relative = p.lexically_relative(base.root);
+        if (!relative.empty() && *relative.begin() != "..") {
+            return relative.generic_string();
+        }
+    }
+    return p.generic_string();
+}
+
+uint64_t Fingerprint::locationFingerprint(const Issue& issue) {
+    uint64_t hash = kOffsetBasis;
+    hash = mix(hash, issue.file_path);
+    hash = mix(hash, std::to_string(issue.line) + ":" + std::to_string(issue.column));
+    hash = mix(hash, issue.rule_id);
+    hash = mix(hash, normalizeMessage(issue.description));
+    return hash;
+}
+
+uint64_t Fingerprint::stableFingerprint(const Issue& issue) {
+    uint64_t hash = kOffsetBasis;
+    hash = mix(hash, issue.rule_id);
+    hash = mix(hash, normalizePath(issue.file_path));
+    if (!issue.code_snippet.empty()) {
+        hash = mix(hash, normalizeSnippet(issue.code_snippet));
+    } else {
+        hash = mix(hash, normalizeMessage(issue.description));
+    }
+    hash = mix(hash, issue.enclosing_function);
+    return hash;
+}
+
+std::string Fingerprint::toHex(uint64_t hash) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(16, '0');
+    for (int i = 15; i >= 0; --i) {
+        hex[i] = digits[hash & 0xf];
+        hash >>= 4;
+    }
+    return hex;
+}
+
+} // namespace cpp_review
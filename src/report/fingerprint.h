@@ -0,0 +1,79 @@
+/*
+ * 问题指纹工具头文件
+ * 为问题去重、基线比对等功能提供稳定的哈希和文本规范化
+ */
+
+#pragma once
+
+#include "report/reporter.h"
+#include <cstdint>
+#include <string>
+
+namespace cpp_review {
+
+/**
+ * 指纹工具类
+ * 使用 FNV-1a 64 位哈希, 结果与平台和运行次数无关, 可以写入文件长期保存
+ */
+class Fingerprint {
+public:
+    // FNV-1a 初始值
+    static constexpr uint64_t kOffsetBasis = 14695981039346656037ULL;
+
+    /**
+     * 将一段文本混入哈希值
+     * 每段文本后额外混入分隔字节, 避免 "ab"+"c" 与 "a"+"bc" 冲突
+     * @param hash 当前哈希值
+     * @param text 要混入的文本
+     * @return 更新后的哈希值
+     */
+    static uint64_t mix(uint64_t hash, const std::string& text);
+
+    /**
+     * 规范化问题描述
+     * 去掉单引号中的变量名/类型名并压缩空白,
+     * 使同一模板的不同实例化产生相同的描述
+     */
+    static std::string normalizeMessage(const std::string& message);
+
+    /**
+     * 规范化代码片段: 压缩所有连续空白为单个空格并去掉首尾空白
+     * 使缩进或换行调整不影响片段比较
+     */
+    static std::string normalizeSnippet(const std::string& snippet);
+
+    /**
+     * 设置路径规范化的根目录 (通常为仓库根目录, 启动时在分析开始前调用一次)
+     * 未设置时使用启动时的当前目录
+     */
+    static void setRepositoryRoot(const std::string& root);
+
+    /**
+     * 将路径规范化为相对根目录的形式 (相对路径先按启动时的当前目录补全, 根目录之外的路径保持绝对),
+     * 使不同检出位置、从仓库不同子目录运行时得到相同指纹
+     */
+    static std::string normalizePath(const std::string& path);
+
+    /**
+     * 计算问题的去重指纹: (拼写位置, 规则 ID, 规范化描述)
+     * @param issue 已解析位置的问题
+     * @return 64 位指纹
+     */
+    static uint64_t locationFingerprint(const Issue& issue);
+
+    /**
+     * 计算问题的基线指纹: (规则 ID, 文件, 规范化片段, 所在函数)
+     * 不包含行号和列号, 在文件中插入或删除代码后依然稳定;
+     * 没有代码片段的问题使用规范化描述代替
+     * @param issue 已解析位置的问题
+     * @return 64 位指纹
+     */
+    static uint64_t stableFingerprint(const Issue& issue);
+
+    /**
+     * 将指纹格式化为 16 位十六进制字符串
+     */
+    static std::string toHex(uint64_t hash);
+};
+
+} // namespace cpp_review
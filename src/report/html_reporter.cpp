@@ -1,7 +1,10 @@
 #include "report/html_reporter.h"
+#include "report/json_utils.h"
 #include <sstream>
 #include <map>
+#include <array>
 #include <algorithm>
+#include <filesystem>
 
 namespace cpp_review {
 
@@ -324,6 +327,51 @@ std::string HTMLReporter::getHTMLFooter() {
 )";
 }
 
+void HTMLReporter::writeSummary(std::ostream& out, const std::vector<Issue>& issues) {
+    std::map<Severity, size_t> severity_counts;
+
+    for (const auto& issue : issues) {
+        severity_counts[issue.severity]++;
+    }
+
+    out << "        <div class=\"summary\">\n";
+    out << "            <h2>📈 问题统计摘要</h2>\n";
+    out << "            <div class=\"stats\">\n";
+
+    out << "                <div class=\"stat-card\">\n";
+    out << "                    <div class=\"stat-number\" style=\"color: #667eea;\">" << issues.size() << "</div>\n";
+    out << "                    <div class=\"stat-label\">总问题数</div>\n";
+    out << "                </div>\n";
+
+    out << "                <div class=\"stat-card\">\n";
+    out << "                    <div class=\"stat-number\" style=\"color: #dc3545;\">" << severity_counts[Severity::CRITICAL] << "</div>\n";
+    out << "                    <div class=\"stat-label\">严重 (Critical)</div>\n";
+    out << "                </div>\n";
+
+    out << "                <div class=\"stat-card\">\n";
+    out << "                    <div class=\"stat-number\" style=\"color: #fd7e14;\">" << severity_counts[Severity::HIGH] << "</div>\n";
+    out << "                    <div class=\"stat-label\">高 (High)</div>\n";
+    out << "                </div>\n";
+
+    out << "                <div class=\"stat-card\">\n";
+    out << "                    <div class=\"stat-number\" style=\"color: #ffc107;\">" << severity_counts[Severity::MEDIUM] << "</div>\n";
+    out << "                    <div class=\"stat-label\">中 (Medium)</div>\n";
+    out << "                </div>\n";
+
+    out << "                <div class=\"stat-card\">\n";
+    out << "                    <div class=\"stat-number\" style=\"color: #17a2b8;\">" << severity_counts[Severity::LOW] << "</div>\n";
+    out << "                    <div class=\"stat-label\">低 (Low)</div>\n";
+    out << "                </div>\n";
+
+    out << "                <div class=\"stat-card\">\n";
+    out << "                    <div class=\"stat-number\" style=\"color: #28a745;\">" << severity_counts[Severity::SUGGESTION] << "</div>\n";
+    out << "                    <div class=\"stat-label\">建议 (Suggestion)</div>\n";
+    out << "                </div>\n";
+
+    out << "            </div>\n";
+    out << "        </div>\n";
+}
+
 void HTMLReporter::generateHTMLReport(const Reporter& reporter, const std::string& output_file) {
     std::ofstream file(output_file);
     if (!file.is_open()) {
@@ -335,48 +383,7 @@ void HTMLReporter::generateHTMLReport(const Reporter& reporter, const std::strin
 
     // Summary section
     const auto& issues = reporter.getIssues();
-    std::map<Severity, size_t> severity_counts;
-
-    for (const auto& issue : issues) {
-        severity_counts[issue.severity]++;
-    }
-
-    file << "        <div class=\"summary\">\n";
-    file << "            <h2>📈 问题统计摘要</h2>\n";
-    file << "            <div class=\"stats\">\n";
-
-    file << "                <div class=\"stat-card\">\n";
-    file << "                    <div class=\"stat-number\" style=\"color: #667eea;\">" << issues.size() << "</div>\n";
-    file << "                    <div class=\"stat-label\">总问题数</div>\n";
-    file << "                </div>\n";
-
-    file << "                <div class=\"stat-card\">\n";
-    file << "                    <div class=\"stat-number\" style=\"color: #dc3545;\">" << severity_counts[Severity::CRITICAL] << "</div>\n";
-    file << "                    <div class=\"stat-label\">严重 (Critical)</div>\n";
-    file << "                </div>\n";
-
-    file << "                <div class=\"stat-card\">\n";
-    file << "                    <div class=\"stat-number\" style=\"color: #fd7e14;\">" << severity_counts[Severity::HIGH] << "</div>\n";
-    file << "                    <div class=\"stat-label\">高 (High)</div>\n";
-    file << "                </div>\n";
-
-    file << "                <div class=\"stat-card\">\n";
-    file << "                    <div class=\"stat-number\" style=\"color: #ffc107;\">" << severity_counts[Severity::MEDIUM] << "</div>\n";
-    file << "                    <div class=\"stat-label\">中 (Medium)</div>\n";
-    file << "                </div>\n";
-
-    file << "                <div class=\"stat-card\">\n";
-    file << "                    <div class=\"stat-number\" style=\"color: #17a2b8;\">" << severity_counts[Severity::LOW] << "</div>\n";
-    file << "                    <div class=\"stat-label\">低 (Low)</div>\n";
-    file << "                </div>\n";
-
-    file << "                <div class=\"stat-card\">\n";
-    file << "                    <div class=\"stat-number\" style=\"color: #28a745;\">" << severity_counts[Severity::SUGGESTION] << "</div>\n";
-    file << "                    <div class=\"stat-label\">建议 (Suggestion)</div>\n";
-    file << "                </div>\n";
-
-    file << "            </div>\n";
-    file << "        </div>\n";
+    writeSummary(file, issues);
 
     // Issues section
     file << "        <div class=\"issues\">\n";
@@ -407,15 +414,19 @@ void HTMLReporter::generateHTMLReport(const Reporter& reporter, const std::strin
         file << "                <div class=\"location\">📍 " << escapeHTML(issue.file_path) << ":" << issue.line << ":" << issue.column << "</div>\n";
         file << "                <div class=\"rule-id\">🏷️ " << escapeHTML(issue.rule_id) << "</div>\n";
         file << "                <div class=\"description\">📝 " << escapeHTML(issue.description) << "</div>\n";
+        if (!issue.blame_commit.empty()) {
+            file << "                <div class=\"location\">👤 " << escapeHTML(issue.blame_author)
+                 << " · " << escapeHTML(issue.blame_commit.substr(0, 12)) << "</div>\n";
+        }
 
         if (!issue.code_snippet.empty()) {
             file << "                <div class=\"code\">" << escapeHTML(issue.code_snippet) << "</div>\n";
         }
 
-        if (!issue.suggestion.empty()) {
+        if (!issue.suggestion.empty() || !issue.ai_suggestion.empty()) {
             file << "                <div class=\"suggestion\">\n";
             file << "                    <div class=\"suggestion-title\">💡 修复建议:</div>\n";
-            file << "                    <div>" << escapeHTML(issue.suggestion) << "</div>\n";
+            file << "                    <div>" << escapeHTML(issue.fullSuggestion()) << "</div>\n";
             file << "                </div>\n";
         }
 
@@ -437,4 +448,402 @@ void HTMLReporter::generateHTMLReport(const Reporter& reporter, const std::strin
     file.close();
 }
 
+std::string HTMLReporter::getSplitReportStyles() {
+    return R"(
+    <style>
+        .split-panels {
+            display: grid;
+            grid-template-columns: minmax(260px, 1fr) 2fr;
+            gap: 20px;
+        }
+
+        .panel-title {
+            color: #333;
+            margin-bottom: 10px;
+            font-weight: bold;
+        }
+
+        .file-search {
+            width: 100%;
+            padding: 8px;
+            margin-bottom: 10px;
+            border: 1px solid #ced4da;
+            border-radius: 5px;
+        }
+
+        .vlist {
+            height: 520px;
+            overflow-y: auto;
+            border: 1px solid #e9ecef;
+            border-radius: 8px;
+        }
+
+        .vrow {
+            display: flex;
+            align-items: center;
+            gap: 10px;
+            padding: 0 12px;
+            border-bottom: 1px solid #f1f3f5;
+            cursor: pointer;
+            white-space: nowrap;
+            overflow: hidden;
+            font-size: 0.9em;
+        }
+
+        .vrow:hover, .vrow.selected {
+            background: #e7f3ff;
+        }
+
+        .vrow .path, .vrow .desc {
+            flex: 1;
+            overflow: hidden;
+            text-overflow: ellipsis;
+        }
+
+        .vrow .count, .vrow .loc {
+            font-family: 'Courier New', monospace;
+            color: #666;
+        }
+
+        .dot {
+            width: 10px;
+            height: 10px;
+            border-radius: 50%;
+            flex-shrink: 0;
+        }
+
+        .rule-table {
+            width: 100%;
+            border-collapse: collapse;
+            margin-bottom: 30px;
+        }
+
+        .rule-table th, .rule-table td {
+            text-align: left;
+            padding: 8px 12px;
+            border-bottom: 1px solid #e9ecef;
+        }
+
+        #issue-detail {
+            margin-top: 20px;
+        }
+    </style>
+)";
+}
+
+std::string HTMLReporter::getSplitReportScript() {
+    return R"(
+    <script>
+        // 问题数据字段: s=严重性下标 l=行 c=列 r=规则 d=描述 k=代码片段 g=修复建议
+        const SEVERITIES = ['CRITICAL', 'HIGH', 'MEDIUM', 'LOW', 'SUGGESTION'];
+        const COLORS = ['#dc3545', '#fd7e14', '#ffc107', '#17a2b8', '#28a745'];
+        const ROW_HEIGHT = 36;
+
+        // 数据分片通过 <script> 加载 (file:// 下 fetch 会被浏览器拦截)
+        const chunks = {};
+        const waiting = {};
+        window.cppReviewChunk = function(id, issues) {
+            chunks[id] = issues;
+            (waiting[id] || []).forEach(cb => cb(issues));
+            delete waiting[id];
+        };
+        function loadChunk(id, cb) {
+            if (chunks[id]) { cb(chunks[id]); return; }
+            if (waiting[id]) { waiting[id].push(cb); return; }
+            waiting[id] = [cb];
+            const script = document.createElement('script');
+            script.src = 'data/file-' + id + '.js';
+            script.onerror = () => { delete waiting[id]; alert('无法加载数据文件: ' + script.src); };
+            document.head.appendChild(script);
+        }
+
+        // 虚拟列表: 只渲染可视区域附近的行, 行数多少都不影响渲染速度
+        class VirtualList {
+            constructor(container, renderRow) {
+                this.container = container;
+                this.renderRow = renderRow;
+                this.items = [];
+                this.spacer = document.createElement('div');
+                this.spacer.style.position = 'relative';
+                container.appendChild(this.spacer);
+                container.addEventListener('scroll', () => this.draw());
+            }
+            setItems(items) {
+                this.items = items;
+                this.spacer.style.height = (items.length * ROW_HEIGHT) + 'px';
+                this.container.scrollTop = 0;
+                this.draw();
+            }
+            draw() {
+                const top = this.container.scrollTop;
+                const first = Math.max(0, Math.floor(top / ROW_HEIGHT) - 10);
+                const last = Math.min(this.items.length,
+                    Math.ceil((top + this.container.clientHeight) / ROW_HEIGHT) + 10);
+                this.spacer.textContent = '';
+                for (let i = first; i < last; i++) {
+                    const row = this.renderRow(this.items[i], i);
+                    row.classList.add('vrow');
+                    row.style.position = 'absolute';
+                    row.style.top = (i * ROW_HEIGHT) + 'px';
+                    row.style.height = ROW_HEIGHT + 'px';
+                    row.style.left = '0';
+                    row.style.right = '0';
+                    this.spacer.appendChild(row);
+                }
+            }
+        }
+
+        function el(tag, cls, text) {
+            const node = document.createElement(tag);
+            if (cls) node.className = cls;
+            if (text !== undefined) node.textContent = text;
+            return node;
+        }
+
+        let severityFilter = -1;
+        let currentFile = null;
+        let currentIssues = [];
+
+        const fileList = new VirtualList(document.getElementById('file-list'), (file) => {
+            const row = el('div');
+            const worst = file.counts.findIndex(c => c > 0);
+            const dot = el('span', 'dot');
+            dot.style.background = COLORS[worst < 0 ? 4 : worst];
+            row.appendChild(dot);
+            row.appendChild(el('span', 'path', file.path));
+            row.appendChild(el('span', 'count', severityFilter < 0 ? file.total : file.counts[severityFilter]));
+            if (file === currentFile) row.classList.add('selected');
+            row.onclick = () => openFile(file);
+            row.title = file.path;
+            return row;
+        });
+
+        const issueList = new VirtualList(document.getElementById('issue-list'), (issue) => {
+            const row = el('div');
+            const dot = el('span', 'dot');
+            dot.style.background = COLORS[issue.s];
+            row.appendChild(dot);
+            row.appendChild(el('span', 'loc', issue.l + ':' + issue.c));
+            row.appendChild(el('span', 'rule-id', issue.r));
+            row.appendChild(el('span', 'desc', issue.d));
+            row.onclick = () => showIssue(issue);
+            return row;
+        });
+
+        function refreshFiles() {
+            const query = document.getElementById('file-search').value.toLowerCase();
+            fileList.setItems(FILES.filter(f =>
+                (severityFilter < 0 || f.counts[severityFilter] > 0) &&
+                (!query || f.path.toLowerCase().includes(query))));
+        }
+
+        function refreshIssues() {
+            issueList.setItems(severityFilter < 0
+                ? currentIssues
+                : currentIssues.filter(i => i.s === severityFilter));
+        }
+
+        function openFile(file) {
+            currentFile = file;
+            fileList.draw();
+            document.getElementById('issue-title').textContent = '📄 ' + file.path;
+            document.getElementById('issue-detail').textContent = '';
+            loadChunk(file.chunk, (issues) => {
+                if (currentFile !== file) return;
+                currentIssues = issues;
+                refreshIssues();
+            });
+        }
+
+        function showIssue(issue) {
+            const detail = document.getElementById('issue-detail');
+            detail.textContent = '';
+            const card = el('div', 'issue-card');
+            card.style.borderLeftColor = COLORS[issue.s];
+            const header = el('div', 'issue-header');
+            header.appendChild(el('div', 'issue-number', issue.r));
+            const badge = el('div', 'severity-badge', SEVERITIES[issue.s]);
+            badge.style.backgroundColor = COLORS[issue.s];
+            header.appendChild(badge);
+            card.appendChild(header);
+            card.appendChild(el('div', 'location', '📍 ' + currentFile.path + ':' + issue.l + ':' + issue.c));
+            card.appendChild(el('div', 'description', '📝 ' + issue.d));
+            if (issue.h) card.appendChild(el('div', 'location', '👤 ' + issue.a + ' · ' + issue.h.substring(0, 12)));
+            if (issue.k) card.appendChild(el('div', 'code', issue.k));
+            if (issue.g) {
+                const suggestion = el('div', 'suggestion');
+                suggestion.appendChild(el('div', 'suggestion-title', '💡 修复建议:'));
+                const text = el('div', '', issue.g);
+                text.style.whiteSpace = 'pre-wrap';
+                suggestion.appendChild(text);
+                card.appendChild(suggestion);
+            }
+            detail.appendChild(card);
+        }
+
+        function filterIssues(severity, button) {
+            severityFilter = severity === 'all' ? -1 : SEVERITIES.indexOf(severity);
+            document.querySelectorAll('.filter-btn').forEach(btn => btn.classList.remove('active'));
+            button.classList.add('active');
+            refreshFiles();
+            refreshIssues();
+        }
+
+        document.getElementById('file-search').addEventListener('input', refreshFiles);
+        document.querySelector('.filter-btn').classList.add('active');
+        refreshFiles();
+    </script>
+)";
+}
+
+/**
+ * 生成分片 HTML 报告
+ * index.html 只包含汇总数据, 体积与问题数量无关 (只与文件数量相关);
+ * 每个源文件的问题写入独立的 data/file-N.js 分片
+ */
+void HTMLReporter::generateSplitHTMLReport(const Reporter& reporter, const std::string& output_dir) {
+    namespace fs = std::filesystem;
+
+    std::error_code ec;
+    fs::create_directories(fs::path(output_dir) / "data", ec);
+    if (ec) {
+        throw std::runtime_error("Failed to create output directory: " + output_dir + " (" + ec.message() + ")");
+    }
+
+    const auto& issues = reporter.getIssues();
+
+    // 按文件分组, 同时统计每个规则的各严重性数量
+    std::map<std::string, std::vector<const Issue*>> issues_by_file;
+    std::map<std::string, std::array<size_t, 5>> counts_by_rule;
+    for (const auto& issue : issues) {
+        issues_by_file[issue.file_path].push_back(&issue);
+        auto& counts = counts_by_rule.try_emplace(issue.rule_id, std::array<size_t, 5>{}).first->second;
+        counts[static_cast<size_t>(issue.severity)]++;
+    }
+
+    // 写入每个文件的数据分片
+    std::ostringstream files_json;
+    size_t chunk_id = 0;
+    for (auto& entry : issues_by_file) {
+        auto& file_issues = entry.second;
+        std::stable_sort(file_issues.begin(), file_issues.end(),
+                         [](const Issue* a, const Issue* b) {
+                             return a->line != b->line ? a->line < b->line : a->column < b->column;
+                         });
+
+        std::string chunk_path = (fs::path(output_dir) / "data" /
+                                  ("file-" + std::to_string(chunk_id) + ".js")).string();
+        std::ofstream chunk(chunk_path);
+        if (!chunk.is_open()) {
+            throw std::runtime_error("Failed to open output file: " + chunk_path);
+        }
+
+        std::array<size_t, 5> counts{};
+        chunk << "window.cppReviewChunk(" << chunk_id << ", [\n";
+        for (size_t i = 0; i < file_issues.size(); ++i) {
+            const Issue& issue = *file_issues[i];
+            counts[static_cast<size_t>(issue.severity)]++;
+
+            chunk << (i == 0 ? "" : ",\n");
+            chunk << "{\"s\":" << static_cast<int>(issue.severity)
+                  << ",\"l\":" << issue.line << ",\"c\":" << issue.column << ",\"r\":";
+            JSONUtils::writeString(chunk, issue.rule_id);
+            chunk << ",\"d\":";
+            JSONUtils::writeString(chunk, issue.description);
+            if (!issue.code_snippet.empty()) {
+                chunk << ",\"k\":";
+                JSONUtils::writeString(chunk, issue.code_snippet);
+            }
+            if (!issue.suggestion.empty() || !issue.ai_suggestion.empty()) {
+                chunk << ",\"g\":";
+                JSONUtils::writeString(chunk, issue.fullSuggestion());
+            }
+            if (!issue.blame_commit.empty()) {
+                chunk << ",\"a\":";
+                JSONUtils::writeString(chunk, issue.blame_author);
+                chunk << ",\"h\":";
+                JSONUtils::writeString(chunk, issue.blame_commit);
+            }
+            chunk << "}";
+        }
+        chunk << "\n]);\n";
+
+        // 文件汇总 (内嵌到 index.html)
+        files_json << (chunk_id == 0 ? "\n" : ",\n");
+        files_json << "{\"path\":\"" << JSONUtils::escape(entry.first) << "\",\"chunk\":" << chunk_id
+                   << ",\"total\":" << file_issues.size() << ",\"counts\":["
+                   << counts[0] << "," << counts[1] << "," << counts[2] << ","
+                   << counts[3] << "," << counts[4] << "]}";
+        ++chunk_id;
+    }
+
+    // 写入索引页
+    std::string index_path = (fs::path(output_dir) / "index.html").string();
+    std::ofstream file(index_path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open output file: " + index_path);
+    }
+
+    file << getHTMLHeader();
+    file << getSplitReportStyles();
+    writeSummary(file, issues);
+
+    file << "        <div class=\"issues\">\n";
+
+    // 规则汇总表
+    file << "            <h2>🏷️ 规则统计</h2>\n";
+    file << "            <table class=\"rule-table\">\n";
+    file << "                <tr><th>规则</th><th>严重</th><th>高</th><th>中</th><th>低</th><th>建议</th></tr>\n";
+    for (const auto& entry : counts_by_rule) {
+        file << "                <tr><td class=\"rule-id\">" << escapeHTML(entry.first) << "</td>";
+        for (size_t count : entry.second) {
+            file << "<td>" << count << "</td>";
+        }
+        file << "</tr>\n";
+    }
+    file << "            </table>\n";
+
+    // 文件列表 + 问题列表 (均为虚拟列表)
+    file << "            <h2>🔍 详细问题列表</h2>\n";
+    file << "            <div class=\"filter-buttons\">\n";
+    file << "                <button class=\"filter-btn\" onclick=\"filterIssues('all', this)\" style=\"background: #667eea; color: white;\">全部</button>\n";
+    file << "                <button class=\"filter-btn\" onclick=\"filterIssues('CRITICAL', this)\" style=\"background: #dc3545; color: white;\">严重</button>\n";
+    file << "                <button class=\"filter-btn\" onclick=\"filterIssues('HIGH', this)\" style=\"background: #fd7e14; color: white;\">高</button>\n";
+    file << "                <button class=\"filter-btn\" onclick=\"filterIssues('MEDIUM', this)\" style=\"background: #ffc107; color: #333;\">中</button>\n";
+    file << "                <button class=\"filter-btn\" onclick=\"filterIssues('LOW', this)\" style=\"background: #17a2b8; color: white;\">低</button>\n";
+    file << "                <button class=\"filter-btn\" onclick=\"filterIssues('SUGGESTION', this)\" style=\"background: #28a745; color: white;\">建议</button>\n";
+    file << "            </div>\n";
+    file << "            <div class=\"split-panels\">\n";
+    file << "                <div>\n";
+    file << "                    <div class=\"panel-title\">📁 文件 (" << issues_by_file.size() << ")</div>\n";
+    file << "                    <input id=\"file-search\" class=\"file-search\" placeholder=\"按路径过滤...\">\n";
+    file << "                    <div id=\"file-list\" class=\"vlist\"></div>\n";
+    file << "                </div>\n";
+    file << "                <div>\n";
+    file << "                    <div id=\"issue-title\" class=\"panel-title\">← 选择一个文件查看问题</div>\n";
+    file << "                    <div id=\"issue-list\" class=\"vlist\"></div>\n";
+    file << "                    <div id=\"issue-detail\"></div>\n";
+    file << "                </div>\n";
+    file << "            </div>\n";
+    file << "        </div>\n";
+
+    file << "        <div class=\"footer\">\n";
+    file << "            <p>🎯 由 C++ 智能代码审查 Agent 生成 | Made with ❤️ and ☕ by C++ Community</p>\n";
+    file << "            <p>Powered by Clang/LLVM AST Technology</p>\n";
+    file << "        </div>\n";
+    file << "    </div>\n";
+
+    // 文件汇总数据 (转义 "</" 避免提前结束 script 标签)
+    std::string files_data = files_json.str();
+    for (size_t pos = files_data.find("</"); pos != std::string::npos; pos = files_data.find("</", pos + 3)) {
+        files_data.replace(pos, 2, "<\\/");
+    }
+    file << "    <script>\n";
+    file << "        const FILES = [" << files_data << "\n        ];\n";
+    file << "    </script>\n";
+    file << getSplitReportScript();
+    file << "</body>\n";
+    file << "</html>\n";
+}
+
 } // namespace cpp_review
@@ -11,9 +11,17 @@ public:
     static void generateHTMLReport(const Reporter& reporter,
                                    const std::string& output_file);
 
+    // 大型报告: 输出目录下生成小型 index.html (按文件/规则汇总),
+    // 问题数据按文件切分为 data/file-N.js, 打开文件时才加载, 列表虚拟滚动渲染
+    static void generateSplitHTMLReport(const Reporter& reporter,
+                                        const std::string& output_dir);
+
 private:
     static std::string getHTMLHeader();
     static std::string getHTMLFooter();
+    static std::string getSplitReportStyles();
+    static std::string getSplitReportScript();
+    static void writeSummary(std::ostream& out, const std::vector<Issue>& issues);
     static std::string severityToHTML(Severity severity);
     static std::string severityToColor(Severity severity);
     static std::string escapeHTML(const std::string& input);
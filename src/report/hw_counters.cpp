@@ -0,0 +1,296 @@
+/*
+ * 硬件计数器剖析实现
+ */
+
+#include "report/hw_counters.h"
+#include "report/json_utils.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+namespace cpp_review {
+
+namespace {
+
+constexpr size_t kCounterCount = 4;
+
+// 各计数器未能打开时对应的 CounterValues::Unavailable 位 (周期数是组长, 必须可用)
+constexpr unsigned kUnavailableBits[kCounterCount] = {0, CounterValues::kInstructions,
+                                                      CounterValues::kCacheMisses,
+                                                      CounterValues::kBranchMisses};
+
+/**
+ * 当前线程的计数器组: 周期数为组长, 其余计数器与其同时调度
+ * 不支持的非组长计数器 (如部分虚拟机上的缓存未命中) 读数为 0, 并在 unavailable 中标出
+ */
+class CounterGroup {
+public:
+    ~CounterGroup() {
+        for (int fd : fds_) {
+            if (fd >= 0) ::close(fd);
+        }
+    }
+
+    bool open(std::string& error) {
+        if (opened_) {
+            error = error_;
+            return leader() >= 0;
+        }
+        opened_ = true;
+#ifdef __linux__
+        const uint64_t configs[kCounterCount] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                 PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (size_t i = 0; i < kCounterCount; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[i];
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                               PERF_FORMAT_TOTAL_TIME_RUNNING;
+            attr.disabled = i == 0 ? 1 : 0;
+
+            int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : leader(), 0));
+            if (fd < 0 && i == 0) {
+                error_ = std::string("perf_event_open: ") + std::strerror(errno);
+                if (errno == EACCES || errno == EPERM) {
+                    error_ += " (see /proc/sys/kernel/perf_event_paranoid)";
+                }
+                error = error_;
+                return false;
+            }
+            fds_[i] = fd;
+            if (fd < 0) {
+                unavailable_ |= kUnavailableBits[i];
+            } else {
+                uint64_t id = 0;
+                ioctl(fd, PERF_EVENT_IOC_ID, &id);
+                ids_[i] = id;
+            }
+        }
+        ioctl(leader(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        return true;
+#else
+        error_ = "perf_event_open is only available on Linux";
+        error = error_;
+        return false;
+#endif
+    }
+
+    bool read(CounterValues& values) const {
+        if (leader() < 0) return false;
+        // PERF_FORMAT_GROUP | PERF_FORMAT_ID | TOTAL_TIME_ENABLED | TOTAL_TIME_RUNNING:
+        // nr, time_enabled, time_running, 然后每个计数器 (value, id)
+        uint64_t buffer[3 + 2 * kCounterCount] = {};
+        if (::read(leader(), buffer, sizeof(buffer)) < static_cast<ssize_t>(3 * sizeof(uint64_t))) {
+            return false;
+        }
+        uint64_t raw[kCounterCount] = {};
+        for (uint64_t n = 0; n < buffer[0] && n < kCounterCount; ++n) {
+            for (size_t i = 0; i < kCounterCount; ++i) {
+                if (fds_[i] >= 0 && ids_[i] == buffer[4 + 2 * n]) {
+                    raw[i] = buffer[3 + 2 * n];
+                }
+            }
+        }
+        values.cycles = raw[0];
+        values.instructions = raw[1];
+        values.cache_misses = raw[2];
+        values.branch_misses = raw[3];
+        values.time_enabled = buffer[1];
+        values.time_running = buffer[2];
+        values.unavailable = unavailable_;
+        return true;
+    }
+
+private:
+    int leader() const { return fds_[0]; }
+
+    bool opened_ = false;
+    std::string error_;
+    int fds_[kCounterCount] = {-1, -1, -1, -1};
+    uint64_t ids_[kCounterCount] = {};
+    unsigned unavailable_ = 0;  // 未能打开的非组长计数器
+};
+
+CounterGroup& threadCounters() {
+    thread_local CounterGroup group;
+    return group;
+}
+
+double perKilo(uint64_t count, uint64_t instructions) {
+    return instructions > 0 ? 1000.0 * static_cast<double>(count) / static_cast<double>(instructions) : 0.0;
+}
+
+// 按 time_enabled / time_running 把分时复用期间的读数换算为整段时间的估计值
+uint64_t scaleCount(uint64_t count, uint64_t enabled, uint64_t running) {
+    return static_cast<uint64_t>(static_cast<double>(count) * static_cast<double>(enabled) /
+                                 static_cast<double>(running));
+}
+
+} // namespace
+
+CounterValues& CounterValues::operator+=(const CounterValues& other) {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    cache_misses += other.cache_misses;
+    branch_misses += other.branch_misses;
+    time_enabled += other.time_enabled;
+    time_running += other.time_running;
+    unavailable |= other.unavailable;
+    return *this;
+}
+
+CounterValues CounterValues::operator-(const CounterValues& other) const {
+    CounterValues delta;
+    delta.cycles = cycles - other.cycles;
+    delta.instructions = instructions - other.instructions;
+    delta.cache_misses = cache_misses - other.cache_misses;
+    delta.branch_misses = branch_misses - other.branch_misses;
+    delta.time_enabled = time_enabled - other.time_enabled;
+    delta.time_running = time_running - other.time_running;
+    delta.unavailable = unavailable | other.unavailable;
+    return delta;
+}
+
+bool HardwareProfile::probe(std::string& error) {
+    return threadCounters().open(error);
+}
+
+bool HardwareProfile::read(CounterValues& values) {
+    std::string error;
+    return threadCounters().open(error) && threadCounters().read(values);
+}
+
+void HardwareProfile::record(const std::string& file, const std::string& scope, const CounterValues& delta) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (delta.time_running == 0) {
+        // 计数器组在这段时间内一直没有被调度到 PMU 上, 读数没有意义
+        if (dropped_++ == 0) {
+            std::cerr << "Warning: Hardware counters were not scheduled during some measurements "
+                      << "(PMU busy or multiplexed), those samples are dropped\n";
+        }
+        return;
+    }
+    CounterValues scaled = delta;
+    if (delta.time_running < delta.time_enabled) {
+        scaled.cycles = scaleCount(delta.cycles, delta.time_enabled, delta.time_running);
+        scaled.instructions = scaleCount(delta.instructions, delta.time_enabled, delta.time_running);
+        scaled.cache_misses = scaleCount(delta.cache_misses, delta.time_enabled, delta.time_running);
+        scaled.branch_misses = scaleCount(delta.branch_misses, delta.time_enabled, delta.time_running);
+    }
+    samples_.push_back({file, scope, scaled});
+}
+
+void HardwareProfile::printSummary(std::ostream& out) const {
+    // 按范围汇总: 解析阶段在前, 规则按周期数从多到少
+    std::map<std::string, std::pair<CounterValues, size_t>> totals;
+    size_t dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& sample : samples_) {
+            auto& total = totals[sample.scope];
+            total.first += sample.values;
+            ++total.second;
+        }
+        dropped = dropped_;
+    }
+    if (totals.empty()) {
+        if (dropped > 0) {
+            out << "Hardware counters: all " << dropped << " sample(s) dropped, the counters never ran\n";
+        }
+        return;
+    }
+    std::vector<std::pair<std::string, std::pair<CounterValues, size_t>>> rows(totals.begin(), totals.end());
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        if ((a.first == kParseScope) != (b.first == kParseScope)) return a.first == kParseScope;
+        return a.second.first.cycles > b.second.first.cycles;
+    });
+
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << "Hardware counters (user space, summed over translation units):\n";
+    out << "  " << std::left << std::setw(24) << "scope" << std::right << std::setw(6) << "TUs"
+        << std::setw(14) << "Mcycles" << std::setw(8) << "IPC" << std::setw(12) << "cache-MPKI"
+        << std::setw(13) << "branch-MPKI" << "  bound\n";
+    out << std::fixed;
+    for (const auto& row : rows) {
+        const CounterValues& values = row.second.first;
+        bool has_instructions = !(values.unavailable & CounterValues::kInstructions);
+        bool has_cache = has_instructions && !(values.unavailable & CounterValues::kCacheMisses);
+        bool has_branch = has_instructions && !(values.unavailable & CounterValues::kBranchMisses);
+        double ipc = values.cycles > 0
+                         ? static_cast<double>(values.instructions) / static_cast<double>(values.cycles)
+                         : 0.0;
+        double cache_mpki = perKilo(values.cache_misses, values.instructions);
+        out << "  " << std::left << std::setw(24) << row.first << std::right << std::setw(6) << row.second.second
+            << std::setprecision(1) << std::setw(14) << static_cast<double>(values.cycles) / 1e6
+            << std::setprecision(2);
+        // 未能打开的计数器显示为 n/a, 没有缓存未命中数时也不判断受限类型
+        if (has_instructions) {
+            out << std::setw(8) << ipc;
+        } else {
+            out << std::setw(8) << "n/a";
+        }
+        if (has_cache) {
+            out << std::setw(12) << cache_mpki;
+        } else {
+            out << std::setw(12) << "n/a";
+        }
+        if (has_branch) {
+            out << std::setw(13) << perKilo(values.branch_misses, values.instructions);
+        } else {
+            out << std::setw(13) << "n/a";
+        }
+        out << "  " << (!has_cache ? "n/a" : cache_mpki >= kMemoryBoundMissesPerKiloInstruction ? "memory" : "compute")
+            << "\n";
+    }
+    if (dropped > 0) {
+        out << "  (" << dropped << " sample(s) dropped: the counters did not run during the measurement)\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void HardwareProfile::writeJSON(std::ostream& out, const std::string& indent) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    out << "[";
+    for (size_t i = 0; i < samples_.size(); ++i) {
+        const Sample& sample = samples_[i];
+        out << (i ? ",\n" : "\n") << indent << "  {\"file\": ";
+        JSONUtils::writeString(out, sample.file);
+        out << ", \"scope\": ";
+        JSONUtils::writeString(out, sample.scope);
+        // 未能打开的计数器写为 null
+        auto writeCount = [&](const char* name, uint64_t value, unsigned bit) {
+            out << ", \"" << name << "\": ";
+            if (sample.values.unavailable & bit) {
+                out << "null";
+            } else {
+                out << value;
+            }
+        };
+        out << ", \"cycles\": " << sample.values.cycles;
+        writeCount("instructions", sample.values.instructions, CounterValues::kInstructions);
+        writeCount("cache_misses", sample.values.cache_misses, CounterValues::kCacheMisses);
+        writeCount("branch_misses", sample.values.branch_misses, CounterValues::kBranchMisses);
+        out << ", \"time_enabled_ns\": " << sample.values.time_enabled
+            << ", \"time_running_ns\": " << sample.values.time_running << "}";
+    }
+    out << (samples_.empty() ? "]" : "\n" + indent + "]");
+}
+
+} // namespace cpp_review
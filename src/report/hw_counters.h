@@ -0,0 +1,104 @@
+/*
+ * 硬件计数器剖析头文件 (--hw-counters)
+ * 用 perf_event_open 在每次 Rule::check 调用和每个编译单元的解析前后读取
+ * 周期数、指令数、缓存未命中数和分支预测失败数, 按 (编译单元, 规则) 记录差值,
+ * 用于区分受内存访问限制 (缓存未命中多, IPC 低) 和受计算限制的规则访问者
+ *
+ * 计数器只统计用户态, 按线程打开 (每个分析线程第一次读取时打开自己的计数器组)。
+ * 内核不允许 (perf_event_paranoid、容器 seccomp) 或不支持时 open() 失败, 调用方关闭该模式
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace cpp_review {
+
+/**
+ * 一组硬件计数器的读数
+ */
+struct CounterValues {
+    // 未能打开的计数器 (读数为 0, 摘要中显示为 n/a)
+    enum Unavailable : unsigned {
+        kInstructions = 1u << 0,
+        kCacheMisses = 1u << 1,
+        kBranchMisses = 1u << 2,
+    };
+
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cache_misses = 0;
+    uint64_t branch_misses = 0;
+
+    // 计数器组启用和实际在 PMU 上运行的时间 (ns); 计数器数超过 PMU 容量时内核分时复用,
+    // 两者不同, 差值需按 time_enabled / time_running 缩放
+    uint64_t time_enabled = 0;
+    uint64_t time_running = 0;
+
+    unsigned unavailable = 0;  // Unavailable 位
+
+    CounterValues& operator+=(const CounterValues& other);
+    CounterValues operator-(const CounterValues& other) const;
+};
+
+/**
+ * 硬件计数器剖析结果
+ * 记录接口线程安全, 可在分析线程中调用
+ */
+class HardwareProfile {
+public:
+    // 解析阶段的记录名 (规则记录使用规则 ID)
+    static constexpr const char* kParseScope = "parse";
+
+    // 每千条指令的缓存未命中数达到该值时, 摘要中将该范围标为受内存限制
+    static constexpr double kMemoryBoundMissesPerKiloInstruction = 5.0;
+
+    /**
+     * 在当前线程打开计数器组, 检查是否可用 (启动时调用一次)
+     * @param error 输出: 不可用的原因
+     * @return 可用时返回 true
+     */
+    static bool probe(std::string& error);
+
+    /**
+     * 读取当前线程的计数器 (第一次调用时打开)
+     * @return 计数器不可用时返回 false
+     */
+    static bool read(CounterValues& values);
+
+    /**
+     * 记录一段代码的计数器差值
+     * 计数器组被分时复用时按运行时间比例缩放; 期间完全没有运行的差值丢弃 (第一次丢弃时警告)
+     * @param file 编译单元主文件
+     * @param scope kParseScope 或规则 ID
+     */
+    void record(const std::string& file, const std::string& scope, const CounterValues& delta);
+
+    /**
+     * 输出按范围 (解析阶段和各规则) 汇总的摘要: IPC、每千条指令的缓存未命中数和分支预测失败数
+     */
+    void printSummary(std::ostream& out) const;
+
+    /**
+     * 以 JSON 数组写出每个 (编译单元, 范围) 的记录
+     * @param indent 每行的缩进
+     */
+    void writeJSON(std::ostream& out, const std::string& indent) const;
+
+private:
+    struct Sample {
+        std::string file;
+        std::string scope;
+        CounterValues values;
+    };
+
+    mutable std::mutex mutex_;
+    std::vector<Sample> samples_;  // 按记录顺序 (已缩放)
+    size_t dropped_ = 0;           // 计数器组没有运行而丢弃的差值数
+};
+
+} // namespace cpp_review
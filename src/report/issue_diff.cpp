@@ -0,0 +1,65 @@
+/*
+ * 问题集合差异实现
+ */
+
+#include "report/issue_diff.h"
+#include "report/fingerprint.h"
+#include <unordered_map>
+
+namespace cpp_review {
+
+namespace {
+
+// 统计每个指纹出现的次数
+std::unordered_map<uint64_t, size_t> countFingerprints(const std::vector<Issue>& issues) {
+    std::unordered_map<uint64_t, size_t> counts;
+    counts.reserve(issues.size());
+    for (const auto& issue : issues) {
+        ++counts[Fingerprint::stableFingerprint(issue)];
+    }
+    return counts;
+}
+
+} // namespace
+
+IssueDiff IssueDiff::compute(const std::vector<Issue>& base, const std::vector<Issue>& head) {
+    IssueDiff diff;
+
+    auto base_counts = countFingerprints(base);
+    for (const auto& issue : head) {
+        auto it = base_counts.find(Fingerprint::stableFingerprint(issue));
+        if (it != base_counts.end() && it->second > 0) {
+            --it->second;
+            ++diff.unchanged;
+        } else {
+            diff.new_issues.push_back(issue);
+        }
+    }
+
+    auto head_counts = countFingerprints(head);
+    for (const auto& issue : base) {
+        auto it = head_counts.find(Fingerprint::stableFingerprint(issue));
+        if (it != head_counts.end() && it->second > 0) {
+            --it->second;
+        } else {
+            diff.fixed_issues.push_back(issue);
+        }
+    }
+
+    return diff;
+}
+
+void IssueDiff::writeFixedIssues(std::ostream& out) const {
+    if (fixed_issues.empty()) {
+        return;
+    }
+
+    out << "Fixed Issues (" << fixed_issues.size() << "):\n";
+    for (const auto& issue : fixed_issues) {
+        out << "  - [" << issue.rule_id << "] " << Fingerprint::normalizePath(issue.file_path)
+            << ":" << issue.line << " " << issue.description << "\n";
+    }
+    out << "\n";
+}
+
+} // namespace cpp_review
@@ -0,0 +1,39 @@
+/*
+ * 问题集合差异头文件
+ * PR 模式下比较 merge-base 与 HEAD 的分析结果, 区分新增与已修复的问题
+ */
+
+#pragma once
+
+#include "report/reporter.h"
+#include <ostream>
+#include <vector>
+
+namespace cpp_review {
+
+/**
+ * 两次分析结果的差异
+ *
+ * 按 Fingerprint::stableFingerprint 匹配 (不含行号, 代码上下移动不影响),
+ * 同一指纹出现多次时按次数配对, 多出来的才算新增或修复
+ */
+struct IssueDiff {
+    std::vector<Issue> new_issues;     // 只在 HEAD 中出现的问题
+    std::vector<Issue> fixed_issues;   // 只在 base 中出现的问题
+    size_t unchanged = 0;              // 两边都存在的问题数
+
+    /**
+     * 计算差异
+     * @param base merge-base 的问题列表
+     * @param head HEAD 的问题列表
+     */
+    static IssueDiff compute(const std::vector<Issue>& base, const std::vector<Issue>& head);
+
+    /**
+     * 输出已修复问题列表 (控制台与 PR 评论共用的 Markdown 友好格式)
+     * @param out 输出流
+     */
+    void writeFixedIssues(std::ostream& out) const;
+};
+
+} // namespace cpp_review
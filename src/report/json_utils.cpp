@@ -0,0 +1,181 @@
+/*
+ * JSON 工具实现
+ */
+
+#include "report/json_utils.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace cpp_review {
+
+std::string JSONUtils::escape(const std::string& value) {
+    std::string output;
+    output.reserve(value.size() + 8);
+
+    for (char c : value) {
+        switch (c) {
+            case '"':  output.append("\\\"");  break;
+            case '\\': output.append("\\\\");  break;
+            case '\n': output.append("\\n");   break;
+            case '\r': output.append("\\r");   break;
+            case '\t': output.append("\\t");   break;
+            case '\b': output.append("\\b");   break;
+            case '\f': output.append("\\f");   break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    // 其余控制字符使用 \u 转义
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+                    output.append(buffer);
+                } else {
+                    output.push_back(c);
+                }
+                break;
+        }
+    }
+
+    return output;
+}
+
+namespace {
+
+// 把 Unicode 码点编码为 UTF-8
+void appendUtf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+// 读取 4 位十六进制数
+bool readHex4(const std::string& text, size_t pos, uint32_t& value) {
+    if (pos + 4 > text.size()) return false;
+    value = 0;
+    for (size_t i = pos; i < pos + 4; ++i) {
+        char c = text[i];
+        value <<= 4;
+        if (c >= '0' && c <= '9') value |= static_cast<uint32_t>(c - '0');
+        else if (c >= 'a' && c <= 'f') value |= static_cast<uint32_t>(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') value |= static_cast<uint32_t>(c - 'A' + 10);
+        else return false;
+    }
+    return true;
+}
+
+bool isJSONSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/**
+ * 从 from 开始查找名为 key 的成员, 返回其值的起始位置
+ * 跳过作为字符串值 (而非成员名) 出现的情况; 找不到时返回 npos
+ */
+size_t findMemberValue(const std::string& text, const std::string& key, size_t from) {
+    const std::string quoted = "\"" + key + "\"";
+    for (size_t found = text.find(quoted, from); found != std::string::npos;
+         found = text.find(quoted, found + 1)) {
+        size_t pos = found + quoted.size();
+        while (pos < text.size() && isJSONSpace(text[pos])) ++pos;
+        if (pos >= text.size() || text[pos] != ':') continue;
+        ++pos;
+        while (pos < text.size() && isJSONSpace(text[pos])) ++pos;
+        return pos;
+    }
+    return std::string::npos;
+}
+
+} // namespace
+
+bool JSONUtils::readString(const std::string& text, size_t& pos, std::string& value) {
+    if (pos >= text.size() || text[pos] != '"') {
+        return false;
+    }
+    value.clear();
+
+    size_t i = pos + 1;
+    while (i < text.size()) {
+        char c = text[i++];
+        if (c == '"') {
+            pos = i;
+            return true;
+        }
+        if (c != '\\') {
+            value.push_back(c);
+            continue;
+        }
+        if (i >= text.size()) {
+            return false;
+        }
+        char escaped = text[i++];
+        switch (escaped) {
+            case '"':  value.push_back('"');  break;
+            case '\\': value.push_back('\\'); break;
+            case '/':  value.push_back('/');  break;
+            case 'n':  value.push_back('\n'); break;
+            case 'r':  value.push_back('\r'); break;
+            case 't':  value.push_back('\t'); break;
+            case 'b':  value.push_back('\b'); break;
+            case 'f':  value.push_back('\f'); break;
+            case 'u': {
+                uint32_t cp = 0;
+                if (!readHex4(text, i, cp)) return false;
+                i += 4;
+                // UTF-16 代理对
+                uint32_t low = 0;
+                if (cp >= 0xD800 && cp < 0xDC00 && i + 6 <= text.size() &&
+                    text[i] == '\\' && text[i + 1] == 'u' && readHex4(text, i + 2, low) &&
+                    low >= 0xDC00 && low < 0xE000) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    i += 6;
+                }
+                appendUtf8(value, cp);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return false;
+}
+
+bool JSONUtils::findString(const std::string& text, const std::string& key, std::string& value) {
+    for (size_t pos = findMemberValue(text, key, 0); pos != std::string::npos;
+         pos = findMemberValue(text, key, pos)) {
+        if (readString(text, pos, value)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JSONUtils::findNumber(const std::string& text, const std::string& key, double& value) {
+    for (size_t pos = findMemberValue(text, key, 0); pos != std::string::npos;
+         pos = findMemberValue(text, key, pos)) {
+        const char* begin = text.c_str() + pos;
+        char* end = nullptr;
+        double number = std::strtod(begin, &end);
+        if (end != begin) {
+            value = number;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JSONUtils::writeString(std::ostream& out, const std::string& value) {
+    out << '"' << escape(value) << '"';
+}
+
+} // namespace cpp_review
@@ -0,0 +1,53 @@
+/*
+ * JSON 工具头文件
+ * 提供流式输出所需的 JSON 字符串转义和字符串字面量读取, 不构建 DOM
+ */
+
+#pragma once
+
+#include <ostream>
+#include <string>
+
+namespace cpp_review {
+
+/**
+ * JSON 工具类
+ */
+class JSONUtils {
+public:
+    /**
+     * 将字符串以 JSON 字符串字面量的形式 (含双引号) 直接写入输出流
+     * @param out 输出流
+     * @param value 原始字符串 (UTF-8)
+     */
+    static void writeString(std::ostream& out, const std::string& value);
+
+    /**
+     * 返回 JSON 转义后的字符串 (不含双引号)
+     */
+    static std::string escape(const std::string& value);
+
+    /**
+     * 读取 JSON 字符串字面量 (解码转义序列, \u 转义转为 UTF-8)
+     * @param text JSON 文本
+     * @param pos 输入: 起始双引号的位置; 输出: 结束双引号之后的位置
+     * @param value 输出: 解码后的字符串
+     * @return 字面量完整且合法时返回 true
+     */
+    static bool readString(const std::string& text, size_t& pos, std::string& value);
+
+    /**
+     * 查找对象中第一个名为 key 的字符串成员并读取其值
+     * 只做文本扫描 (字符串内容中的转义引号不会误匹配), 适合提取响应中的单个字段
+     * @return 找到时返回 true
+     */
+    static bool findString(const std::string& text, const std::string& key, std::string& value);
+
+    /**
+     * 查找对象中第一个名为 key 的数值成员并读取其值 (扫描方式同 findString)
+     * @return 找到时返回 true
+     */
+    static bool findNumber(const std::string& text, const std::string& key, double& value);
+};
+
+} // namespace cpp_review
@@ -0,0 +1,135 @@
+/*
+ * 运行指标实现
+ */
+
+#include "report/metrics.h"
+#include "report/reporter.h"
+#include "report/run_stats.h"
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+namespace cpp_review {
+
+namespace {
+
+// 严重性标签值, 下标与 Severity 一致
+constexpr const char* kSeverityLabels[] = {"critical", "high", "medium", "low", "suggestion"};
+
+/**
+ * 当前常驻内存 (字节), 读取 /proc/self/statm; 不可用时返回 0
+ */
+size_t residentMemoryBytes() {
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    if (!(statm >> total_pages >> resident_pages)) {
+        return 0;
+    }
+    return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+// 标签值中的反斜杠、双引号和换行需要转义
+std::string escapeLabel(const std::string& value) {
+    std::string escaped;
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+void writeHeader(std::ostream& out, const char* name, const char* type, const char* help) {
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " " << type << "\n";
+}
+
+} // namespace
+
+void Metrics::observeRuleLatency(const std::string& rule_id, std::chrono::steady_clock::duration elapsed) {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    size_t bucket = 0;
+    while (bucket < kLatencyBuckets.size() && seconds > kLatencyBuckets[bucket]) {
+        ++bucket;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Histogram& histogram = rule_latency_[rule_id];
+    ++histogram.buckets[bucket];
+    ++histogram.count;
+    histogram.sum += seconds;
+}
+
+void Metrics::setLLMQueueDepth(std::function<size_t()> depth) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    llm_queue_depth_ = std::move(depth);
+}
+
+std::string Metrics::render() const {
+    std::ostringstream out;
+    out.precision(10);
+    size_t completed = completed_;
+    size_t queued = queued_;
+
+    writeHeader(out, "cpp_agent_files_completed_total", "counter", "Files whose analysis has finished.");
+    out << "cpp_agent_files_completed_total " << completed << "\n";
+    writeHeader(out, "cpp_agent_files_queued", "gauge", "Files waiting to be analyzed.");
+    out << "cpp_agent_files_queued " << (queued > completed ? queued - completed : 0) << "\n";
+
+    size_t hits = cache_hits_;
+    size_t misses = cache_misses_;
+    writeHeader(out, "cpp_agent_cache_lookups_total", "counter", "Result cache lookups by outcome.");
+    out << "cpp_agent_cache_lookups_total{result=\"hit\"} " << hits << "\n";
+    out << "cpp_agent_cache_lookups_total{result=\"miss\"} " << misses << "\n";
+    writeHeader(out, "cpp_agent_cache_hit_ratio", "gauge", "Fraction of result cache lookups that hit.");
+    out << "cpp_agent_cache_hit_ratio "
+        << (hits + misses > 0 ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0) << "\n";
+
+    if (reporter_) {
+        std::array<size_t, 5> counts = reporter_->getSeverityCounts();
+        writeHeader(out, "cpp_agent_issues", "gauge", "Reported issues by severity.");
+        for (size_t i = 0; i < counts.size(); ++i) {
+            out << "cpp_agent_issues{severity=\"" << kSeverityLabels[i] << "\"} " << counts[i] << "\n";
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (llm_queue_depth_) {
+        writeHeader(out, "cpp_agent_llm_queue_depth", "gauge", "Issue groups waiting for an AI suggestion request.");
+        out << "cpp_agent_llm_queue_depth " << llm_queue_depth_() << "\n";
+    }
+
+    writeHeader(out, "cpp_agent_rule_duration_seconds", "histogram",
+                "Time spent by a rule on one translation unit.");
+    for (const auto& entry : rule_latency_) {
+        std::string rule = escapeLabel(entry.first);
+        const Histogram& histogram = entry.second;
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < kLatencyBuckets.size(); ++i) {
+            cumulative += histogram.buckets[i];
+            out << "cpp_agent_rule_duration_seconds_bucket{rule=\"" << rule << "\",le=\"" << kLatencyBuckets[i]
+                << "\"} " << cumulative << "\n";
+        }
+        out << "cpp_agent_rule_duration_seconds_bucket{rule=\"" << rule << "\",le=\"+Inf\"} " << histogram.count
+            << "\n";
+        out << "cpp_agent_rule_duration_seconds_sum{rule=\"" << rule << "\"} " << histogram.sum << "\n";
+        out << "cpp_agent_rule_duration_seconds_count{rule=\"" << rule << "\"} " << histogram.count << "\n";
+    }
+
+    size_t resident = residentMemoryBytes();
+    if (resident > 0) {
+        writeHeader(out, "cpp_agent_resident_memory_bytes", "gauge", "Current resident set size.");
+        out << "cpp_agent_resident_memory_bytes " << resident << "\n";
+    }
+    writeHeader(out, "cpp_agent_peak_resident_memory_bytes", "gauge", "Peak resident set size.");
+    out << "cpp_agent_peak_resident_memory_bytes " << RunStats::peakRSSKilobytes() * 1024L << "\n";
+    return out.str();
+}
+
+} // namespace cpp_review
@@ -0,0 +1,96 @@
+/*
+ * 运行指标头文件
+ * 长时间扫描期间的实时指标, 由 MetricsServer 以 Prometheus 文本格式导出
+ *
+ * 导出的指标:
+ * - cpp_agent_files_completed_total        已完成分析的文件数 (counter)
+ * - cpp_agent_files_queued                 待分析的文件数 (gauge)
+ * - cpp_agent_rule_duration_seconds        每个规则在一个编译单元上的耗时 (histogram, 按 rule 标签)
+ * - cpp_agent_cache_lookups_total          结果缓存查询数 (counter, result="hit"|"miss")
+ * - cpp_agent_cache_hit_ratio              结果缓存命中率 (gauge)
+ * - cpp_agent_issues                       已报告的问题数 (gauge, 按 severity 标签)
+ * - cpp_agent_llm_queue_depth              等待请求 AI 建议的问题组数 (gauge)
+ * - cpp_agent_resident_memory_bytes        当前常驻内存 (gauge)
+ * - cpp_agent_peak_resident_memory_bytes   峰值常驻内存 (gauge)
+ *
+ * 计数接口线程安全, 可在分析线程中调用
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace cpp_review {
+
+class Reporter;
+
+/**
+ * 运行指标
+ */
+class Metrics {
+public:
+    // 规则耗时直方图的桶上界 (秒)
+    static constexpr std::array<double, 8> kLatencyBuckets = {0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1, 5};
+
+    /**
+     * 加入待分析的文件数
+     */
+    void addQueuedFiles(size_t count) { queued_ += count; }
+
+    /**
+     * 记录完成分析的文件数 (伞形编译单元按其包含的头文件数计)
+     */
+    void addCompletedFiles(size_t count) { completed_ += count; }
+
+    /**
+     * 记录一次结果缓存查询
+     */
+    void countCacheLookup(bool hit) { ++(hit ? cache_hits_ : cache_misses_); }
+
+    /**
+     * 记录规则在一个编译单元上的耗时
+     */
+    void observeRuleLatency(const std::string& rule_id, std::chrono::steady_clock::duration elapsed);
+
+    /**
+     * 设置问题来源: 导出时按严重性统计 (不转移所有权, 需在导出期间保持有效)
+     */
+    void setReporter(const Reporter* reporter) { reporter_ = reporter; }
+
+    /**
+     * 设置 AI 建议队列长度的来源 (可选)
+     */
+    void setLLMQueueDepth(std::function<size_t()> depth);
+
+    /**
+     * 生成 Prometheus 文本格式 (0.0.4) 的指标
+     */
+    std::string render() const;
+
+private:
+    // 单个规则的耗时直方图, 桶计数不累加 (导出时累加)
+    struct Histogram {
+        std::array<uint64_t, kLatencyBuckets.size() + 1> buckets{};  // 最后一个为 +Inf
+        uint64_t count = 0;
+        double sum = 0;
+    };
+
+    std::atomic<size_t> queued_{0};
+    std::atomic<size_t> completed_{0};
+    std::atomic<size_t> cache_hits_{0};
+    std::atomic<size_t> cache_misses_{0};
+    const Reporter* reporter_ = nullptr;
+
+    mutable std::mutex mutex_;                         // 保护 rule_latency_ 和 llm_queue_depth_
+    std::map<std::string, Histogram> rule_latency_;    // 规则 ID -> 耗时直方图
+    std::function<size_t()> llm_queue_depth_;
+};
+
+} // namespace cpp_review
@@ -0,0 +1,62 @@
+/*
+ * 指标服务器头文件
+ * 在本机回环地址上提供 GET /metrics (Prometheus 文本格式), 供长时间扫描期间的监控面板抓取
+ *
+ * 设计要点:
+ * - 只监听 127.0.0.1, 不对外暴露
+ * - 单个后台线程依次处理请求, 每个请求一个连接 (Connection: close)
+ * - 读写设置超时, 慢客户端不会阻塞后续抓取太久
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace cpp_review {
+
+class Metrics;
+
+/**
+ * 指标服务器
+ */
+class MetricsServer {
+public:
+    explicit MetricsServer(const Metrics& metrics);
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    /**
+     * 绑定端口并启动后台线程
+     * @param port 端口 (1-65535; 配置和命令行中的 0 表示关闭端点, 不会启动服务器)
+     * @param error 输出: 失败原因
+     * @return 成功返回 true
+     */
+    bool start(int port, std::string& error);
+
+    /**
+     * 停止后台线程并关闭监听套接字 (析构时自动调用)
+     */
+    void stop();
+
+    // 实际监听的端口
+    int getPort() const { return port_; }
+
+private:
+    // 后台线程: 等待连接并应答
+    void serveLoop();
+
+    // 处理一个连接
+    void handle(int client) const;
+
+    const Metrics& metrics_;
+    int listen_fd_ = -1;
+    int port_ = 0;
+    std::atomic<bool> stopping_{false};
+    std::thread thread_;
+};
+
+} // namespace cpp_review
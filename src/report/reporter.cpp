@@ -1,12 +1,111 @@
 #include "report/reporter.h"
+#include "report/fingerprint.h"
+#include "report/baseline.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include <utility>
 
 namespace cpp_review {
 
+namespace {
+
+// 规则建议与 AI 建议之间的分隔线
+const std::string kAISuggestionSeparator = "\n\n" + std::string(70, '=') + "\n";
+
+} // namespace
+
+std::string Issue::fullSuggestion() const {
+    if (ai_suggestion.empty()) {
+        return suggestion;
+    }
+    std::string full;
+    full.reserve(suggestion.size() + kAISuggestionSeparator.size() + ai_suggestion.size());
+    full += suggestion;
+    if (!suggestion.empty()) {
+        full += kAISuggestionSeparator;
+    }
+    full += ai_suggestion;
+    return full;
+}
+
 void Reporter::addIssue(const Issue& issue) {
+    if (observer_) {
+        observer_(issue);
+    }
+
+    // 位置未解析 (编译单元内收集阶段) 或没有有效行号的问题不参与去重
+    if (issue.hasPendingLocation() || issue.line == 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!acceptWithinLimit(issue)) return;
+        issues_.push_back(issue);
+        if (accepted_listener_) accepted_listener_(issue);
+        return;
+    }
+
+    // 在锁外计算指纹并查询基线 (基线只读, 无需加锁)
+    bool in_baseline = baseline_ && baseline_->contains(issue);
+    uint64_t fingerprint = Fingerprint::locationFingerprint(issue);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (in_baseline) {
+        ++suppressed_by_baseline_;
+        return;
+    }
+    if (!fingerprints_.insert(fingerprint).second) {
+        ++suppressed_duplicates_;
+        return;
+    }
+    if (!acceptWithinLimit(issue)) return;
     issues_.push_back(issue);
+    if (accepted_listener_) accepted_listener_(issue);
+}
+
+/**
+ * 检查提前终止条件 (调用方持有锁)
+ * 达到数量上限后的问题被丢弃; 接收的问题满足终止条件时置位 reached
+ */
+bool Reporter::acceptWithinLimit(const Issue& issue) {
+    if (!limit_) {
+        return true;
+    }
+    if (limit_->max_issues > 0 && issues_.size() >= limit_->max_issues) {
+        ++suppressed_by_limit_;
+        return false;
+    }
+    if (limit_->triggers(issue) ||
+        (limit_->max_issues > 0 && issues_.size() + 1 >= limit_->max_issues)) {
+        limit_->reached = true;
+    }
+    return true;
+}
+
+bool Reporter::wouldAccept(const Issue& issue) const {
+    if (baseline_ && baseline_->contains(issue)) {
+        return false;
+    }
+    uint64_t fingerprint = Fingerprint::locationFingerprint(issue);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (limit_ && limit_->max_issues > 0 && issues_.size() >= limit_->max_issues) {
+        return false;
+    }
+    return issue.line == 0 || fingerprints_.count(fingerprint) == 0;
+}
+
+std::vector<Issue> Reporter::takeIssues() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::exchange(issues_, {});
+}
+
+void Reporter::replaceIssues(std::vector<Issue> issues) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    issues_ = std::move(issues);
+}
+
+void Reporter::updateIssues(const std::function<void(std::vector<Issue>&)>& update) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    update(issues_);
 }
 
 size_t Reporter::getCriticalCount() const {
@@ -16,6 +115,15 @@ size_t Reporter::getCriticalCount() const {
                         });
 }
 
+std::array<size_t, 5> Reporter::getSeverityCounts() const {
+    std::array<size_t, 5> counts{};
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& issue : issues_) {
+        ++counts[static_cast<size_t>(issue.severity)];
+    }
+    return counts;
+}
+
 std::string Reporter::severityToString(Severity severity) const {
     switch (severity) {
         case Severity::CRITICAL: return "CRITICAL";
@@ -39,9 +147,7 @@ std::string Reporter::getSeverityColor(Severity severity) const {
     return "\033[0m"; // Reset
 }
 
-void Reporter::generateReport(std::ostream& out) const {
-    const std::string reset = "\033[0m";
-
+void Reporter::generateSummary(std::ostream& out) const {
     out << "\n";
     out << "╔══════════════════════════════════════════════════════════════════════╗\n";
     out << "║         C++ Code Review Report - Analysis Complete              ║\n";
@@ -61,7 +167,26 @@ void Reporter::generateReport(std::ostream& out) const {
     out << "  - Medium: " << severity_counts[Severity::MEDIUM] << "\n";
     out << "  - Low: " << severity_counts[Severity::LOW] << "\n";
     out << "  - Suggestions: " << severity_counts[Severity::SUGGESTION] << "\n";
+    if (suppressed_duplicates_ > 0) {
+        out << "  Duplicates suppressed: " << suppressed_duplicates_ << "\n";
+    }
+    if (suppressed_by_baseline_ > 0) {
+        out << "  Known issues (baseline): " << suppressed_by_baseline_ << "\n";
+    }
+    if (limit_ && limit_->reached) {
+        out << "  Analysis stopped early (--fail-fast / --max-issues)";
+        if (suppressed_by_limit_ > 0) {
+            out << ", " << suppressed_by_limit_ << " issue(s) over the limit dropped";
+        }
+        out << "\n";
+    }
     out << "\n";
+}
+
+void Reporter::generateReport(std::ostream& out) const {
+    const std::string reset = "\033[0m";
+
+    generateSummary(out);
 
     if (issues_.empty()) {
         out << "✓ No issues found! Your code looks good.\n";
@@ -80,14 +205,22 @@ void Reporter::generateReport(std::ostream& out) const {
         out << "Severity: " << color << severityToString(issue.severity) << reset << "\n";
         out << "Rule ID: " << issue.rule_id << "\n";
         out << "Description: " << issue.description << "\n";
+        if (!issue.blame_commit.empty()) {
+            out << "Author: " << issue.blame_author << " (" << issue.blame_commit.substr(0, 12) << ")\n";
+        }
 
         if (!issue.code_snippet.empty()) {
             out << "Code:\n";
             out << "  " << issue.code_snippet << "\n";
         }
 
-        if (!issue.suggestion.empty()) {
-            out << "Suggestion: " << issue.suggestion << "\n";
+        if (!issue.suggestion.empty() || !issue.ai_suggestion.empty()) {
+            // 共享的 AI 建议直接写出, 不拼接副本
+            out << "Suggestion: " << issue.suggestion;
+            if (!issue.suggestion.empty() && !issue.ai_suggestion.empty()) {
+                out << kAISuggestionSeparator;
+            }
+            out << issue.ai_suggestion << "\n";
         }
 
         out << "───────────────────────────────────────────────────────────────────────\n";
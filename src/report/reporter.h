@@ -5,12 +5,23 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 #include <vector>
 #include <map>
+#include <mutex>
+#include <unordered_set>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
 
 namespace cpp_review {
 
+class Baseline;
+
 /**
  * 严重性级别枚举
  * 从高到低: CRITICAL -> HIGH -> MEDIUM -> LOW -> SUGGESTION
@@ -29,36 +40,146 @@ enum class Severity {
  */
 struct Issue {
     std::string file_path;      // 文件路径
-    unsigned line;              // 行号
-    unsigned column;            // 列号
-    Severity severity;          // 严重性级别
+    unsigned line = 0;          // 行号
+    unsigned column = 0;        // 列号
+    Severity severity = Severity::MEDIUM;  // 严重性级别
     std::string rule_id;        // 规则 ID (如 NULL-PTR-001)
     std::string description;    // 问题描述
     std::string suggestion;     // 修复建议
     std::string code_snippet;   // 代码片段 (可选)
+    std::string enclosing_function;  // 所在函数的限定名 (用于基线指纹, 可选)
+    std::string blame_author;   // 最后修改该行的作者 (--blame, 可选)
+    std::string blame_commit;   // 最后修改该行的提交 (--blame, 可选)
+
+    // ===== AI 建议 (LLMEnhancer, 可选) =====
+    // 引用共享的文本而不是复制到 suggestion: 规则建议指向静态表,
+    // 模型生成的建议由 ai_suggestion_owner 持有, 同一规则或同一聚类的问题共用一份
+    std::string_view ai_suggestion;
+    std::shared_ptr<const std::string> ai_suggestion_owner;
+
+    // ===== 延迟解析的源码位置 =====
+    // 规则检测时只记录 clang::SourceLocation 的原始编码,
+    // 路径/行号/列号/代码片段在编译单元分析结束后由规则引擎统一解析
+    unsigned raw_location = 0;       // 问题位置的原始编码 (0 表示已解析或无位置)
+    unsigned raw_snippet_begin = 0;  // 代码片段范围起点的原始编码
+    unsigned raw_snippet_end = 0;    // 代码片段范围终点的原始编码
+
+    // 是否仍有未解析的位置信息
+    bool hasPendingLocation() const {
+        return raw_location != 0 || raw_snippet_begin != 0;
+    }
+
+    // 完整建议: 规则建议 + 分隔线 + AI 建议 (输出时才拼接)
+    std::string fullSuggestion() const;
+};
+
+/**
+ * 规则元数据
+ * 报告输出 (如 SARIF) 需要的规则描述信息, 不依赖 Clang 头文件
+ */
+struct RuleMetadata {
+    std::string id;             // 规则 ID
+    std::string name;           // 规则名称
+    std::string description;    // 规则描述
+};
+
+/**
+ * 提前终止条件 (--fail-fast / --max-issues)
+ * 最终报告器接收问题时检查, 达到后置位 reached, 分析流程据此取消剩余的编译单元
+ */
+struct IssueLimit {
+    std::optional<Severity> fail_at;   // 接收到该级别及以上的问题时停止
+    size_t max_issues = 0;             // 接收到这么多问题时停止 (0 表示不限)
+    std::atomic<bool> reached{false};  // 是否已达到终止条件
+
+    // 问题是否触发 --fail-fast
+    bool triggers(const Issue& issue) const { return fail_at && issue.severity <= *fail_at; }
 };
 
 /**
  * 报告生成器类
  * 收集所有问题并生成格式化的报告
+ *
+ * 已解析位置的问题按 (拼写位置, 规则, 规范化描述) 指纹全局去重,
+ * 共享头文件在多个编译单元中报告的同一问题只保留一次;
+ * addIssue 内部加锁, 可被多个分析线程同时调用
  */
 class Reporter {
 public:
-    // 添加一个问题到报告
+    // 添加一个问题到报告 (重复问题和基线中已有的问题会被丢弃)
     void addIssue(const Issue& issue);
 
+    // 设置基线: 基线中已记录的问题在 addIssue 时直接丢弃
+    void setBaseline(std::shared_ptr<const Baseline> baseline) { baseline_ = std::move(baseline); }
+
+    // 设置提前终止条件: 超过 max_issues 的问题被丢弃, 达到条件时置位 limit->reached
+    void setIssueLimit(std::shared_ptr<IssueLimit> limit) { limit_ = std::move(limit); }
+
+    // 问题 (已解析位置) 是否会被接收: 不在基线中、不是重复、未超过数量上限
+    bool wouldAccept(const Issue& issue) const;
+
+    /**
+     * 设置问题观察者: 每次 addIssue 时调用 (在锁外)
+     * 规则引擎用它在编译单元内发现足以终止分析的问题后请求停止遍历
+     */
+    void setIssueObserver(std::function<void(const Issue&)> observer) { observer_ = std::move(observer); }
+
+    /**
+     * 设置接收监听器: 问题通过基线、去重和数量上限后调用 (持有锁, 监听器不能回调报告器)
+     * AI 增强流水线用它在分析进行中提交问题
+     */
+    void setAcceptedIssueListener(std::function<void(const Issue&)> listener) {
+        accepted_listener_ = std::move(listener);
+    }
+
+    // 请求停止: 规则遍历在下一个声明处返回
+    void requestStop() { stop_requested_ = true; }
+
+    // 是否已请求停止 (或已达到提前终止条件)
+    bool stopRequested() const { return stop_requested_ || (limit_ && limit_->reached); }
+
+    // 规则遍历每进入一个 AST 节点 (声明或语句) 调用一次, 规则引擎据此统计每个规则访问的节点数
+    void countVisitedNode() { ++visited_nodes_; }
+
+    // 获取已访问的节点数
+    uint64_t getVisitedNodeCount() const { return visited_nodes_; }
+
     // 生成控制台报告
     void generateReport(std::ostream& out) const;
 
+    // 只生成控制台统计摘要 (不列出问题详情)
+    void generateSummary(std::ostream& out) const;
+
     // 获取问题总数
     size_t getIssueCount() const { return issues_.size(); }
 
     // 获取严重问题数量
     size_t getCriticalCount() const;
 
+    // 按严重性统计问题数 (下标为 Severity 的值; 加锁, 可在分析进行中从其他线程调用)
+    std::array<size_t, 5> getSeverityCounts() const;
+
+    // 获取因重复而被丢弃的问题数量
+    size_t getSuppressedDuplicateCount() const { return suppressed_duplicates_; }
+
+    // 获取因已在基线中而被丢弃的问题数量
+    size_t getBaselineSuppressedCount() const { return suppressed_by_baseline_; }
+
+    // 获取因超过 --max-issues 而被丢弃的问题数量
+    size_t getLimitSuppressedCount() const { return suppressed_by_limit_; }
+
     // 获取所有问题的只读访问
     const std::vector<Issue>& getIssues() const { return issues_; }
 
+    // 取走所有问题 (用于规则引擎在编译单元结束时统一解析位置)
+    std::vector<Issue> takeIssues();
+
+    // 替换问题列表 (不再去重/过滤; 用于 PR 模式只保留新增问题)
+    void replaceIssues(std::vector<Issue> issues);
+
+    // 在锁内原地修改问题列表 (不再去重/过滤; 列表始终完整, 用于 --blame 写回作者和提交)
+    void updateIssues(const std::function<void(std::vector<Issue>&)>& update);
+
     // 严重性转字符串
     std::string severityToString(Severity severity) const;
 
@@ -66,7 +187,27 @@ public:
     std::string getSeverityColor(Severity severity) const;
 
 private:
+    // 检查提前终止条件 (调用方持有锁), 返回是否接收该问题
+    bool acceptWithinLimit(const Issue& issue);
+
     std::vector<Issue> issues_;  // 所有检测到的问题列表
+
+    // ===== 全局去重索引 =====
+    mutable std::mutex mutex_;                    // 保护问题列表和去重索引
+    std::unordered_set<uint64_t> fingerprints_;   // 已接收问题的指纹
+    size_t suppressed_duplicates_ = 0;            // 被丢弃的重复问题数
+
+    // ===== 基线过滤 =====
+    std::shared_ptr<const Baseline> baseline_;    // 已知问题基线 (可选)
+    size_t suppressed_by_baseline_ = 0;           // 被基线过滤的问题数
+
+    // ===== 提前终止 =====
+    std::shared_ptr<IssueLimit> limit_;           // 提前终止条件 (可选)
+    size_t suppressed_by_limit_ = 0;              // 超过数量上限被丢弃的问题数
+    std::function<void(const Issue&)> observer_;  // 问题观察者 (可选)
+    std::function<void(const Issue&)> accepted_listener_;  // 接收监听器 (可选)
+    std::atomic<bool> stop_requested_{false};     // 编译单元内的停止请求
+    uint64_t visited_nodes_ = 0;                  // 规则遍历访问的节点数 (编译单元内的收集器)
 };
 
 } // namespace cpp_review
@@ -0,0 +1,164 @@
+/*
+ * 运行统计实现
+ */
+
+#include "report/run_stats.h"
+#include "report/hw_counters.h"
+#include "report/json_utils.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <sys/resource.h>
+
+namespace cpp_review {
+
+namespace {
+
+double millisecondsBetween(std::chrono::steady_clock::time_point begin,
+                           std::chrono::steady_clock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+double megabytes(double bytes) {
+    return bytes / (1024.0 * 1024.0);
+}
+
+void writeTranslationUnit(std::ostream& out, const TranslationUnitStats& unit) {
+    out << "    {\"file\": ";
+    JSONUtils::writeString(out, unit.file);
+    out << ", \"time_ms\": " << unit.time_ms
+        << ", \"ast_bytes\": " << unit.ast_bytes
+        << ", \"source_buffer_bytes\": " << unit.source_buffer_bytes
+        << ", \"source_manager_bytes\": " << unit.source_manager_bytes
+        << ", \"peak_rss_delta_kb\": " << unit.peak_rss_delta_kb
+        << ", \"decls\": " << unit.decls
+        << ", \"stmts\": " << unit.stmts
+        << ", \"rule_nodes\": {";
+    for (size_t i = 0; i < unit.rule_nodes.size(); ++i) {
+        out << (i ? ", " : "");
+        JSONUtils::writeString(out, unit.rule_nodes[i].first);
+        out << ": " << unit.rule_nodes[i].second;
+    }
+    out << "}}";
+}
+
+} // namespace
+
+RunStats::RunStats(Clock::time_point start) : start_(start), phase_start_(start) {}
+
+void RunStats::beginPhase(const std::string& phase) {
+    Clock::time_point now = Clock::now();
+    phase_ms_[current_] += millisecondsBetween(phase_start_, now);
+    phase_start_ = now;
+    for (size_t i = 0; i < kPhaseCount; ++i) {
+        if (phase == kPhases[i]) {
+            current_ = i;
+            return;
+        }
+    }
+}
+
+void RunStats::addTranslationUnit(TranslationUnitStats stats) {
+    std::lock_guard<std::mutex> lock(units_mutex_);
+    units_.push_back(std::move(stats));
+}
+
+void RunStats::printTranslationUnitSummary(std::ostream& out, size_t limit) const {
+    std::vector<const TranslationUnitStats*> units;
+    double ast_bytes = 0;
+    double source_bytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(units_mutex_);
+        for (const auto& unit : units_) {
+            units.push_back(&unit);
+            ast_bytes += unit.ast_bytes;
+            source_bytes += unit.source_buffer_bytes;
+        }
+    }
+    if (units.empty()) {
+        return;
+    }
+    std::sort(units.begin(), units.end(), [](const TranslationUnitStats* a, const TranslationUnitStats* b) {
+        return a->ast_bytes > b->ast_bytes;
+    });
+
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(1);
+    out << "Translation units: " << units.size() << " parsed, AST " << megabytes(ast_bytes)
+        << " MB, source buffers " << megabytes(source_bytes) << " MB, peak RSS "
+        << peakRSSKilobytes() / 1024 << " MB\n";
+    for (size_t i = 0; i < units.size() && i < limit; ++i) {
+        const TranslationUnitStats& unit = *units[i];
+        uint64_t visited = 0;
+        for (const auto& rule : unit.rule_nodes) {
+            visited += rule.second;
+        }
+        out << "  " << unit.file << ": AST " << megabytes(unit.ast_bytes) << " MB, source "
+            << megabytes(unit.source_buffer_bytes) << " MB, RSS +" << unit.peak_rss_delta_kb / 1024
+            << " MB, " << (unit.decls + unit.stmts) << " nodes, " << visited << " visited by rules, "
+            << unit.time_ms << " ms\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+long RunStats::peakRSSKilobytes() {
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  // macOS 以字节为单位
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+bool RunStats::write(const std::string& path, const Reporter& reporter) {
+    Clock::time_point now = Clock::now();
+    phase_ms_[current_] += millisecondsBetween(phase_start_, now);
+    phase_start_ = now;
+
+    std::array<size_t, 5> by_severity = reporter.getSeverityCounts();
+
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        return false;
+    }
+    out << std::fixed << std::setprecision(3);
+    out << "{\n";
+    out << "  \"wall_ms\": " << millisecondsBetween(start_, now) << ",\n";
+    out << "  \"peak_rss_kb\": " << peakRSSKilobytes() << ",\n";
+    out << "  \"files\": " << files_ << ",\n";
+    out << "  \"analyzed\": " << analyzed_ << ",\n";
+    out << "  \"issues\": " << reporter.getIssueCount() << ",\n";
+    out << "  \"critical\": " << by_severity[static_cast<size_t>(Severity::CRITICAL)] << ",\n";
+    out << "  \"high\": " << by_severity[static_cast<size_t>(Severity::HIGH)] << ",\n";
+    out << "  \"medium\": " << by_severity[static_cast<size_t>(Severity::MEDIUM)] << ",\n";
+    out << "  \"low\": " << by_severity[static_cast<size_t>(Severity::LOW)] << ",\n";
+    out << "  \"suggestion\": " << by_severity[static_cast<size_t>(Severity::SUGGESTION)] << ",\n";
+    out << "  \"phases\": {";
+    for (size_t i = 0; i < kPhaseCount; ++i) {
+        out << (i ? ", " : "") << "\"" << kPhases[i] << "_ms\": " << phase_ms_[i];
+    }
+    out << "},\n";
+    out << "  \"translation_units\": [";
+    {
+        std::lock_guard<std::mutex> lock(units_mutex_);
+        for (size_t i = 0; i < units_.size(); ++i) {
+            out << (i ? ",\n" : "\n");
+            writeTranslationUnit(out, units_[i]);
+        }
+        out << (units_.empty() ? "]" : "\n  ]");
+    }
+    if (hw_profile_) {
+        out << ",\n  \"hw_counters\": ";
+        hw_profile_->writeJSON(out, "  ");
+    }
+    out << "\n}\n";
+    return static_cast<bool>(out);
+}
+
+} // namespace cpp_review
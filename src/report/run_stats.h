@@ -0,0 +1,119 @@
+/*
+ * 运行统计头文件
+ * 记录一次运行的总耗时、各阶段耗时、峰值内存和问题数, 以 JSON 写入 --stats 指定的文件,
+ * 供语料库基准 (cpp-agent-bench corpus) 汇总和比较
+ *
+ * 阶段 (按执行顺序):
+ * - setup:   配置加载、文件枚举、规则注册
+ * - analyze: 解析编译单元并运行规则 (含 PR 模式的 merge-base 分析和比较)
+ * - blame:   问题作者标注
+ * - ai:      等待剩余的 AI 建议
+ * - report:  控制台/SARIF/HTML 报告、基线和 PR 评论
+ *
+ * 每个实际解析的编译单元另记一条内存统计 (translation_units), 用于找出需要单独调度的编译单元
+ */
+
+#pragma once
+
+#include "report/reporter.h"
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cpp_review {
+
+class HardwareProfile;
+
+/**
+ * 单个编译单元的资源统计
+ */
+struct TranslationUnitStats {
+    std::string file;                   // 主文件 (伞形编译单元为其虚拟路径)
+    double time_ms = 0;                 // 解析和运行规则的耗时
+    size_t ast_bytes = 0;               // ASTContext 分配器占用 (含侧表)
+    size_t source_buffer_bytes = 0;     // SourceManager 中文件缓冲区 (malloc + mmap)
+    size_t source_manager_bytes = 0;    // SourceManager 自身的数据结构
+    long peak_rss_delta_kb = 0;         // 本编译单元使进程峰值内存增加的量 (KB)
+    uint64_t decls = 0;                 // AST 声明节点数 (含隐式代码和模板实例化)
+    uint64_t stmts = 0;                 // AST 语句/表达式节点数
+    std::vector<std::pair<std::string, uint64_t>> rule_nodes;  // 每个规则访问的节点数
+};
+
+/**
+ * 运行统计
+ */
+class RunStats {
+public:
+    // 阶段名称, JSON 中的成员名为 "<阶段>_ms"
+    static constexpr const char* kPhases[] = {"setup", "analyze", "blame", "ai", "report"};
+    static constexpr size_t kPhaseCount = sizeof(kPhases) / sizeof(kPhases[0]);
+
+    /**
+     * @param start 运行开始时间 (setup 阶段从此刻开始)
+     */
+    explicit RunStats(std::chrono::steady_clock::time_point start);
+
+    /**
+     * 结束当前阶段并开始下一个阶段
+     * @param phase 阶段名称 (kPhases 之一); 跳过的阶段耗时为 0
+     */
+    void beginPhase(const std::string& phase);
+
+    /**
+     * 记录待分析的文件数和实际解析的文件数 (其余命中结果缓存)
+     */
+    void setFileCounts(size_t files, size_t analyzed) {
+        files_ = files;
+        analyzed_ = analyzed;
+    }
+
+    /**
+     * 记录一个编译单元的资源统计 (可在分析线程中调用)
+     */
+    void addTranslationUnit(TranslationUnitStats stats);
+
+    /**
+     * 输出编译单元内存摘要: 总量和 AST 占用最大的若干个编译单元
+     * @param limit 列出的编译单元数
+     */
+    void printTranslationUnitSummary(std::ostream& out, size_t limit = 5) const;
+
+    /**
+     * 设置硬件计数器剖析结果: 每个 (编译单元, 范围) 的记录写入 JSON 的 hw_counters
+     * @param profile 剖析结果 (不转移所有权)
+     */
+    void setHardwareProfile(const HardwareProfile* profile) { hw_profile_ = profile; }
+
+    /**
+     * 结束当前阶段并写入 JSON
+     * @param path 输出文件
+     * @param reporter 最终报告器 (统计各严重性的问题数)
+     * @return 写入成功返回 true
+     */
+    bool write(const std::string& path, const Reporter& reporter);
+
+    /**
+     * 进程的峰值常驻内存 (KB)
+     */
+    static long peakRSSKilobytes();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point start_;
+    Clock::time_point phase_start_;
+    size_t current_ = 0;                       // 当前阶段在 kPhases 中的序号
+    double phase_ms_[kPhaseCount] = {};
+    size_t files_ = 0;
+    size_t analyzed_ = 0;
+
+    mutable std::mutex units_mutex_;                  // 保护 units_
+    std::vector<TranslationUnitStats> units_;         // 按完成顺序
+    const HardwareProfile* hw_profile_ = nullptr;     // 硬件计数器剖析 (可选)
+};
+
+} // namespace cpp_review
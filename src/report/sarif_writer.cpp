@@ -0,0 +1,183 @@
+/*
+ * SARIF 2.1.0 报告输出实现
+ */
+
+#include "report/sarif_writer.h"
+#include "report/fingerprint.h"
+#include "report/json_utils.h"
+#include <filesystem>
+#include <stdexcept>
+
+namespace cpp_review {
+
+namespace fs = std::filesystem;
+
+const char* SarifWriter::severityToLevel(Severity severity) {
+    switch (severity) {
+        case Severity::CRITICAL:
+        case Severity::HIGH: return "error";
+        case Severity::MEDIUM: return "warning";
+        case Severity::LOW:
+        case Severity::SUGGESTION: return "note";
+    }
+    return "none";
+}
+
+/**
+ * 将文件路径转换为 SARIF artifactLocation URI
+ * 相对路径保持相对 (配合 %SRCROOT%), 绝对路径使用 file:// 形式
+ */
+std::string SarifWriter::toArtifactUri(const std::string& path) {
+    fs::path p = fs::path(path).lexically_normal();
+    std::string generic = p.generic_string();
+
+    std::string uri;
+    uri.reserve(generic.size() + 8);
+    if (p.is_absolute()) {
+        uri = "file://";
+    }
+
+    // 只转义 URI 中会产生歧义的字符
+    for (char c : generic) {
+        switch (c) {
+            case ' ': uri.append("%20"); break;
+            case '%': uri.append("%25"); break;
+            case '#': uri.append("%23"); break;
+            case '?': uri.append("%3F"); break;
+            default:  uri.push_back(c);  break;
+        }
+    }
+
+    return uri;
+}
+
+void SarifWriter::begin(const std::vector<RuleMetadata>& rules) {
+    out_ << "{\n";
+    out_ << "  \"$schema\": \"https://json.schemastore.org/sarif-2.1.0.json\",\n";
+    out_ << "  \"version\": \"2.1.0\",\n";
+    out_ << "  \"runs\": [\n";
+    out_ << "    {\n";
+    out_ << "      \"tool\": {\n";
+    out_ << "        \"driver\": {\n";
+    out_ << "          \"name\": \"cpp-agent\",\n";
+    out_ << "          \"version\": \"2.0.0\",\n";
+    out_ << "          \"rules\": [";
+
+    for (size_t i = 0; i < rules.size(); ++i) {
+        const auto& rule = rules[i];
+        rule_index_[rule.id] = i;
+
+        out_ << (i == 0 ? "\n" : ",\n");
+        out_ << "            {\"id\": ";
+        JSONUtils::writeString(out_, rule.id);
+        out_ << ", \"name\": ";
+        JSONUtils::writeString(out_, rule.name);
+        out_ << ", \"shortDescription\": {\"text\": ";
+        JSONUtils::writeString(out_, rule.name);
+        out_ << "}, \"fullDescription\": {\"text\": ";
+        JSONUtils::writeString(out_, rule.description);
+        out_ << "}}";
+    }
+
+    out_ << (rules.empty() ? "]\n" : "\n          ]\n");
+    out_ << "        }\n";
+    out_ << "      },\n";
+    out_ << "      \"originalUriBaseIds\": {\"%SRCROOT%\": {\"uri\": ";
+    JSONUtils::writeString(out_, "file://" + fs::current_path().generic_string() + "/");
+    out_ << "}},\n";
+    out_ << "      \"results\": [";
+}
+
+void SarifWriter::writeResult(const Issue& issue) {
+    out_ << (result_count_ == 0 ? "\n" : ",\n");
+    ++result_count_;
+
+    out_ << "        {\"ruleId\": ";
+    JSONUtils::writeString(out_, issue.rule_id);
+
+    auto it = rule_index_.find(issue.rule_id);
+    if (it != rule_index_.end()) {
+        out_ << ", \"ruleIndex\": " << it->second;
+    }
+
+    out_ << ", \"level\": \"" << severityToLevel(issue.severity) << "\"";
+    out_ << ", \"message\": {\"text\": ";
+    JSONUtils::writeString(out_, issue.description);
+    out_ << "}";
+
+    // 位置信息
+    out_ << ", \"locations\": [{\"physicalLocation\": {\"artifactLocation\": {\"uri\": ";
+    JSONUtils::writeString(out_, toArtifactUri(issue.file_path));
+    if (!fs::path(issue.file_path).is_absolute()) {
+        out_ << ", \"uriBaseId\": \"%SRCROOT%\"";
+    }
+    out_ << "}";
+    if (issue.line > 0) {
+        out_ << ", \"region\": {\"startLine\": " << issue.line;
+        if (issue.column > 0) {
+            out_ << ", \"startColumn\": " << issue.column;
+        }
+        if (!issue.code_snippet.empty()) {
+            out_ << ", \"snippet\": {\"text\": ";
+            JSONUtils::writeString(out_, issue.code_snippet);
+            out_ << "}";
+        }
+        out_ << "}";
+    }
+    out_ << "}}]";
+
+    // 与基线相同的稳定指纹, 供代码扫描平台跨提交追踪同一问题
+    out_ << ", \"partialFingerprints\": {\"cppAgentStable/v1\": \""
+         << Fingerprint::toHex(Fingerprint::stableFingerprint(issue)) << "\"}";
+
+    out_ << ", \"properties\": {\"severity\": \"";
+    switch (issue.severity) {
+        case Severity::CRITICAL: out_ << "CRITICAL"; break;
+        case Severity::HIGH: out_ << "HIGH"; break;
+        case Severity::MEDIUM: out_ << "MEDIUM"; break;
+        case Severity::LOW: out_ << "LOW"; break;
+        case Severity::SUGGESTION: out_ << "SUGGESTION"; break;
+    }
+    out_ << "\"";
+    if (!issue.suggestion.empty() || !issue.ai_suggestion.empty()) {
+        out_ << ", \"suggestion\": ";
+        JSONUtils::writeString(out_, issue.fullSuggestion());
+    }
+    if (!issue.blame_commit.empty()) {
+        out_ << ", \"blameAuthor\": ";
+        JSONUtils::writeString(out_, issue.blame_author);
+        out_ << ", \"blameCommit\": ";
+        JSONUtils::writeString(out_, issue.blame_commit);
+    }
+    out_ << "}}";
+}
+
+void SarifWriter::end() {
+    out_ << (result_count_ == 0 ? "]\n" : "\n      ]\n");
+    out_ << "    }\n";
+    out_ << "  ]\n";
+    out_ << "}\n";
+    out_.flush();
+}
+
+void SarifWriter::generateSarifReport(const Reporter& reporter,
+                                      const std::vector<RuleMetadata>& rules,
+                                      const std::string& output_file) {
+    std::ofstream file(output_file);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open output file: " + output_file);
+    }
+
+    SarifWriter writer(file);
+    writer.begin(rules);
+    for (const auto& issue : reporter.getIssues()) {
+        writer.writeResult(issue);
+    }
+    writer.end();
+
+    if (!file) {
+        throw std::runtime_error("Failed to write output file: " + output_file);
+    }
+}
+
+} // namespace cpp_review
@@ -0,0 +1,56 @@
+/*
+ * SARIF 2.1.0 报告输出头文件
+ * 供 CI 系统和代码扫描面板直接读取分析结果
+ */
+
+#pragma once
+
+#include "report/reporter.h"
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cpp_review {
+
+/**
+ * SARIF 流式写入器
+ *
+ * 按 begin -> writeResult* -> end 的顺序直接写入输出流, 不构建 JSON DOM;
+ * 规则元数据只在 begin 中输出一次, 每个结果通过 ruleIndex 引用,
+ * 因此内存占用与结果数量无关
+ */
+class SarifWriter {
+public:
+    explicit SarifWriter(std::ostream& out) : out_(out) {}
+
+    // 写入文件头和工具/规则元数据
+    void begin(const std::vector<RuleMetadata>& rules);
+
+    // 写入单个结果
+    void writeResult(const Issue& issue);
+
+    // 结束结果数组并关闭文档
+    void end();
+
+    /**
+     * 将报告器中的所有问题写入 SARIF 文件
+     * @param reporter 问题报告器
+     * @param rules 已注册规则的元数据
+     * @param output_file 输出文件路径
+     */
+    static void generateSarifReport(const Reporter& reporter,
+                                    const std::vector<RuleMetadata>& rules,
+                                    const std::string& output_file);
+
+private:
+    static const char* severityToLevel(Severity severity);
+    static std::string toArtifactUri(const std::string& path);
+
+    std::ostream& out_;
+    std::unordered_map<std::string, size_t> rule_index_;  // 规则 ID -> rules 数组下标
+    size_t result_count_ = 0;                             // 已写入的结果数
+};
+
+} // namespace cpp_review
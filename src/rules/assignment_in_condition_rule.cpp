@@ -21,22 +21,25 @@ bool AssignmentInConditionVisitor::hasAssignment(clang::Expr* expr) {
     return false;
 }
 
+Issue AssignmentInConditionVisitor::makeIssue() {
+    Issue issue;
+    issue.severity = Severity::HIGH;
+    issue.rule_id = "ASSIGN-COND-001";
+    issue.description = "Assignment operator (=) used in conditional expression. This is likely a bug - did you mean to use comparison operator (==)?";
+    issue.suggestion = "Replace '=' with '==' for comparison. If assignment was intentional, make it explicit by adding extra parentheses: if ((a = b))";
+    return issue;
+}
+
 void AssignmentInConditionVisitor::checkCondition(clang::Expr* cond, clang::SourceLocation loc) {
     if (!cond) return;
 
     if (hasAssignment(cond)) {
-        Issue issue;
-        issue.file_path = getFileName(loc);
-        issue.line = getLine(loc);
-        issue.column = getColumn(loc);
-        issue.severity = Severity::HIGH;
-        issue.rule_id = "ASSIGN-COND-001";
-        issue.description = "Assignment operator (=) used in conditional expression. This is likely a bug - did you mean to use comparison operator (==)?";
-        issue.suggestion = "Replace '=' with '==' for comparison. If assignment was intentional, make it explicit by adding extra parentheses: if ((a = b))";
+        Issue issue = makeIssue();
+        setIssueLocation(issue, loc);
 
         // Get code snippet
         clang::SourceRange range = cond->getSourceRange();
-        issue.code_snippet = getSourceText(range);
+        setIssueSnippet(issue, range);
 
         reporter_.addIssue(issue);
     }
@@ -62,4 +65,87 @@ void AssignmentInConditionRule::check(clang::ASTContext* context, Reporter& repo
     visitor.TraverseDecl(context->getTranslationUnitDecl());
 }
 
+/**
+ * 与 AST 版本一致: 条件去掉外层括号后是一个 "=" 赋值才报告
+ * "=" 的优先级最低, 括号外出现的 "=" 即是整个表达式的运算符;
+ * 条件中声明的变量 (if (int x = f())) 不是赋值
+ */
+bool AssignmentInConditionRule::isAssignment(const TokenStream& tokens, size_t first, size_t last) {
+    while (first < last && tokens[first].isPunct("(") && tokens.findClosing(first) == last) {
+        ++first;
+        --last;
+    }
+
+    int depth = 0;
+    for (size_t i = first; i <= last && i < tokens.size(); ++i) {
+        const LexToken& token = tokens[i];
+        if (token.isPunct("(") || token.isPunct("[") || token.isPunct("{")) {
+            ++depth;
+        } else if (token.isPunct(")") || token.isPunct("]") || token.isPunct("}")) {
+            --depth;
+        } else if (depth == 0 && token.isPunct(",")) {
+            return false;   // 逗号表达式
+        } else if (depth == 0 && token.isPunct("=")) {
+            // 声明: "类型 名称 =", 包括 "T* p =", "T& r =", "vector<T> v ="
+            for (size_t k = first; k + 1 < i; ++k) {
+                const LexToken& a = tokens[k];
+                const LexToken& b = tokens[k + 1];
+                if (!b.isIdentifier()) continue;
+                if (a.isIdentifier() || a.isPunct(">")) return false;
+                if ((a.isPunct("*") || a.isPunct("&") || a.isPunct("&&")) && k > first &&
+                    (tokens[k - 1].isIdentifier() || tokens[k - 1].isPunct(">"))) {
+                    return false;
+                }
+            }
+            return i > first && i < last;
+        }
+    }
+    return false;
+}
+
+void AssignmentInConditionRule::checkTokens(const TokenStream& tokens, Reporter& reporter) {
+    for (size_t i = 0; i + 1 < tokens.size(); ++i) {
+        const LexToken& keyword = tokens[i];
+        if (!keyword.isIdentifier()) continue;
+        bool is_for = keyword.text == "for";
+        if (keyword.text != "if" && keyword.text != "while" && !is_for) continue;
+
+        size_t open = i + 1;
+        if (keyword.text == "if" && tokens[open].text == "constexpr") ++open;
+        if (open >= tokens.size() || !tokens[open].isPunct("(")) continue;
+        size_t close = tokens.findClosing(open);
+        if (close >= tokens.size()) continue;
+
+        // 括号内顶层的 ";" 分隔初始化语句 (以及 for 的迭代表达式)
+        std::vector<size_t> semicolons;
+        int depth = 0;
+        for (size_t k = open + 1; k < close; ++k) {
+            const LexToken& token = tokens[k];
+            if (token.isPunct("(") || token.isPunct("[") || token.isPunct("{")) ++depth;
+            else if (token.isPunct(")") || token.isPunct("]") || token.isPunct("}")) --depth;
+            else if (depth == 0 && token.isPunct(";")) semicolons.push_back(k);
+        }
+
+        size_t first = open + 1;
+        size_t last = close - 1;
+        if (is_for) {
+            if (semicolons.size() != 2) continue;   // 范围 for 没有条件
+            first = semicolons[0] + 1;
+            last = semicolons[1] - 1;
+        } else if (!semicolons.empty()) {
+            first = semicolons.back() + 1;
+        }
+        if (first > last || last >= close) continue;
+
+        if (isAssignment(tokens, first, last)) {
+            Issue issue = AssignmentInConditionVisitor::makeIssue();
+            issue.file_path = tokens.path();
+            issue.line = keyword.line;
+            issue.column = keyword.column;
+            issue.code_snippet = tokens.text(first, last);
+            reporter.addIssue(issue);
+        }
+    }
+}
+
 } // namespace cpp_review
@@ -6,7 +6,7 @@
 
 namespace cpp_review {
 
-class AssignmentInConditionVisitor : public RuleVisitor {
+class AssignmentInConditionVisitor : public RuleVisitor<AssignmentInConditionVisitor> {
 public:
     using RuleVisitor::RuleVisitor;
 
@@ -14,6 +14,9 @@ public:
     bool VisitWhileStmt(clang::WhileStmt* stmt);
     bool VisitForStmt(clang::ForStmt* stmt);
 
+    // 构造问题 (位置由调用方设置)
+    static Issue makeIssue();
+
 private:
     void checkCondition(clang::Expr* cond, clang::SourceLocation loc);
     bool hasAssignment(clang::Expr* expr);
@@ -28,6 +31,14 @@ public:
     }
 
     void check(clang::ASTContext* context, Reporter& reporter) override;
+
+    // 只需要括号匹配和运算符记号
+    RuleTier getTier() const override { return RuleTier::LEXICAL; }
+    void checkTokens(const TokenStream& tokens, Reporter& reporter) override;
+
+private:
+    // 条件 [first, last] 是否 (去掉外层括号后) 整体是一个赋值表达式
+    static bool isAssignment(const TokenStream& tokens, size_t first, size_t last);
 };
 
 } // namespace cpp_review
@@ -42,9 +42,7 @@ bool BufferOverflowVisitor::VisitArraySubscriptExpr(clang::ArraySubscriptExpr* e
         if (tryGetConstantIndex(index, indexValue)) {
             if (indexValue < 0) {
                 Issue issue;
-                issue.file_path = context_->getSourceManager().getFilename(expr->getExprLoc()).str();
-                issue.line = context_->getSourceManager().getSpellingLineNumber(expr->getExprLoc());
-                issue.column = context_->getSourceManager().getSpellingColumnNumber(expr->getExprLoc());
+                setIssueLocation(issue, expr->getExprLoc());
                 issue.severity = Severity::CRITICAL;
                 issue.rule_id = "BUFFER-OVERFLOW-001";
 
@@ -72,9 +70,7 @@ bool BufferOverflowVisitor::VisitArraySubscriptExpr(clang::ArraySubscriptExpr* e
         // the unsigned cast, preventing signed/unsigned comparison issues. This is safe.
         if (indexValue < 0 || static_cast<uint64_t>(indexValue) >= arraySize) {
             Issue issue;
-            issue.file_path = context_->getSourceManager().getFilename(expr->getExprLoc()).str();
-            issue.line = context_->getSourceManager().getSpellingLineNumber(expr->getExprLoc());
-            issue.column = context_->getSourceManager().getSpellingColumnNumber(expr->getExprLoc());
+            setIssueLocation(issue, expr->getExprLoc());
             issue.severity = Severity::CRITICAL;
             issue.rule_id = "BUFFER-OVERFLOW-001";
 
@@ -97,9 +93,7 @@ bool BufferOverflowVisitor::VisitArraySubscriptExpr(clang::ArraySubscriptExpr* e
         // Only report for small arrays where overflow is more likely
         if (arraySize <= 10) {
             Issue issue;
-            issue.file_path = context_->getSourceManager().getFilename(expr->getExprLoc()).str();
-            issue.line = context_->getSourceManager().getSpellingLineNumber(expr->getExprLoc());
-            issue.column = context_->getSourceManager().getSpellingColumnNumber(expr->getExprLoc());
+            setIssueLocation(issue, expr->getExprLoc());
             issue.severity = Severity::LOW;
             issue.rule_id = "BUFFER-OVERFLOW-001";
 
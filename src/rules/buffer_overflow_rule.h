@@ -1,15 +1,13 @@
 #pragma once
 
 #include "rule.h"
-#include "clang/AST/RecursiveASTVisitor.h"
 #include <map>
 
 namespace cpp_review {
 
-class BufferOverflowVisitor : public clang::RecursiveASTVisitor<BufferOverflowVisitor> {
+class BufferOverflowVisitor : public RuleVisitor<BufferOverflowVisitor> {
 public:
-    explicit BufferOverflowVisitor(clang::ASTContext* context, Reporter& reporter)
-        : context_(context), reporter_(reporter) {}
+    using RuleVisitor::RuleVisitor;
 
     bool VisitArraySubscriptExpr(clang::ArraySubscriptExpr* expr);
     bool VisitVarDecl(clang::VarDecl* decl);
@@ -18,9 +16,6 @@ private:
     uint64_t getArraySize(const clang::VarDecl* decl);
     bool tryGetConstantIndex(clang::Expr* expr, int64_t& value);
 
-    clang::ASTContext* context_;
-    Reporter& reporter_;
-
     // Track array sizes for declared arrays
     std::map<const clang::VarDecl*, uint64_t> arraySizes_;
 };
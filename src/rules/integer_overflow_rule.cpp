@@ -74,9 +74,7 @@ void IntegerOverflowVisitor::checkArithmeticOverflow(clang::BinaryOperator* op)
 
     if (shouldReport) {
         Issue issue;
-        issue.file_path = context_->getSourceManager().getFilename(op->getExprLoc()).str();
-        issue.line = context_->getSourceManager().getSpellingLineNumber(op->getExprLoc());
-        issue.column = context_->getSourceManager().getSpellingColumnNumber(op->getExprLoc());
+        setIssueLocation(issue, op->getExprLoc());
         issue.severity = maxBits <= 16 ? Severity::HIGH : Severity::MEDIUM;
         issue.rule_id = "INTEGER-OVERFLOW-001";
 
@@ -152,9 +150,7 @@ void IntegerOverflowVisitor::checkNarrowingConversion(clang::Expr* expr, clang::
     // Check for narrowing conversion
     if (sourceBits > targetBits) {
         Issue issue;
-        issue.file_path = context_->getSourceManager().getFilename(loc).str();
-        issue.line = context_->getSourceManager().getSpellingLineNumber(loc);
-        issue.column = context_->getSourceManager().getSpellingColumnNumber(loc);
+        setIssueLocation(issue, loc);
         issue.severity = Severity::MEDIUM;
         issue.rule_id = "INTEGER-OVERFLOW-001";
 
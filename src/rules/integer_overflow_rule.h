@@ -1,14 +1,12 @@
 #pragma once
 
 #include "rule.h"
-#include "clang/AST/RecursiveASTVisitor.h"
 
 namespace cpp_review {
 
-class IntegerOverflowVisitor : public clang::RecursiveASTVisitor<IntegerOverflowVisitor> {
+class IntegerOverflowVisitor : public RuleVisitor<IntegerOverflowVisitor> {
 public:
-    explicit IntegerOverflowVisitor(clang::ASTContext* context, Reporter& reporter)
-        : context_(context), reporter_(reporter) {}
+    using RuleVisitor::RuleVisitor;
 
     bool VisitBinaryOperator(clang::BinaryOperator* op);
     bool VisitCStyleCastExpr(clang::CStyleCastExpr* cast);
@@ -19,9 +17,6 @@ private:
     void checkNarrowingConversion(clang::Expr* expr, clang::QualType targetType, clang::SourceLocation loc);
     bool isIntegerType(clang::QualType type);
     unsigned getIntegerBitWidth(clang::QualType type);
-
-    clang::ASTContext* context_;
-    Reporter& reporter_;
 };
 
 class IntegerOverflowRule : public Rule {
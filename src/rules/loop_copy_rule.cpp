@@ -55,9 +55,7 @@ bool LoopCopyVisitor::isExpensiveCopy(clang::VarDecl* decl) {
 bool LoopCopyVisitor::LoopBodyVisitor::VisitVarDecl(clang::VarDecl* decl) {
     if (parent_->isExpensiveCopy(decl)) {
         Issue issue;
-        issue.file_path = parent_->getFileName(decl->getLocation());
-        issue.line = parent_->getLine(decl->getLocation());
-        issue.column = parent_->getColumn(decl->getLocation());
+        setIssueLocation(issue, decl->getLocation());
         issue.severity = Severity::MEDIUM;
         issue.rule_id = "LOOP-COPY-001";
 
@@ -73,7 +71,7 @@ bool LoopCopyVisitor::LoopBodyVisitor::VisitVarDecl(clang::VarDecl* decl) {
                           "Or use std::move if the original value is no longer needed:\n" +
                           "  " + typeName + " " + varName + " = std::move(...);";
 
-        issue.code_snippet = parent_->getSourceText(decl->getSourceRange());
+        setIssueSnippet(issue, decl->getSourceRange());
 
         parent_->reporter_.addIssue(issue);
     }
@@ -109,9 +107,7 @@ bool LoopCopyVisitor::VisitCXXForRangeStmt(clang::CXXForRangeStmt* rangeStmt) {
                 clang::QualType type = varDecl->getType();
                 if (isContainerType(type) || isClassType(type)) {
                     Issue issue;
-                    issue.file_path = getFileName(varDecl->getLocation());
-                    issue.line = getLine(varDecl->getLocation());
-                    issue.column = getColumn(varDecl->getLocation());
+                    setIssueLocation(issue, varDecl->getLocation());
                     issue.severity = Severity::MEDIUM;
                     issue.rule_id = "LOOP-COPY-001";
 
@@ -126,7 +122,7 @@ bool LoopCopyVisitor::VisitCXXForRangeStmt(clang::CXXForRangeStmt* rangeStmt) {
                                       "Or use reference if you need to modify:\n" +
                                       "  for (auto& " + varName + " : container) { ... }";
 
-                    issue.code_snippet = getSourceText(rangeStmt->getSourceRange());
+                    setIssueSnippet(issue, rangeStmt->getSourceRange());
 
                     reporter_.addIssue(issue);
                 }
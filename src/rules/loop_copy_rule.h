@@ -6,7 +6,7 @@
 
 namespace cpp_review {
 
-class LoopCopyVisitor : public RuleVisitor {
+class LoopCopyVisitor : public RuleVisitor<LoopCopyVisitor> {
 public:
     using RuleVisitor::RuleVisitor;
 
@@ -26,6 +26,12 @@ private:
 
         bool VisitVarDecl(clang::VarDecl* decl);
 
+        // 循环体的重复遍历同样计入规则访问的节点数
+        bool TraverseStmt(clang::Stmt* stmt, DataRecursionQueue* queue = nullptr) {
+            parent_->reporter_.countVisitedNode();
+            return clang::RecursiveASTVisitor<LoopBodyVisitor>::TraverseStmt(stmt, queue);
+        }
+
     private:
         LoopCopyVisitor* parent_;
     };
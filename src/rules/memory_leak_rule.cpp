@@ -104,9 +104,7 @@ void MemoryLeakVisitor::checkForLeak(const clang::VarDecl* decl, const Allocatio
 
     // Potential memory leak detected
     Issue issue;
-    issue.file_path = getFileName(info.location);
-    issue.line = getLine(info.location);
-    issue.column = getColumn(info.location);
+    setIssueLocation(issue, info.location);
     issue.severity = Severity::HIGH;
     issue.rule_id = "MEMORY-LEAK-001";
 
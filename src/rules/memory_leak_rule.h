@@ -9,7 +9,7 @@
 
 namespace cpp_review {
 
-class MemoryLeakVisitor : public RuleVisitor {
+class MemoryLeakVisitor : public RuleVisitor<MemoryLeakVisitor> {
 public:
     using RuleVisitor::RuleVisitor;
 
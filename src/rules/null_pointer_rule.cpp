@@ -1,6 +1,5 @@
 #include "rules/null_pointer_rule.h"
 #include <clang/AST/ASTContext.h>
-#include <clang/Lex/Lexer.h>
 
 namespace cpp_review {
 
@@ -37,9 +36,7 @@ void NullPointerVisitor::checkForNullDereference(clang::Expr* expr, clang::Sourc
 
     if (isNullPointer(expr)) {
         Issue issue;
-        issue.file_path = getFileName(loc);
-        issue.line = getLine(loc);
-        issue.column = getColumn(loc);
+        setIssueLocation(issue, loc);
         issue.severity = Severity::CRITICAL;
         issue.rule_id = "NULL-PTR-001";
         issue.description = "Dereferencing a null pointer will cause undefined behavior and likely crash";
@@ -47,7 +44,7 @@ void NullPointerVisitor::checkForNullDereference(clang::Expr* expr, clang::Sourc
 
         // Get code snippet
         clang::SourceRange range = expr->getSourceRange();
-        issue.code_snippet = getSourceText(range);
+        setIssueSnippet(issue, range);
 
         reporter_.addIssue(issue);
     }
@@ -77,33 +74,6 @@ bool NullPointerVisitor::VisitBinaryOperator(clang::BinaryOperator* op) {
     return true;
 }
 
-std::string RuleVisitor::getFileName(clang::SourceLocation loc) const {
-    if (loc.isInvalid()) return "<unknown>";
-    return context_->getSourceManager().getFilename(loc).str();
-}
-
-unsigned RuleVisitor::getLine(clang::SourceLocation loc) const {
-    if (loc.isInvalid()) return 0;
-    return context_->getSourceManager().getSpellingLineNumber(loc);
-}
-
-unsigned RuleVisitor::getColumn(clang::SourceLocation loc) const {
-    if (loc.isInvalid()) return 0;
-    return context_->getSourceManager().getSpellingColumnNumber(loc);
-}
-
-std::string RuleVisitor::getSourceText(clang::SourceRange range) const {
-    if (range.isInvalid()) return "";
-
-    clang::SourceManager& sm = context_->getSourceManager();
-    clang::LangOptions lo;
-
-    clang::CharSourceRange charRange = clang::CharSourceRange::getTokenRange(range);
-    llvm::StringRef text = clang::Lexer::getSourceText(charRange, sm, lo);
-
-    return text.str();
-}
-
 void NullPointerRule::check(clang::ASTContext* context, Reporter& reporter) {
     NullPointerVisitor visitor(context, reporter);
     visitor.TraverseDecl(context->getTranslationUnitDecl());
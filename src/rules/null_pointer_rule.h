@@ -7,7 +7,7 @@
 
 namespace cpp_review {
 
-class NullPointerVisitor : public RuleVisitor {
+class NullPointerVisitor : public RuleVisitor<NullPointerVisitor> {
 public:
     using RuleVisitor::RuleVisitor;
 
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "report/reporter.h"
+#include "parser/token_stream.h"
 #include <clang/AST/ASTContext.h>
 #include <clang/AST/RecursiveASTVisitor.h>
 #include <string>
@@ -17,6 +18,35 @@
 
 namespace cpp_review {
 
+/**
+ * 记录问题位置 (延迟解析)
+ * 只保存 SourceLocation 的原始编码, 不在检测时查询 SourceManager;
+ * 规则引擎会在编译单元结束、去重之后批量解析为路径/行号/列号
+ */
+inline void setIssueLocation(Issue& issue, clang::SourceLocation loc) {
+    issue.raw_location = loc.getRawEncoding();
+}
+
+/**
+ * 记录代码片段范围 (延迟解析)
+ * 片段文本在规则引擎的批量解析阶段才通过 Lexer 提取
+ */
+inline void setIssueSnippet(Issue& issue, clang::SourceRange range) {
+    if (range.isInvalid()) return;
+    issue.raw_snippet_begin = range.getBegin().getRawEncoding();
+    issue.raw_snippet_end = range.getEnd().getRawEncoding();
+}
+
+/**
+ * 规则所需的分析级别
+ * - LEXICAL: 只需要标识符和简单语法, 可以在原始记号流上运行 (--fast)
+ * - SEMANTIC: 需要完整的语义分析 AST (类型、声明解析、控制流)
+ */
+enum class RuleTier {
+    LEXICAL,
+    SEMANTIC
+};
+
 /**
  * 规则基类
  * 所有分析规则都必须继承此类并实现虚函数
@@ -43,6 +73,18 @@ public:
      * @param reporter 用于收集问题的报告器
      */
     virtual void check(clang::ASTContext* context, Reporter& reporter) = 0;
+
+    // 规则所需的分析级别 (默认需要完整 AST)
+    virtual RuleTier getTier() const { return RuleTier::SEMANTIC; }
+
+    /**
+     * 在记号流上检查 (LEXICAL 级别的规则实现)
+     * 只有所有启用的规则都是 LEXICAL 级别时才会走这条路径,
+     * 否则仍在 AST 上调用 check() 获得更精确的结果
+     * @param tokens 单个文件的记号流
+     * @param reporter 用于收集问题的报告器 (位置直接给出, 无需延迟解析)
+     */
+    virtual void checkTokens(const TokenStream& tokens, Reporter& reporter) {}
 };
 
 /**
@@ -50,24 +92,40 @@ public:
  * 规则可以继承此类来遍历 AST
  *
  * 使用 Clang 的 RecursiveASTVisitor 递归访问所有 AST 节点
- * 子类可以重写 Visit* 方法来检查特定类型的节点
+ * RecursiveASTVisitor 通过模板参数 (CRTP) 静态分派 Visit* 方法,
+ * 子类以自身作为模板参数继承 (class XxxVisitor : public RuleVisitor<XxxVisitor>),
+ * 重写的 Visit* 方法才会被调用
  */
-class RuleVisitor : public clang::RecursiveASTVisitor<RuleVisitor> {
+template <class Derived>
+class RuleVisitor : public clang::RecursiveASTVisitor<Derived> {
 public:
+    using Base = clang::RecursiveASTVisitor<Derived>;
+    using DataRecursionQueue = typename Base::DataRecursionQueue;
+
     RuleVisitor(clang::ASTContext* context, Reporter& reporter)
         : context_(context), reporter_(reporter) {}
 
     virtual ~RuleVisitor() = default;
 
+    // 只分析模板的主模式, 不遍历实例化后的副本
+    // (同一模板的每个实例化都会重复报告同一位置的问题)
+    bool shouldVisitTemplateInstantiations() const { return false; }
+
+    // 提前终止 (--fail-fast / --max-issues) 时在下一个声明处停止遍历
+    bool TraverseDecl(clang::Decl* decl) {
+        if (reporter_.stopRequested()) return false;
+        reporter_.countVisitedNode();
+        return Base::TraverseDecl(decl);
+    }
+
+    bool TraverseStmt(clang::Stmt* stmt, DataRecursionQueue* queue = nullptr) {
+        reporter_.countVisitedNode();
+        return Base::TraverseStmt(stmt, queue);
+    }
+
 protected:
     clang::ASTContext* context_;  // AST 上下文
     Reporter& reporter_;          // 报告器
-
-    // 辅助方法: 获取源码位置信息
-    std::string getFileName(clang::SourceLocation loc) const;
-    unsigned getLine(clang::SourceLocation loc) const;
-    unsigned getColumn(clang::SourceLocation loc) const;
-    std::string getSourceText(clang::SourceRange range) const;
 };
 
 } // namespace cpp_review
@@ -4,10 +4,68 @@
  */
 
 #include "rules/rule_engine.h"
+#include "report/hw_counters.h"
+#include "report/metrics.h"
+#include <clang/AST/RecursiveASTVisitor.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Lex/Lexer.h>
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace cpp_review {
 
+/**
+ * 编译单元中所有带函数体的函数的偏移范围
+ * 按 FileID 分组, 每组按起点排序, 供位置解析阶段二分查找问题所在函数
+ */
+struct FunctionRangeIndex {
+    // 函数体在文件中的偏移范围
+    struct Range {
+        unsigned begin;
+        unsigned end;
+        std::string name;
+    };
+
+    std::map<clang::FileID, std::vector<Range>> ranges;
+};
+
+namespace {
+
+/**
+ * 收集编译单元中所有带函数体的函数的偏移范围
+ */
+class FunctionRangeCollector : public clang::RecursiveASTVisitor<FunctionRangeCollector> {
+public:
+    FunctionRangeCollector(const clang::SourceManager& sm, FunctionRangeIndex& index) : sm_(sm), index_(index) {}
+
+    bool VisitFunctionDecl(clang::FunctionDecl* func) {
+        if (!func->doesThisDeclarationHaveABody()) return true;
+
+        auto begin = sm_.getDecomposedExpansionLoc(func->getBeginLoc());
+        auto end = sm_.getDecomposedExpansionLoc(func->getEndLoc());
+        if (begin.first.isInvalid() || begin.first != end.first) return true;
+
+        index_.ranges[begin.first].push_back({begin.second, end.second, func->getQualifiedNameAsString()});
+        return true;
+    }
+
+private:
+    const clang::SourceManager& sm_;
+    FunctionRangeIndex& index_;
+};
+
+// 编译单元内问题的去重键: 同一位置、同一规则、同一描述视为同一问题
+std::string issueKey(const Issue& issue) {
+    return std::to_string(issue.raw_location) + '\0' + issue.rule_id + '\0' + issue.description;
+}
+
+} // namespace
+
 // 默认构造函数
 RuleEngine::RuleEngine() = default;
 
@@ -19,20 +77,319 @@ void RuleEngine::registerRule(std::unique_ptr<Rule> rule) {
     rules_.push_back(std::move(rule));
 }
 
+/**
+ * 收集所有已注册规则的元数据
+ */
+std::vector<RuleMetadata> RuleEngine::getRuleMetadata() const {
+    std::vector<RuleMetadata> metadata;
+    metadata.reserve(rules_.size());
+    for (const auto& rule : rules_) {
+        metadata.push_back({rule->getRuleId(), rule->getRuleName(), rule->getDescription()});
+    }
+    return metadata;
+}
+
 /**
  * 依次运行所有已注册的规则
  * 每个规则独立运行,一个规则失败不影响其他规则
  */
-void RuleEngine::runAllRules(clang::ASTContext* context, Reporter& reporter) {
-    for (auto& rule : rules_) {
+bool RuleEngine::runAllRules(clang::ASTContext* context, Reporter& reporter,
+                             const std::vector<std::string>& scope_files, RuleVisitCounts* visits) {
+    if (limitReached()) {
+        return false;
+    }
+
+    // 编译单元内的问题收集器: 位置信息保持未解析状态
+    Reporter collector;
+    size_t candidates = 0;
+    std::unordered_set<std::string> probed;
+    // 函数范围在第一次需要时收集, 提前终止检查和最终的位置解析共用
+    std::unique_ptr<FunctionRangeIndex> functions;
+    if (limit_ && gate_) {
+        collector.setIssueObserver([&](const Issue& issue) {
+            checkIssueLimit(*context, issue, collector, probed, candidates, functions);
+        });
+    }
+
+    const clang::SourceManager& sm = context->getSourceManager();
+    std::string main_file;
+    if (scopes_ || hw_profile_) {
+        main_file = sm.getFilename(sm.getLocForStartOfFile(sm.getMainFileID())).str();
+    }
+
+    // 主文件 (或指定文件) 上生效的规则集合
+    RuleMask enabled = ~RuleMask{0};
+    if (scopes_) {
+        if (scope_files.empty()) {
+            enabled = scopes_->resolve(main_file).enabled;
+        } else {
+            enabled = 0;
+            for (const auto& file : scope_files) {
+                enabled |= scopes_->resolve(file).enabled;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < rules_.size(); ++i) {
+        auto& rule = rules_[i];
+        if (i < RuleScopes::kMaxRules && !(enabled & (RuleMask{1} << i))) {
+            continue;
+        }
+        if (collector.stopRequested() || limitReached()) {
+            break;
+        }
+        uint64_t visited = collector.getVisitedNodeCount();
+        auto started = metrics_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+        CounterValues counters_before;
+        bool counted = hw_profile_ && HardwareProfile::read(counters_before);
         try {
             // 运行单个规则的检查逻辑
-            rule->check(context, reporter);
+            rule->check(context, collector);
         } catch (const std::exception& e) {
             // 捕获异常,避免单个规则错误导致整个分析失败
             std::cerr << "Error running rule " << rule->getRuleId()
                      << ": " << e.what() << "\n";
         }
+        CounterValues counters_after;
+        if (counted && HardwareProfile::read(counters_after)) {
+            hw_profile_->record(main_file, rule->getRuleId(), counters_after - counters_before);
+        }
+        if (metrics_) {
+            metrics_->observeRuleLatency(rule->getRuleId(), std::chrono::steady_clock::now() - started);
+        }
+        if (visits) {
+            visits->emplace_back(rule->getRuleId(), collector.getVisitedNodeCount() - visited);
+        }
+    }
+
+    // 去重并批量解析位置, 然后转交给最终的报告器
+    std::vector<Issue> issues = collector.takeIssues();
+    resolveIssueLocations(*context, issues, functions);
+    if (scopes_) {
+        applyRuleScopes(issues);
+    }
+
+    for (const auto& issue : issues) {
+        reporter.addIssue(issue);
+    }
+    if (metrics_) {
+        // 伞形编译单元一次完成本批所有头文件
+        metrics_->addCompletedFiles(scope_files.empty() ? 1 : scope_files.size());
+    }
+    return !collector.stopRequested();
+}
+
+/**
+ * 检查编译单元内的问题是否满足提前终止条件
+ * 没有规则范围时, 原始严重性不满足 --fail-fast 且未设置 --max-issues 的问题直接跳过;
+ * 其余问题解析位置并应用规则范围后, 由最终报告器判断是否会被接收;
+ * 同一问题重复上报 (例如嵌套循环中被多次检查的循环体) 只计一次, 与最终去重一致
+ */
+void RuleEngine::checkIssueLimit(clang::ASTContext& context, const Issue& issue, Reporter& collector,
+                                 std::unordered_set<std::string>& probed, size_t& candidates,
+                                 std::unique_ptr<FunctionRangeIndex>& functions) const {
+    if (collector.stopRequested() || issue.raw_location == 0) {
+        return;
+    }
+    // 规则范围可能调高严重性, 此时不能按原始严重性提前跳过
+    if (!scopes_ && !limit_->triggers(issue) && limit_->max_issues == 0) {
+        return;
+    }
+    if (!probed.insert(issueKey(issue)).second) {
+        return;
+    }
+
+    std::vector<Issue> probe = {issue};
+    resolveIssueLocations(context, probe, functions);
+    if (scopes_) {
+        applyRuleScopes(probe);
+    }
+    if (probe.empty() || !gate_->wouldAccept(probe.front())) {
+        return;
+    }
+
+    ++candidates;
+    if (limit_->triggers(probe.front()) ||
+        (limit_->max_issues > 0 && gate_->getIssueCount() + candidates >= limit_->max_issues)) {
+        collector.requestStop();
+    }
+}
+
+/**
+ * 在记号流上运行词法级规则
+ * 规则直接给出路径/行号/列号, 不经过位置解析阶段
+ */
+void RuleEngine::runLexicalRules(const TokenStream& tokens, Reporter& reporter) {
+    if (limitReached()) {
+        return;
+    }
+    Reporter collector;
+
+    RuleMask enabled = scopes_ ? scopes_->resolve(tokens.path()).enabled : ~RuleMask{0};
+    for (size_t i = 0; i < rules_.size(); ++i) {
+        auto& rule = rules_[i];
+        if (rule->getTier() != RuleTier::LEXICAL) continue;
+        if (i < RuleScopes::kMaxRules && !(enabled & (RuleMask{1} << i))) continue;
+        auto started = metrics_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+        try {
+            rule->checkTokens(tokens, collector);
+        } catch (const std::exception& e) {
+            std::cerr << "Error running rule " << rule->getRuleId()
+                     << ": " << e.what() << "\n";
+        }
+        if (metrics_) {
+            metrics_->observeRuleLatency(rule->getRuleId(), std::chrono::steady_clock::now() - started);
+        }
+    }
+
+    std::vector<Issue> issues = collector.takeIssues();
+    if (scopes_) {
+        applyRuleScopes(issues);
+    }
+    for (const auto& issue : issues) {
+        reporter.addIssue(issue);
+    }
+    if (metrics_) {
+        metrics_->addCompletedFiles(1);
+    }
+}
+
+bool RuleEngine::requiresSemanticAnalysis() const {
+    return std::any_of(rules_.begin(), rules_.end(), [](const std::unique_ptr<Rule>& rule) {
+        return rule->getTier() != RuleTier::LEXICAL;
+    });
+}
+
+/**
+ * 批量解析问题位置
+ * 只对去重后保留下来的问题查询 SourceManager 和提取代码片段,
+ * LangOptions 直接复用编译单元的配置
+ */
+void RuleEngine::resolveIssueLocations(clang::ASTContext& context, std::vector<Issue>& issues,
+                                       std::unique_ptr<FunctionRangeIndex>& functions) const {
+    const clang::SourceManager& sm = context.getSourceManager();
+    const clang::LangOptions& lang_opts = context.getLangOpts();
+
+    // 同一位置、同一规则、同一描述的问题只保留一个
+    std::unordered_set<std::string> seen;
+    std::vector<Issue> unique_issues;
+    unique_issues.reserve(issues.size());
+
+    for (auto& issue : issues) {
+        if (issue.raw_location != 0 && !seen.insert(issueKey(issue)).second) {
+            continue;
+        }
+        unique_issues.push_back(std::move(issue));
+    }
+
+    if (resolve_enclosing_functions_ && !unique_issues.empty()) {
+        resolveEnclosingFunctions(context, unique_issues, functions);
+    }
+
+    for (auto& issue : unique_issues) {
+        if (issue.raw_location != 0) {
+            clang::SourceLocation loc = clang::SourceLocation::getFromRawEncoding(issue.raw_location);
+            // 宏展开中的问题归属到拼写位置所在的文件
+            issue.file_path = sm.getFilename(sm.getSpellingLoc(loc)).str();
+            issue.line = sm.getSpellingLineNumber(loc);
+            issue.column = sm.getSpellingColumnNumber(loc);
+            issue.raw_location = 0;
+        } else if (issue.file_path.empty()) {
+            issue.file_path = "<unknown>";
+        }
+
+        if (issue.raw_snippet_begin != 0) {
+            clang::SourceRange range(
+                clang::SourceLocation::getFromRawEncoding(issue.raw_snippet_begin),
+                clang::SourceLocation::getFromRawEncoding(issue.raw_snippet_end));
+            if (issue.code_snippet.empty()) {
+                clang::CharSourceRange char_range = clang::CharSourceRange::getTokenRange(range);
+                issue.code_snippet = clang::Lexer::getSourceText(char_range, sm, lang_opts).str();
+            }
+            issue.raw_snippet_begin = 0;
+            issue.raw_snippet_end = 0;
+        }
+    }
+
+    issues = std::move(unique_issues);
+}
+
+/**
+ * 应用问题所在文件的规则范围
+ * 头文件中的问题按头文件路径的设置处理, 同一文件只查询一次
+ */
+void RuleEngine::applyRuleScopes(std::vector<Issue>& issues) const {
+    std::unordered_map<std::string, RuleSettings> settings_by_file;
+    std::vector<Issue> kept;
+    kept.reserve(issues.size());
+
+    for (auto& issue : issues) {
+        auto it = settings_by_file.find(issue.file_path);
+        if (it == settings_by_file.end()) {
+            it = settings_by_file.emplace(issue.file_path, scopes_->resolve(issue.file_path)).first;
+        }
+        const RuleSettings& settings = it->second;
+
+        int index = scopes_->ruleIndex(issue.rule_id);
+        if (index >= 0) {
+            if (!(settings.enabled & (RuleMask{1} << index))) {
+                continue;
+            }
+            if (settings.severity[index]) {
+                issue.severity = *settings.severity[index];
+            }
+        }
+        kept.push_back(std::move(issue));
+    }
+
+    issues = std::move(kept);
+}
+
+/**
+ * 查找问题所在的函数
+ * 每个编译单元只遍历一次 AST 收集函数范围, 每个问题通过二分查找定位最内层的函数
+ */
+void RuleEngine::resolveEnclosingFunctions(clang::ASTContext& context, std::vector<Issue>& issues,
+                                           std::unique_ptr<FunctionRangeIndex>& functions) {
+    const clang::SourceManager& sm = context.getSourceManager();
+
+    if (!functions) {
+        functions = std::make_unique<FunctionRangeIndex>();
+        FunctionRangeCollector collector(sm, *functions);
+        collector.TraverseDecl(context.getTranslationUnitDecl());
+        for (auto& entry : functions->ranges) {
+            std::sort(entry.second.begin(), entry.second.end(),
+                      [](const FunctionRangeIndex::Range& a, const FunctionRangeIndex::Range& b) {
+                          return a.begin < b.begin;
+                      });
+        }
+    }
+
+    const auto& ranges = functions->ranges;
+    for (auto& issue : issues) {
+        if (issue.raw_location == 0) continue;
+
+        clang::SourceLocation loc = clang::SourceLocation::getFromRawEncoding(issue.raw_location);
+        auto decomposed = sm.getDecomposedExpansionLoc(loc);
+        auto it = ranges.find(decomposed.first);
+        if (it == ranges.end()) continue;
+
+        const auto& file_ranges = it->second;
+        unsigned offset = decomposed.second;
+
+        // 从起点不超过 offset 的最后一个函数向前查找,
+        // 第一个包含 offset 的即为最内层函数 (嵌套函数范围互相包含)
+        auto upper = std::upper_bound(file_ranges.begin(), file_ranges.end(), offset,
+                                      [](unsigned value, const FunctionRangeIndex::Range& range) {
+                                          return value < range.begin;
+                                      });
+        while (upper != file_ranges.begin()) {
+            --upper;
+            if (upper->end >= offset) {
+                issue.enclosing_function = upper->name;
+                break;
+            }
+        }
     }
 }
 
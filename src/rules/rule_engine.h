@@ -7,12 +7,23 @@
 
 #include "rules/rule.h"
 #include "report/reporter.h"
+#include "config/rule_scope.h"
 #include <clang/AST/ASTContext.h>
+#include <string>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 #include <memory>
 
 namespace cpp_review {
 
+class HardwareProfile;
+class Metrics;
+struct FunctionRangeIndex;
+
+// 每个规则在一个编译单元上访问的 AST 节点数 (规则 ID, 节点数), 按运行顺序
+using RuleVisitCounts = std::vector<std::pair<std::string, uint64_t>>;
+
 /**
  * 规则引擎类
  * 负责注册、管理和执行所有分析规则
@@ -30,10 +41,33 @@ public:
 
     /**
      * 在给定的 AST 上运行所有注册的规则
+     * 规则先把问题写入编译单元内部的收集器, 结束后统一去重并解析位置,
+     * 再转交给 reporter (此时 SourceManager 仍然有效)
      * @param context Clang AST 上下文
      * @param reporter 用于收集问题的报告器
+     * @param scope_files 计算启用规则所用的文件 (为空时使用编译单元主文件;
+     *                    伞形编译单元传入其包含的头文件, 取各文件启用规则的并集)
+     * @param visits 非空时追加每个已运行规则访问的节点数 (--stats)
+     * @return 规则完整运行返回 true; 因提前终止而中断时返回 false
+     *         (不完整的结果不能写入缓存)
+     */
+    bool runAllRules(clang::ASTContext* context, Reporter& reporter,
+                     const std::vector<std::string>& scope_files = {},
+                     RuleVisitCounts* visits = nullptr);
+
+    /**
+     * 在单个文件的记号流上运行 LEXICAL 级别的规则 (无需预处理和语义分析)
+     * 按文件的规则范围过滤并应用严重性覆盖
+     * @param tokens 记号流
+     * @param reporter 用于收集问题的报告器
      */
-    void runAllRules(clang::ASTContext* context, Reporter& reporter);
+    void runLexicalRules(const TokenStream& tokens, Reporter& reporter);
+
+    /**
+     * 是否有规则需要完整的语义分析
+     * 全部为 LEXICAL 级别时可以只做词法切分, 跳过 Clang 前端
+     */
+    bool requiresSemanticAnalysis() const;
 
     /**
      * 获取已注册的规则数量
@@ -41,8 +75,100 @@ public:
      */
     size_t getRuleCount() const { return rules_.size(); }
 
+    /**
+     * 获取所有已注册规则的元数据 (按注册顺序)
+     * @return 规则 ID/名称/描述列表
+     */
+    std::vector<RuleMetadata> getRuleMetadata() const;
+
+    /**
+     * 是否在位置解析阶段查找问题所在的函数
+     * 基线指纹需要函数名; 该查找需要额外遍历一次 AST, 默认关闭
+     */
+    void setResolveEnclosingFunctions(bool enabled) { resolve_enclosing_functions_ = enabled; }
+
+    /**
+     * 设置按路径编译的规则范围
+     * 主文件上未启用的规则不会运行; 问题按所在文件过滤并应用严重性覆盖
+     * @param scopes 已编译的规则范围 (序号需与注册顺序一致), nullptr 表示全部启用
+     */
+    void setRuleScopes(std::shared_ptr<const RuleScopes> scopes) { scopes_ = std::move(scopes); }
+
+    /**
+     * 设置提前终止条件 (--fail-fast / --max-issues)
+     * 编译单元内发现会被最终报告器接收并满足条件的问题时, 立即停止其余规则和遍历;
+     * 条件达到后不再分析新的编译单元
+     * @param limit 终止条件
+     * @param gate 最终报告器 (判断问题是否会被基线/去重丢弃)
+     */
+    void setIssueLimit(std::shared_ptr<IssueLimit> limit, const Reporter* gate) {
+        limit_ = std::move(limit);
+        gate_ = gate;
+    }
+
+    bool hasIssueLimit() const { return limit_ != nullptr; }
+
+    /**
+     * 设置运行指标: 记录每个规则在每个编译单元上的耗时和完成的文件数 (--metrics-port)
+     * @param metrics 运行指标 (不转移所有权, nullptr 表示不记录)
+     */
+    void setMetrics(Metrics* metrics) { metrics_ = metrics; }
+
+    Metrics* getMetrics() const { return metrics_; }
+
+    /**
+     * 设置硬件计数器剖析: 记录每个规则在每个编译单元上的周期数、指令数、缓存未命中和分支预测失败
+     * @param profile 剖析结果 (不转移所有权, nullptr 表示不剖析)
+     */
+    void setHardwareProfile(HardwareProfile* profile) { hw_profile_ = profile; }
+
+    HardwareProfile* getHardwareProfile() const { return hw_profile_; }
+
+    // 是否已达到提前终止条件
+    bool limitReached() const { return limit_ && limit_->reached; }
+
 private:
+    /**
+     * 批量解析编译单元内问题的源码位置
+     * 先按原始位置编码去重, 再解析路径/行号/列号和代码片段
+     * @param context Clang AST 上下文 (提供 SourceManager 和 LangOptions)
+     * @param issues 待解析的问题列表 (原地更新)
+     * @param functions 编译单元的函数范围 (为空时按需收集并保存, 供同一编译单元后续调用复用)
+     */
+    void resolveIssueLocations(clang::ASTContext& context, std::vector<Issue>& issues,
+                               std::unique_ptr<FunctionRangeIndex>& functions) const;
+
+    /**
+     * 为问题填充所在函数的限定名
+     * @param context Clang AST 上下文
+     * @param issues 问题列表 (位置仍为原始编码)
+     * @param functions 编译单元的函数范围 (为空时遍历 AST 收集)
+     */
+    static void resolveEnclosingFunctions(clang::ASTContext& context, std::vector<Issue>& issues,
+                                          std::unique_ptr<FunctionRangeIndex>& functions);
+
+    /**
+     * 按问题所在文件的规则范围过滤问题并应用严重性覆盖
+     * @param issues 已解析位置的问题列表 (原地更新)
+     */
+    void applyRuleScopes(std::vector<Issue>& issues) const;
+
+    /**
+     * 编译单元内收到问题时检查提前终止条件
+     * 只解析这一个问题的位置并按最终报告器的规则判断, 满足条件时请求 collector 停止
+     * probed 记录本编译单元已检查过的问题, 重复上报的问题不再计数
+     */
+    void checkIssueLimit(clang::ASTContext& context, const Issue& issue, Reporter& collector,
+                         std::unordered_set<std::string>& probed, size_t& candidates,
+                         std::unique_ptr<FunctionRangeIndex>& functions) const;
+
     std::vector<std::unique_ptr<Rule>> rules_;  // 所有已注册的规则列表
+    bool resolve_enclosing_functions_ = false;   // 是否查找问题所在函数
+    std::shared_ptr<const RuleScopes> scopes_;   // 按路径的规则范围 (可为空)
+    std::shared_ptr<IssueLimit> limit_;          // 提前终止条件 (可为空)
+    const Reporter* gate_ = nullptr;             // 最终报告器 (判断问题是否会被接收)
+    Metrics* metrics_ = nullptr;                 // 运行指标 (可为空)
+    HardwareProfile* hw_profile_ = nullptr;      // 硬件计数器剖析 (可为空)
 };
 
 } // namespace cpp_review
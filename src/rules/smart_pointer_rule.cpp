@@ -64,9 +64,7 @@ bool SmartPointerVisitor::VisitVarDecl(clang::VarDecl* decl) {
     }
 
     Issue issue;
-    issue.file_path = getFileName(decl->getLocation());
-    issue.line = getLine(decl->getLocation());
-    issue.column = getColumn(decl->getLocation());
+    setIssueLocation(issue, decl->getLocation());
     issue.severity = Severity::SUGGESTION;
     issue.rule_id = "SMART-PTR-001";
 
@@ -87,7 +85,7 @@ bool SmartPointerVisitor::VisitVarDecl(clang::VarDecl* decl) {
                           std::string("  auto ") + varName + " = std::make_shared<" + typeName + ">();";
     }
 
-    issue.code_snippet = getSourceText(decl->getSourceRange());
+    setIssueSnippet(issue, decl->getSourceRange());
 
     reporter_.addIssue(issue);
 
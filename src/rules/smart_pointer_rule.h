@@ -6,7 +6,7 @@
 
 namespace cpp_review {
 
-class SmartPointerVisitor : public RuleVisitor {
+class SmartPointerVisitor : public RuleVisitor<SmartPointerVisitor> {
 public:
     using RuleVisitor::RuleVisitor;
 
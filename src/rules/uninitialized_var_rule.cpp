@@ -36,9 +36,7 @@ bool UninitializedVarVisitor::VisitVarDecl(clang::VarDecl* decl) {
     // Check if the variable is uninitialized
     if (!decl->hasInit() && isBuiltinType(decl->getType())) {
         Issue issue;
-        issue.file_path = getFileName(decl->getLocation());
-        issue.line = getLine(decl->getLocation());
-        issue.column = getColumn(decl->getLocation());
+        setIssueLocation(issue, decl->getLocation());
         issue.severity = Severity::HIGH;
         issue.rule_id = "UNINIT-VAR-001";
 
@@ -53,7 +51,7 @@ bool UninitializedVarVisitor::VisitVarDecl(clang::VarDecl* decl) {
 
         // Get code snippet
         clang::SourceRange range = decl->getSourceRange();
-        issue.code_snippet = getSourceText(range);
+        setIssueSnippet(issue, range);
 
         reporter_.addIssue(issue);
     }
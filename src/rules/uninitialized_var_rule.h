@@ -5,7 +5,7 @@
 
 namespace cpp_review {
 
-class UninitializedVarVisitor : public RuleVisitor {
+class UninitializedVarVisitor : public RuleVisitor<UninitializedVarVisitor> {
 public:
     using RuleVisitor::RuleVisitor;
 
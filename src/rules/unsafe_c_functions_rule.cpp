@@ -39,6 +39,21 @@ UnsafeCFunctionsVisitor::unsafe_functions_ = {
     }}
 };
 
+const UnsafeFunctionInfo* UnsafeCFunctionsVisitor::lookup(const std::string& name) {
+    auto it = unsafe_functions_.find(name);
+    return it == unsafe_functions_.end() ? nullptr : &it->second;
+}
+
+Issue UnsafeCFunctionsVisitor::makeIssue(const std::string& funcName, const UnsafeFunctionInfo& info) {
+    Issue issue;
+    issue.severity = Severity::CRITICAL;
+    issue.rule_id = "UNSAFE-C-FUNC-001";
+    issue.description = "Use of unsafe C function '" + funcName + "': " + info.reason;
+    issue.suggestion = "Replace '" + funcName + "' with " + info.safe_alternative +
+                     ". In modern C++, prefer using std::string for string operations to avoid manual memory management";
+    return issue;
+}
+
 bool UnsafeCFunctionsVisitor::VisitCallExpr(clang::CallExpr* call) {
     if (!call) return true;
 
@@ -49,23 +64,13 @@ bool UnsafeCFunctionsVisitor::VisitCallExpr(clang::CallExpr* call) {
     std::string funcName = func->getNameAsString();
 
     // Check if this is an unsafe function
-    auto it = unsafe_functions_.find(funcName);
-    if (it != unsafe_functions_.end()) {
-        Issue issue;
-        issue.file_path = getFileName(call->getBeginLoc());
-        issue.line = getLine(call->getBeginLoc());
-        issue.column = getColumn(call->getBeginLoc());
-        issue.severity = Severity::CRITICAL;
-        issue.rule_id = "UNSAFE-C-FUNC-001";
-
-        const UnsafeFunctionInfo& info = it->second;
-        issue.description = "Use of unsafe C function '" + funcName + "': " + info.reason;
-        issue.suggestion = "Replace '" + funcName + "' with " + info.safe_alternative +
-                         ". In modern C++, prefer using std::string for string operations to avoid manual memory management";
+    if (const UnsafeFunctionInfo* info = lookup(funcName)) {
+        Issue issue = makeIssue(funcName, *info);
+        setIssueLocation(issue, call->getBeginLoc());
 
         // Get code snippet
         clang::SourceRange range = call->getSourceRange();
-        issue.code_snippet = getSourceText(range);
+        setIssueSnippet(issue, range);
 
         reporter_.addIssue(issue);
     }
@@ -78,4 +83,48 @@ void UnsafeCFunctionsRule::check(clang::ASTContext* context, Reporter& reporter)
     visitor.TraverseDecl(context->getTranslationUnitDecl());
 }
 
+/**
+ * 记号流检查: "name (" 形式的调用
+ * 排除成员调用 (a.strcpy / p->strcpy)、其他命名空间中的同名函数 (ns::strcpy)
+ * 以及声明 (前面紧跟类型名的 "char* strcpy(")
+ */
+void UnsafeCFunctionsRule::checkTokens(const TokenStream& tokens, Reporter& reporter) {
+    for (size_t i = 0; i + 1 < tokens.size(); ++i) {
+        const LexToken& token = tokens[i];
+        if (!token.isIdentifier() || !tokens[i + 1].isPunct("(")) continue;
+
+        const UnsafeFunctionInfo* info = UnsafeCFunctionsVisitor::lookup(token.text);
+        if (!info) continue;
+
+        if (i > 0) {
+            const LexToken& prev = tokens[i - 1];
+            if (prev.isPunct(".") || prev.isPunct("->")) {
+                continue;   // 成员调用
+            }
+            if ((prev.isPunct("*") || prev.isPunct("&")) && i > 1 &&
+                tokens[i - 2].isIdentifier() && tokens[i - 2].text != "return") {
+                continue;   // "char* strcpy(" 形式的声明
+            }
+            if (prev.isPunct("::") && i > 1 && tokens[i - 2].isIdentifier() && tokens[i - 2].text != "std") {
+                continue;
+            }
+            if (prev.isIdentifier() && prev.text != "return" && prev.text != "else" && prev.text != "do") {
+                continue;   // "int gets(" 之类的声明
+            }
+        }
+
+        Issue issue = UnsafeCFunctionsVisitor::makeIssue(token.text, *info);
+        issue.file_path = tokens.path();
+        issue.line = token.line;
+        issue.column = token.column;
+
+        size_t close = tokens.findClosing(i + 1);
+        if (close < tokens.size()) {
+            issue.code_snippet = tokens.text(i, close);
+        }
+
+        reporter.addIssue(issue);
+    }
+}
+
 } // namespace cpp_review
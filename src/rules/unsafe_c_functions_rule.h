@@ -12,12 +12,18 @@ struct UnsafeFunctionInfo {
     std::string reason;
 };
 
-class UnsafeCFunctionsVisitor : public RuleVisitor {
+class UnsafeCFunctionsVisitor : public RuleVisitor<UnsafeCFunctionsVisitor> {
 public:
     using RuleVisitor::RuleVisitor;
 
     bool VisitCallExpr(clang::CallExpr* call);
 
+    // 查询不安全函数信息, 不在列表中返回 nullptr
+    static const UnsafeFunctionInfo* lookup(const std::string& name);
+
+    // 构造问题 (位置由调用方设置)
+    static Issue makeIssue(const std::string& name, const UnsafeFunctionInfo& info);
+
 private:
     static const std::unordered_map<std::string, UnsafeFunctionInfo> unsafe_functions_;
 };
@@ -31,6 +37,10 @@ public:
     }
 
     void check(clang::ASTContext* context, Reporter& reporter) override;
+
+    // 只需要函数名和调用语法
+    RuleTier getTier() const override { return RuleTier::LEXICAL; }
+    void checkTokens(const TokenStream& tokens, Reporter& reporter) override;
 };
 
 } // namespace cpp_review
@@ -32,6 +32,7 @@ void UseAfterFreeVisitor::analyzeFunctionBody(clang::Stmt* body) {
 
 void UseAfterFreeVisitor::analyzeStmt(clang::Stmt* stmt) {
     if (!stmt) return;
+    reporter_.countVisitedNode();
 
     // Check for delete expressions
     if (auto* deleteExpr = llvm::dyn_cast<clang::CXXDeleteExpr>(stmt)) {
@@ -59,9 +60,7 @@ void UseAfterFreeVisitor::analyzeStmt(clang::Stmt* stmt) {
                     if (auto* varDecl = llvm::dyn_cast<clang::VarDecl>(declRef->getDecl())) {
                         if (isPointerDeleted(varDecl)) {
                             Issue issue;
-                            issue.file_path = context_->getSourceManager().getFilename(arg->getExprLoc()).str();
-                            issue.line = context_->getSourceManager().getSpellingLineNumber(arg->getExprLoc());
-                            issue.column = context_->getSourceManager().getSpellingColumnNumber(arg->getExprLoc());
+                            setIssueLocation(issue, arg->getExprLoc());
                             issue.severity = Severity::CRITICAL;
                             issue.rule_id = "USE-AFTER-FREE-001";
 
@@ -110,9 +109,7 @@ void UseAfterFreeVisitor::checkPointerUsage(clang::Expr* expr) {
 
     if (isPointerDeleted(decl)) {
         Issue issue;
-        issue.file_path = context_->getSourceManager().getFilename(expr->getExprLoc()).str();
-        issue.line = context_->getSourceManager().getSpellingLineNumber(expr->getExprLoc());
-        issue.column = context_->getSourceManager().getSpellingColumnNumber(expr->getExprLoc());
+        setIssueLocation(issue, expr->getExprLoc());
         issue.severity = Severity::CRITICAL;
         issue.rule_id = "USE-AFTER-FREE-001";
 
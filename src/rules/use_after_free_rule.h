@@ -1,16 +1,14 @@
 #pragma once
 
 #include "rule.h"
-#include "clang/AST/RecursiveASTVisitor.h"
 #include <map>
 #include <set>
 
 namespace cpp_review {
 
-class UseAfterFreeVisitor : public clang::RecursiveASTVisitor<UseAfterFreeVisitor> {
+class UseAfterFreeVisitor : public RuleVisitor<UseAfterFreeVisitor> {
 public:
-    explicit UseAfterFreeVisitor(clang::ASTContext* context, Reporter& reporter)
-        : context_(context), reporter_(reporter) {}
+    using RuleVisitor::RuleVisitor;
 
     bool VisitFunctionDecl(clang::FunctionDecl* func);
 
@@ -22,9 +20,6 @@ private:
     bool isPointerDeleted(const clang::ValueDecl* decl);
     const clang::ValueDecl* getReferencedDecl(clang::Expr* expr);
 
-    clang::ASTContext* context_;
-    Reporter& reporter_;
-
     // Track deleted pointers in current function scope
     std::set<const clang::ValueDecl*> deletedPointers_;
     std::map<const clang::ValueDecl*, clang::SourceLocation> deleteLocations_;
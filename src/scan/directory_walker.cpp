@@ -0,0 +1,317 @@
+/*
+ * 并行目录遍历模块实现
+ */
+
+#include "scan/directory_walker.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace cpp_review {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/**
+ * 生效中的一层忽略规则
+ * 扫描根目录内的 .gitignore 以相对扫描根的目录 base 定位;
+ * 扫描根以上的 .gitignore 需要在条目路径前拼接 prefix (扫描根相对该目录的路径)
+ */
+struct IgnoreLayer {
+    std::shared_ptr<const IgnoreRules> rules;
+    std::string base;     // 所在目录 (相对扫描根, 根目录为 "")
+    std::string prefix;   // 扫描根以上的层: 扫描根相对该层目录的路径
+    std::shared_ptr<const IgnoreLayer> parent;
+};
+
+using LayerPtr = std::shared_ptr<const IgnoreLayer>;
+
+/**
+ * 判断条目是否被忽略: 从最内层向外查找, 第一层给出结论的规则生效
+ * (与 git 一致: 更深目录中的 .gitignore 优先)
+ */
+bool isIgnored(const IgnoreLayer* layer, const std::string& relative, bool is_directory) {
+    for (; layer; layer = layer->parent.get()) {
+        std::string path;
+        if (!layer->prefix.empty()) {
+            path = layer->prefix + "/" + relative;
+        } else if (layer->base.empty()) {
+            path = relative;
+        } else {
+            path = relative.substr(layer->base.size() + 1);
+        }
+        int result = layer->rules->match(path, is_directory);
+        if (result != 0) {
+            return result > 0;
+        }
+    }
+    return false;
+}
+
+/**
+ * 加载扫描根以上直到仓库根的忽略规则
+ * 包括仓库根的 .git/info/exclude 与沿途各级目录的 .gitignore
+ */
+LayerPtr loadOuterLayers(const fs::path& root) {
+    std::error_code ec;
+    fs::path absolute = fs::absolute(root, ec).lexically_normal();
+    if (ec) {
+        return nullptr;
+    }
+    if (!absolute.has_filename()) {
+        absolute = absolute.parent_path();
+    }
+
+    // 向上查找仓库根 (含 .git 的目录); 扫描根自身的 .gitignore 由遍历过程读取
+    std::vector<fs::path> ancestors;
+    fs::path repository;
+    for (fs::path dir = absolute;; dir = dir.parent_path()) {
+        if (fs::exists(dir / ".git", ec)) {
+            repository = dir;
+            break;
+        }
+        if (dir == dir.parent_path()) {
+            return nullptr;
+        }
+        ancestors.push_back(dir.parent_path());
+    }
+    if (!ancestors.empty()) {
+        ancestors.pop_back();   // 仓库根单独处理 (.git/info/exclude 之后)
+    }
+
+    LayerPtr layer;
+    auto push = [&](const std::shared_ptr<const IgnoreRules>& rules, const fs::path& dir) {
+        if (!rules) return;
+        std::string prefix = absolute.lexically_relative(dir).generic_string();
+        layer = std::make_shared<IgnoreLayer>(IgnoreLayer{rules, "", prefix == "." ? "" : prefix, layer});
+    };
+
+    push(IgnoreRules::load((repository / ".git" / "info" / "exclude").string()), repository);
+    if (repository != absolute) {
+        push(IgnoreRules::load((repository / ".gitignore").string()), repository);
+    }
+    for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
+        push(IgnoreRules::load((*it / ".gitignore").string()), *it);
+    }
+    return layer;
+}
+
+/**
+ * 待列举的目录
+ */
+struct DirectoryTask {
+    std::string relative;   // 相对扫描根 (根目录为 "")
+    LayerPtr layers;        // 父目录处生效的忽略规则
+};
+
+} // namespace
+
+// ===== IgnoreRules 实现 =====
+
+std::shared_ptr<const IgnoreRules> IgnoreRules::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return nullptr;
+    }
+    std::ostringstream content;
+    content << file.rdbuf();
+    return parse(content.str());
+}
+
+std::shared_ptr<const IgnoreRules> IgnoreRules::parse(const std::string& content) {
+    auto rules = std::make_shared<IgnoreRules>();
+
+    std::istringstream stream(content);
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        // 行尾未转义的空格被忽略
+        while (!line.empty() && line.back() == ' ' &&
+               (line.size() < 2 || line[line.size() - 2] != '\\')) {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        Rule rule;
+        if (line[0] == '!') {
+            rule.negate = true;
+            line.erase(0, 1);
+        } else if (line[0] == '\\') {
+            line.erase(0, 1);   // "\#" 与 "\!" 转义
+        }
+        if (!line.empty() && line.back() == '/') {
+            rule.directory_only = true;
+            line.pop_back();
+        }
+        if (line.empty()) {
+            continue;
+        }
+
+        // 开头的 "/" 表示锚定到该目录; PathPatternSet 只对不含 "/" 的模式做任意目录匹配,
+        // 因此保留开头的 "/" 即可, 中间含 "/" 的模式本身就是锚定的
+        rules->patterns_.add(line, rules->rules_.size());
+        rules->rules_.push_back(rule);
+    }
+
+    if (rules->rules_.empty()) {
+        return nullptr;
+    }
+    return rules;
+}
+
+int IgnoreRules::match(const std::string& relative, bool is_directory) const {
+    auto matched = patterns_.match(relative);
+    // 编号升序, 从后向前找到最后一条适用的规则
+    for (auto it = matched.rbegin(); it != matched.rend(); ++it) {
+        const Rule& rule = rules_[*it];
+        if (rule.directory_only && !is_directory) {
+            continue;
+        }
+        return rule.negate ? -1 : 1;
+    }
+    return 0;
+}
+
+// ===== DirectoryWalker 实现 =====
+
+bool DirectoryWalker::isImplementationFile(const std::string& path) {
+    static const std::vector<std::string> extensions = {".cpp", ".cc", ".cxx", ".c++"};
+    std::string ext = fs::path(path).extension().string();
+    return std::find(extensions.begin(), extensions.end(), ext) != extensions.end();
+}
+
+bool DirectoryWalker::isHeaderFile(const std::string& path) {
+    static const std::vector<std::string> extensions = {".h", ".hpp", ".hxx", ".h++"};
+    std::string ext = fs::path(path).extension().string();
+    return std::find(extensions.begin(), extensions.end(), ext) != extensions.end();
+}
+
+std::vector<std::string> DirectoryWalker::collect(const std::string& root, const WalkOptions& options) {
+    const fs::path root_path(root);
+
+    PathPatternSet excludes;
+    for (const auto& pattern : options.exclude) {
+        excludes.add(pattern, 0);
+    }
+    auto excluded = [&](const std::string& relative) {
+        return !excludes.empty() && excludes.matchesAny((root_path / relative).string());
+    };
+
+    LayerPtr outer = options.use_gitignore ? loadOuterLayers(root_path) : nullptr;
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<DirectoryTask> queue;
+    size_t active = 0;   // 正在列举的目录数; 队列为空且为 0 时遍历结束
+    std::vector<std::string> files;
+
+    queue.push_back({"", outer});
+
+    auto listDirectory = [&](const DirectoryTask& task, std::vector<DirectoryTask>& subdirectories,
+                             std::vector<std::string>& found) {
+        fs::path dir = task.relative.empty() ? root_path : root_path / task.relative;
+
+        LayerPtr layers = task.layers;
+        if (options.use_gitignore) {
+            if (auto rules = IgnoreRules::load((dir / ".gitignore").string())) {
+                layers = std::make_shared<IgnoreLayer>(IgnoreLayer{rules, task.relative, "", layers});
+            }
+        }
+
+        std::error_code ec;
+        fs::directory_iterator it(dir, fs::directory_options::skip_permission_denied, ec);
+        if (ec) {
+            std::cerr << "Warning: Cannot read directory " << dir.string() << ": " << ec.message() << "\n";
+            return;
+        }
+
+        for (; it != fs::directory_iterator(); it.increment(ec)) {
+            if (ec) {
+                std::cerr << "Warning: Error while reading " << dir.string() << ": " << ec.message() << "\n";
+                break;
+            }
+            const fs::directory_entry& entry = *it;
+            std::string name = entry.path().filename().string();
+            std::string relative = task.relative.empty() ? name : task.relative + "/" + name;
+
+            // 优先使用目录项自带的类型, 避免对每个条目 stat (网络文件系统上代价很高)
+            std::error_code type_ec;
+            fs::file_status status = entry.symlink_status(type_ec);
+            if (type_ec) continue;
+
+            if (fs::is_directory(status)) {
+                // 版本库元数据目录总是跳过; 符号链接目录不跟随 (与 recursive_directory_iterator 一致)
+                if (name == ".git" || name == ".hg" || name == ".svn") continue;
+                if (excluded(relative)) continue;
+                if (layers && isIgnored(layers.get(), relative, true)) continue;
+                subdirectories.push_back({relative, layers});
+                continue;
+            }
+
+            bool wanted = isImplementationFile(name) || (options.include_headers && isHeaderFile(name));
+            if (!wanted) continue;
+            if (fs::is_symlink(status) && !entry.is_regular_file(type_ec)) continue;
+            if (!fs::is_symlink(status) && !fs::is_regular_file(status)) continue;
+            if (excluded(relative)) continue;
+            if (layers && isIgnored(layers.get(), relative, false)) continue;
+            found.push_back((root_path / relative).string());
+        }
+    };
+
+    auto worker = [&]() {
+        std::vector<std::string> found;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            ready.wait(lock, [&] { return !queue.empty() || active == 0; });
+            if (queue.empty()) {
+                break;
+            }
+            DirectoryTask task = std::move(queue.front());
+            queue.pop_front();
+            ++active;
+            lock.unlock();
+
+            std::vector<DirectoryTask> subdirectories;
+            listDirectory(task, subdirectories, found);
+
+            lock.lock();
+            for (auto& subdirectory : subdirectories) {
+                queue.push_back(std::move(subdirectory));
+            }
+            --active;
+            ready.notify_all();
+        }
+        files.insert(files.end(), found.begin(), found.end());
+    };
+
+    // 目录读取以 I/O 等待为主, 线程数可多于 CPU 核数
+    unsigned jobs = options.jobs;
+    if (jobs == 0) {
+        jobs = std::max(8u, std::thread::hardware_concurrency());
+    }
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < jobs; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+} // namespace cpp_review
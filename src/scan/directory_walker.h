@@ -0,0 +1,88 @@
+/*
+ * 并行目录遍历模块头文件
+ * 为 "scan <dir>" 枚举待分析的 C++ 源文件
+ *
+ * 设计要点:
+ * - 多个线程共享一个目录队列, 每个目录只列举一层, 子目录重新入队;
+ *   网络文件系统上的目录读取延迟可以相互重叠
+ * - 遵守 .gitignore (含扫描根目录以上直到仓库根的 .gitignore 与 .git/info/exclude)
+ *   以及配置中的 exclude 模式; 被忽略的目录在入队前剪枝, 不会进入其子树
+ * - 默认只收集实现文件 (.cpp/.cc/...), 头文件由包含它的翻译单元分析
+ */
+
+#pragma once
+
+#include "config/rule_scope.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cpp_review {
+
+/**
+ * 遍历选项
+ */
+struct WalkOptions {
+    std::vector<std::string> exclude;   // 排除模式 (语法同配置中的 exclude, 相对当前目录)
+    bool include_headers = false;       // 是否把头文件也作为独立翻译单元收集
+    bool use_gitignore = true;          // 是否遵守 .gitignore
+    unsigned jobs = 0;                  // 并行线程数; 0 表示自动选择
+};
+
+/**
+ * 一个 .gitignore (或 .git/info/exclude) 文件中的规则
+ * 规则按出现顺序编号, 最后一条匹配的规则生效, "!" 开头的规则重新包含
+ */
+class IgnoreRules {
+public:
+    /**
+     * 解析忽略文件
+     * @param path 忽略文件路径
+     * @return 规则集合; 文件不存在或没有有效规则时返回空指针
+     */
+    static std::shared_ptr<const IgnoreRules> load(const std::string& path);
+
+    /**
+     * 从文本解析规则
+     */
+    static std::shared_ptr<const IgnoreRules> parse(const std::string& content);
+
+    /**
+     * 判断路径是否被忽略
+     * @param relative 相对忽略文件所在目录的路径 ("/" 分隔)
+     * @param is_directory 路径是否为目录 (以 "/" 结尾的规则只匹配目录)
+     * @return 被最后一条匹配规则忽略返回 1, 被重新包含返回 -1, 无规则匹配返回 0
+     */
+    int match(const std::string& relative, bool is_directory) const;
+
+private:
+    struct Rule {
+        bool negate = false;          // "!pattern"
+        bool directory_only = false;  // "pattern/"
+    };
+
+    PathPatternSet patterns_;
+    std::vector<Rule> rules_;
+};
+
+/**
+ * 并行目录遍历器
+ */
+class DirectoryWalker {
+public:
+    /**
+     * 收集目录下的 C++ 源文件
+     * @param root 扫描根目录 (返回的路径以它为前缀)
+     * @param options 遍历选项
+     * @return 源文件路径 (按字典序排列, 结果与线程调度无关)
+     */
+    static std::vector<std::string> collect(const std::string& root, const WalkOptions& options = {});
+
+    // 是否为 C++ 实现文件 (.cpp/.cc/.cxx/.c++)
+    static bool isImplementationFile(const std::string& path);
+
+    // 是否为 C++ 头文件 (.h/.hpp/.hxx/.h++)
+    static bool isHeaderFile(const std::string& path);
+};
+
+} // namespace cpp_review